@@ -0,0 +1,21 @@
+#!/usr/bin/env bash
+
+set -e
+
+cbmc=$1
+
+options=${*:2:$#-2}
+name=${*:$#}
+
+cache=$(mktemp -d)
+trap 'rm -rf "${cache}"' EXIT
+export CBMC_LIBRARY_CACHE="${cache}"
+
+# run cbmc twice on the same program, counting the library texts that are
+# read from the cache and the entries that the cache holds after each run
+for run in first second; do
+  hits=$("${cbmc}" "${name}" ${options} --verbosity 10 2>&1 | \
+    grep -c "^Read library symbols from " || true)
+  entries=$(find "${cache}" -name 'cprover-library-*.gb' | wc -l)
+  echo "${run} run: ${hits} hits, ${entries//[[:space:]]/} entries"
+done
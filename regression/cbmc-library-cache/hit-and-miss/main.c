@@ -0,0 +1,13 @@
+#include <stdlib.h>
+
+int main()
+{
+  int *p = malloc(sizeof(int));
+  if(p)
+  {
+    *p = 1;
+    __CPROVER_assert(*p == 1, "stored value");
+  }
+  free(p);
+  return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env bash
+
+set -e
+
+cbmc=$1
+
+options=${*:2:$#-2}
+name=${*:$#}
+
+directory=$(mktemp -d)
+trap 'rm -rf "${directory}"' EXIT
+cache="${directory}/cache.txt"
+
+# print how many properties hold according to the cache
+run()
+{
+  "${cbmc}" "${name}" ${options} --verification-cache "${cache}" "$@" 2>&1 | \
+    sed -n 's/^Verification cache: \([0-9]* of [0-9]*\) properties.*/\1/p'
+}
+
+echo "first run: $(run)"
+echo "same program: $(run)"
+echo "changed program: $(run -D CHANGED)"
+echo "original program: $(run)"
@@ -0,0 +1,12 @@
+int main()
+{
+  int x;
+#ifdef CHANGED
+  x = 2;
+#else
+  x = 1;
+#endif
+  __CPROVER_assert(x == 1, "holds in the original program");
+  __CPROVER_assert(x == 2, "holds in the changed program");
+  return 0;
+}
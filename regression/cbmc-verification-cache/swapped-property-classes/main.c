@@ -0,0 +1,12 @@
+int main()
+{
+  int x = 1;
+#ifdef CHANGED
+  __CPROVER_precondition(x == 1, "holds");
+  __CPROVER_assert(x == 2, "fails");
+#else
+  __CPROVER_assert(x == 1, "holds");
+  __CPROVER_precondition(x == 2, "fails");
+#endif
+  return 0;
+}
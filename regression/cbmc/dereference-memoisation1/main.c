@@ -0,0 +1,42 @@
+#include <assert.h>
+
+struct nodet
+{
+  int value;
+  struct nodet *next;
+};
+
+int nondet_int();
+
+int main()
+{
+  struct nodet n1, n2, n3;
+  n1.value = 1;
+  n1.next = &n2;
+  n2.value = 2;
+  n2.next = &n3;
+  n3.value = 3;
+  n3.next = &n1;
+
+  struct nodet *p = nondet_int() ? &n1 : &n2;
+  assert(p->value != 3);
+  assert(p->next->value != 1);
+
+  // the value set of p only changes on one branch
+  if(nondet_int())
+    p = p->next;
+  assert(p->value != 3); // fails
+
+  // the value set of p->next only changes on one branch
+  if(nondet_int())
+    n2.next = &n1;
+  assert(p == &n3 || p->next->value != 1); // fails
+
+  // neither value set changes on either branch
+  if(nondet_int())
+    n1.value = 4;
+  assert(p->value != 4); // fails
+  assert(p->next->value != 2 || p == &n1);
+
+  return 0;
+}
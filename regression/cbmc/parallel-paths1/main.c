@@ -0,0 +1,19 @@
+int main()
+{
+  int x, y;
+
+  if(x > 0)
+  {
+    if(y > 0)
+      __CPROVER_assert(x != 5, "fails on one path");
+    else
+      __CPROVER_assert(y <= 0, "holds");
+  }
+  else
+  {
+    __CPROVER_assert(x <= 0, "holds");
+    __CPROVER_assert(y != 3, "fails on another path");
+  }
+
+  return 0;
+}
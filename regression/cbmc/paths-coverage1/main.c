@@ -0,0 +1,17 @@
+int main()
+{
+  int n, x = 0;
+
+  for(int i = 0; i < 4; ++i)
+  {
+    if(n > i)
+      ++x;
+  }
+
+  if(x == 3)
+    __CPROVER_assert(n != 3, "fails after three increments");
+  else
+    __CPROVER_assert(x != 3, "holds");
+
+  return 0;
+}
@@ -0,0 +1,10 @@
+#include <assert.h>
+
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x < 100 && y < 100);
+  assert(x * y != 391);
+  assert(x + y < 200);
+  return 0;
+}
@@ -0,0 +1,19 @@
+#include <assert.h>
+
+int f00(int x)
+{
+  int y = 1;
+  assert(y == 1);
+  assert(x == 1);
+  return y;
+}
+
+int main(int argc, char **argv)
+{
+  int v = 1;
+  assert(v == 1);
+  v = f00(v);
+  assert(v == 1);
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+"""Measure how function-local abstract interpretation scales with threads
+
+This script runs goto-analyzer with --parallel-functions on a GOTO binary for
+an increasing number of threads and reports the wall-clock time of each run as
+well as the speedup over the run using a single thread. As the results of the
+analysis do not depend on the number of threads, the script also checks that
+all runs produce the same output.
+
+Before running this script, the following must be true:
+
+    1. "goto-analyzer" must be in your system PATH, or be given via
+       --goto-analyzer
+    2. goto-analyzer has been built with IREP_ATOMIC_REF_COUNT (see
+       COMPILING.md), otherwise all runs use a single thread
+    3. A GOTO binary has been built from source (using goto-cc); large
+       binaries with many functions benefit most
+
+A typical usage of this script will be:
+
+    scripts/goto-analyzer-scaling.py binary.gb --max-threads 16 --intervals
+
+See --help for the list of available command-line options. Any additional
+options are passed to goto-analyzer; they default to
+"--verify --intervals".
+"""
+
+import argparse
+import multiprocessing
+import subprocess
+import sys
+import time
+
+
+def run(goto_analyzer, binary, threads, options):
+    cmd = [goto_analyzer, binary, '--parallel-functions', str(threads)]
+    cmd += options
+    start = time.monotonic()
+    result = subprocess.run(
+        cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+        universal_newlines=True)
+    elapsed = time.monotonic() - start
+    if result.returncode not in (0, 5, 10):
+        sys.stderr.write(result.stdout)
+        raise RuntimeError(
+            '{} failed with exit code {}'.format(
+                ' '.join(cmd), result.returncode))
+    # drop lines that legitimately differ between runs
+    output = [line for line in result.stdout.splitlines()
+              if 'threads' not in line and 'Runtime' not in line]
+    return elapsed, output
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument(
+        'binary', help='GOTO binary to analyse')
+    parser.add_argument(
+        '--goto-analyzer', default='goto-analyzer',
+        help='goto-analyzer executable to use')
+    parser.add_argument(
+        '--max-threads', type=int, default=multiprocessing.cpu_count(),
+        help='largest number of threads to measure (default: number of CPUs)')
+    parser.add_argument(
+        '--repeat', type=int, default=1,
+        help='number of runs per thread count, the fastest one is reported')
+    args, options = parser.parse_known_args()
+    if not options:
+        options = ['--verify', '--intervals']
+
+    thread_counts = []
+    threads = 1
+    while threads < args.max_threads:
+        thread_counts.append(threads)
+        threads *= 2
+    thread_counts.append(args.max_threads)
+
+    baseline_time = None
+    baseline_output = None
+    print('{:>8} {:>12} {:>8}'.format('threads', 'time [s]', 'speedup'))
+    for threads in thread_counts:
+        runs = [run(args.goto_analyzer, args.binary, threads, options)
+                for _ in range(args.repeat)]
+        elapsed = min(r[0] for r in runs)
+        output = runs[0][1]
+        if baseline_time is None:
+            baseline_time = elapsed
+            baseline_output = output
+        elif output != baseline_output:
+            sys.stderr.write(
+                'results with {} threads differ from those with 1 '
+                'thread\n'.format(threads))
+            return 1
+        print('{:>8} {:>12.3f} {:>8.2f}'.format(
+            threads, elapsed, baseline_time / elapsed))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+
+"""Compare two builds of CBMC on pointer-heavy regression tests
+
+This script runs "goto-instrument --show-value-sets" (value-set analysis) and
+"cbmc --show-vcc" (symbolic execution, including dereferencing) of two builds
+on the sources of pointer-heavy regression tests, and reports the total time
+taken by each build. As both builds are expected to produce the same results,
+e.g., when comparing OBJECT_MAP_IS_SORTED_VECTOR=0 and =1 (see
+src/pointer-analysis/value_set.h), the script also checks that the output of
+both builds is the same.
+
+Before running this script, the following must be true:
+
+    1. Both builds have been completed, and the directories given via
+       --baseline and --candidate contain the goto-instrument and cbmc
+       executables (e.g., build/bin of a CMake build)
+    2. The script is run from the root of the repository, or the regression
+       tests are given explicitly
+
+A typical usage of this script will be:
+
+    scripts/value-set-benchmark.py --baseline base/bin --candidate build/bin
+
+See --help for the list of available command-line options.
+"""
+
+import argparse
+import glob
+import os
+import subprocess
+import sys
+import time
+
+
+DEFAULT_TESTS = [
+    'regression/cbmc/Function_Pointer*',
+    'regression/cbmc/Linked_List*',
+    'regression/cbmc/Malloc*',
+    'regression/cbmc/Pointer*',
+    'regression/cbmc/dereference*',
+]
+
+TOOLS = [
+    ('goto-instrument', ['--show-value-sets']),
+    ('cbmc', ['--show-vcc']),
+]
+
+
+def source_of(test):
+    """The source file of the first test in the directory test"""
+    for desc in sorted(glob.glob(os.path.join(test, '*.desc'))):
+        with open(desc) as f:
+            lines = f.read().splitlines()
+        if len(lines) > 1 and lines[1].endswith('.c'):
+            return os.path.join(test, lines[1].split()[0])
+    return None
+
+
+def run(directory, tool, options, source):
+    cmd = [os.path.join(directory, tool), source] + options
+    start = time.monotonic()
+    result = subprocess.run(
+        cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+        universal_newlines=True)
+    elapsed = time.monotonic() - start
+    # drop lines that legitimately differ between runs
+    output = [line for line in result.stdout.splitlines()
+              if 'Runtime' not in line]
+    return elapsed, result.returncode, output
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument(
+        '--baseline', required=True,
+        help='directory holding the executables of the baseline build')
+    parser.add_argument(
+        '--candidate', required=True,
+        help='directory holding the executables of the build to compare')
+    parser.add_argument(
+        '--repeat', type=int, default=1,
+        help='number of runs per test, the fastest one is reported')
+    parser.add_argument(
+        'tests', nargs='*', default=DEFAULT_TESTS,
+        help='regression test directories (glob patterns) to run')
+    args = parser.parse_args()
+
+    sources = []
+    for pattern in args.tests:
+        for test in sorted(glob.glob(pattern)):
+            source = source_of(test)
+            if source is not None:
+                sources.append(source)
+
+    if not sources:
+        sys.stderr.write('no regression tests found\n')
+        return 1
+
+    differences = 0
+    print('{:<16} {:>6} {:>14} {:>14} {:>8}'.format(
+        'tool', 'tests', 'baseline [s]', 'candidate [s]', 'speedup'))
+    for tool, options in TOOLS:
+        totals = {args.baseline: 0.0, args.candidate: 0.0}
+        for source in sources:
+            results = {}
+            for directory in totals:
+                runs = [run(directory, tool, options, source)
+                        for _ in range(args.repeat)]
+                totals[directory] += min(r[0] for r in runs)
+                results[directory] = runs[0][1:]
+            if results[args.baseline] != results[args.candidate]:
+                sys.stderr.write(
+                    '{} produces different results on {}\n'.format(
+                        tool, source))
+                differences += 1
+        print('{:<16} {:>6} {:>14.3f} {:>14.3f} {:>8.2f}'.format(
+            tool, len(sources), totals[args.baseline],
+            totals[args.candidate],
+            totals[args.baseline] / max(totals[args.candidate], 1e-9)))
+
+    return 1 if differences else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -11,11 +11,15 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "ai.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <type_traits>
+#include <vector>
 
+#include <util/buffered_message_handler.h>
 #include <util/invariant.h>
+#include <util/parallel_for.h>
 
 void ai_baset::output(
   const namespacet &ns,
@@ -624,3 +628,165 @@ bool ai_recursive_interproceduralt::visit_edge_function_call(
     return new_data;
   }
 }
+
+/// Gives the per-function analyses of \ref ai_function_localt access to the
+/// history factory of the analysis that started them
+class shared_history_factoryt : public ai_history_factory_baset
+{
+public:
+  explicit shared_history_factoryt(ai_history_factory_baset &_factory)
+    : factory(_factory)
+  {
+  }
+
+  ai_history_baset::trace_ptrt epoch(ai_history_baset::locationt l) override
+  {
+    return factory.epoch(l);
+  }
+
+protected:
+  ai_history_factory_baset &factory;
+};
+
+/// Gives the per-function analyses of \ref ai_function_localt access to the
+/// domain factory of the analysis that started them
+class shared_domain_factoryt : public ai_domain_factory_baset
+{
+public:
+  explicit shared_domain_factoryt(const ai_domain_factory_baset &_factory)
+    : factory(_factory)
+  {
+  }
+
+  std::unique_ptr<statet> make(locationt l) const override
+  {
+    return factory.make(l);
+  }
+
+  std::unique_ptr<statet> copy(const statet &s) const override
+  {
+    return factory.copy(s);
+  }
+
+  bool merge(statet &dest, const statet &src, trace_ptrt from, trace_ptrt to)
+    const override
+  {
+    return factory.merge(dest, src, from, to);
+  }
+
+protected:
+  const ai_domain_factory_baset &factory;
+};
+
+/// The analysis of a single function on behalf of \ref ai_function_localt
+class function_local_workert : public ai_baset
+{
+public:
+  function_local_workert(
+    ai_history_factory_baset &hf,
+    const ai_domain_factory_baset &df,
+    std::unique_ptr<ai_storage_baset> &&st,
+    message_handlert &mh)
+    : ai_baset(
+        std::make_unique<shared_history_factoryt>(hf),
+        std::make_unique<shared_domain_factoryt>(df),
+        std::move(st),
+        mh)
+  {
+  }
+
+  void operator()(
+    const irep_idt &function_id,
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns)
+  {
+    fixedpoint(
+      entry_state(goto_program), function_id, goto_program, goto_functions, ns);
+  }
+
+  ai_storage_baset &get_storage()
+  {
+    return *storage;
+  }
+};
+
+void ai_function_localt::fixedpoint(
+  trace_ptrt,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  std::vector<goto_functionst::function_mapt::const_iterator> functions;
+  for(auto f_it = goto_functions.function_map.begin();
+      f_it != goto_functions.function_map.end();
+      ++f_it)
+  {
+    if(f_it->second.body_available())
+      functions.push_back(f_it);
+  }
+
+  messaget log(message_handler);
+
+  std::size_t threads = effective_number_of_threads(number_of_threads);
+#if !IREP_ATOMIC_REF_COUNT
+  if(threads > 1)
+  {
+    log.warning() << "analysing functions in parallel requires a build with "
+                  << "IREP_ATOMIC_REF_COUNT, using a single thread"
+                  << messaget::eom;
+    threads = 1;
+  }
+#endif
+
+  if(threads <= 1 || functions.size() <= 1 || !storage->make_empty())
+  {
+    for(const auto &f_it : functions)
+    {
+      fixedpoint(
+        entry_state(f_it->second.body),
+        f_it->first,
+        f_it->second.body,
+        goto_functions,
+        ns);
+    }
+
+    return;
+  }
+
+  struct resultt
+  {
+    std::unique_ptr<function_local_workert> worker;
+    std::unique_ptr<buffered_message_handlert> message_handler;
+  };
+  std::vector<resultt> results(functions.size());
+
+  parallel_for(
+    threads,
+    functions.size(),
+    [&](std::size_t, std::size_t index) {
+      resultt &result = results[index];
+      result.message_handler =
+        std::make_unique<buffered_message_handlert>(message_handler);
+      result.worker = std::make_unique<function_local_workert>(
+        *history_factory,
+        *domain_factory,
+        storage->make_empty(),
+        *result.message_handler);
+      (*result.worker)(
+        functions[index]->first,
+        functions[index]->second.body,
+        goto_functions,
+        ns);
+    });
+
+  for(auto &result : results)
+  {
+    result.message_handler->replay();
+    storage->absorb(result.worker->get_storage());
+    result.worker.reset();
+  }
+
+  log.statistics() << "Analysed " << functions.size() << " functions using "
+                   << std::min(threads, functions.size()) << " threads"
+                   << messaget::eom;
+}
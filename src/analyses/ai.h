@@ -548,6 +548,45 @@ class ai_recursive_interproceduralt : public ai_baset
     const namespacet &ns) override;
 };
 
+/// Analyse each function that has a body on its own, starting from the entry
+/// state of the domain. Function calls are handled as in \ref ai_baset, i.e.,
+/// the domain over-approximates their effect in the caller, which makes the
+/// analysis function-local and context-insensitive. As the analyses of
+/// different functions are independent, they are run on up to
+/// number_of_threads threads, each function with its own storage and
+/// messages. The results are then joined into the storage of this object in
+/// the order of the function map, hence they do not depend on the number of
+/// threads. Any state that domains share across functions must thus be
+/// thread-safe and must not depend on the order in which functions are
+/// analysed. Running on more than one thread requires a build with
+/// IREP_ATOMIC_REF_COUNT and a storage that supports
+/// \ref ai_storage_baset::make_empty; otherwise one thread is used.
+class ai_function_localt : public ai_baset
+{
+public:
+  ai_function_localt(
+    std::unique_ptr<ai_history_factory_baset> &&hf,
+    std::unique_ptr<ai_domain_factory_baset> &&df,
+    std::unique_ptr<ai_storage_baset> &&st,
+    message_handlert &mh,
+    std::size_t _number_of_threads = 1)
+    : ai_baset(std::move(hf), std::move(df), std::move(st), mh),
+      number_of_threads(_number_of_threads)
+  {
+  }
+
+protected:
+  /// 0 means one thread per hardware thread
+  std::size_t number_of_threads;
+
+  using ai_baset::fixedpoint;
+
+  void fixedpoint(
+    trace_ptrt start_trace,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+};
+
 /// ait supplies three of the four components needed: an abstract interpreter
 /// (in this case handling function calls via recursion), a history factory
 /// (using the simplest possible history objects) and storage (one domain per
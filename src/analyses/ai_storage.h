@@ -92,6 +92,25 @@ class ai_storage_baset
   {
     return;
   }
+
+  /// Create a storage of the same kind that does not hold any histories or
+  /// domains, for example to analyse parts of a program separately.
+  /// \return the new storage, or nullptr if this kind of storage does not
+  ///   support being combined using \ref absorb
+  virtual std::unique_ptr<ai_storage_baset> make_empty() const
+  {
+    return nullptr;
+  }
+
+  /// Move all histories and domains of \p other into this storage. Where
+  /// both hold a domain for the same history or location, the one of \p other
+  /// is kept.
+  /// \param other: a storage created by \ref make_empty of this storage;
+  ///   it is left empty
+  virtual void absorb(ai_storage_baset &other)
+  {
+    UNREACHABLE;
+  }
 };
 
 // There are a number of options for how to store the history objects.
@@ -142,6 +161,18 @@ class trace_map_storaget : public ai_storage_baset
     trace_map.clear();
     return;
   }
+
+protected:
+  void absorb_traces(trace_map_storaget &other)
+  {
+    for(auto &entry : other.trace_map)
+    {
+      auto ins = trace_map.emplace(entry.first, entry.second);
+      if(!ins.second)
+        ins.first->second->insert(entry.second->begin(), entry.second->end());
+    }
+    other.trace_map.clear();
+  }
 };
 
 // A couple of older domains make direct use of the state map
@@ -221,6 +252,20 @@ class location_sensitive_storaget : public trace_map_storaget
     state_map.clear();
     return;
   }
+
+  std::unique_ptr<ai_storage_baset> make_empty() const override
+  {
+    return std::make_unique<location_sensitive_storaget>();
+  }
+
+  void absorb(ai_storage_baset &other) override
+  {
+    auto &o = dynamic_cast<location_sensitive_storaget &>(other);
+    absorb_traces(o);
+    for(auto &entry : o.state_map)
+      state_map[entry.first] = std::move(entry.second);
+    o.state_map.clear();
+  }
 };
 
 // The most precise form of storage
@@ -299,6 +344,20 @@ class history_sensitive_storaget : public trace_map_storaget
     domain_map.clear();
     return;
   }
+
+  std::unique_ptr<ai_storage_baset> make_empty() const override
+  {
+    return std::make_unique<history_sensitive_storaget>();
+  }
+
+  void absorb(ai_storage_baset &other) override
+  {
+    auto &o = dynamic_cast<history_sensitive_storaget &>(other);
+    absorb_traces(o);
+    for(auto &entry : o.domain_map)
+      domain_map[entry.first] = std::move(entry.second);
+    o.domain_map.clear();
+  }
 };
 
 #endif
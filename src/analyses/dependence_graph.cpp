@@ -151,27 +151,35 @@ static bool may_be_def_use_pair(
     return false;
 }
 
-void dep_graph_domaint::data_dependencies(
-  goto_programt::const_targett,
-  const irep_idt &function_to,
-  goto_programt::const_targett to,
-  dependence_grapht &dep_graph,
-  const namespacet &ns)
+std::set<goto_programt::const_targett, goto_programt::target_less_than>
+compute_data_dependencies(
+  const irep_idt &function_id,
+  goto_programt::const_targett target,
+  const reaching_definitions_analysist &reaching_definitions,
+  const namespacet &ns,
+  message_handlert &message_handler)
 {
   // data dependencies using def-use pairs
-  data_deps.clear();
+  std::set<goto_programt::const_targett, goto_programt::target_less_than>
+    data_deps;
+
+  // no definitions reach locations that the analysis has not reached
+  const auto state_ptr = reaching_definitions.abstract_state_before(target);
+  const rd_range_domaint &state =
+    static_cast<const rd_range_domaint &>(*state_ptr);
+  if(state.is_bottom())
+    return data_deps;
 
   // TODO use (future) reaching-definitions-dereferencing rw_set
-  value_setst &value_sets=
-    dep_graph.reaching_definitions().get_value_sets();
+  value_setst &value_sets = reaching_definitions.get_value_sets();
   rw_range_set_value_sett rw_set(ns, value_sets, message_handler);
-  goto_rw(function_to, to, rw_set);
+  goto_rw(function_id, target, rw_set);
 
   for(const auto &read_object_entry : rw_set.get_r_set())
   {
     const range_domaint &r_ranges = rw_set.get_ranges(read_object_entry.second);
     const rd_range_domaint::ranges_at_loct &w_ranges =
-      dep_graph.reaching_definitions()[to].get(read_object_entry.first);
+      state.get(read_object_entry.first);
 
     for(const auto &w_range : w_ranges)
     {
@@ -192,9 +200,22 @@ void dep_graph_domaint::data_dependencies(
       }
     }
 
-    dep_graph.reaching_definitions()[to].clear_cache(read_object_entry.first);
+    state.clear_cache(read_object_entry.first);
   }
 
+  return data_deps;
+}
+
+void dep_graph_domaint::data_dependencies(
+  goto_programt::const_targett,
+  const irep_idt &function_to,
+  goto_programt::const_targett to,
+  dependence_grapht &dep_graph,
+  const namespacet &ns)
+{
+  data_deps = compute_data_dependencies(
+    function_to, to, dep_graph.reaching_definitions(), ns, message_handler);
+
   if(to->is_set_return_value())
   {
     auto entry = dep_graph.end_function_map.find(function_to);
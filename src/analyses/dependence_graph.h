@@ -213,6 +213,17 @@ class dep_graph_domaint:public ai_domain_baset
     const namespacet &ns);
 };
 
+/// Compute the data dependencies of the instruction at \p target, i.e., the
+/// locations of those definitions that reach \p target according to
+/// \p reaching_definitions and that may define what \p target reads
+std::set<goto_programt::const_targett, goto_programt::target_less_than>
+compute_data_dependencies(
+  const irep_idt &function_id,
+  goto_programt::const_targett target,
+  const reaching_definitions_analysist &reaching_definitions,
+  const namespacet &ns,
+  message_handlert &message_handler);
+
 class dep_graph_domain_factoryt;
 
 class dependence_grapht:
@@ -120,10 +120,13 @@ abstract_environmentt::eval(const exprt &expr, const namespacet &ns) const
     return abstract_object_factory(simplified_expr.type(), simplified_expr, ns);
 
   if(is_dynamic_allocation(simplified_expr))
+  {
+    // the source location identifies the function that allocates
+    exprt dynamic_object(ID_dynamic_object, simplified_expr.type());
+    dynamic_object.add_source_location() = simplified_expr.source_location();
     return abstract_object_factory(
-      typet(ID_dynamic_object),
-      exprt(ID_dynamic_object, simplified_expr.type()),
-      ns);
+      typet(ID_dynamic_object), dynamic_object, ns);
+  }
 
   // No special handling required by the abstract environment
   // delegate to the abstract object
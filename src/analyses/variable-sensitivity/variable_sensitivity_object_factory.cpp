@@ -194,9 +194,18 @@ variable_sensitivity_object_factoryt::get_abstract_object(
 
   case HEAP_ALLOCATION:
   {
+    const irep_idt &function = e.source_location().get_function();
+    std::size_t number;
+    {
+      std::lock_guard<std::mutex> lock(heap_allocations_mutex);
+      number = heap_allocations[function]++;
+    }
     auto dynamic_object = exprt(ID_dynamic_object);
     dynamic_object.set(
-      ID_identifier, "heap-allocation-" + std::to_string(heap_allocations++));
+      ID_identifier,
+      "heap-allocation-" +
+        (function.empty() ? "" : id2string(function) + "-") +
+        std::to_string(number));
     auto heap_symbol = unary_exprt(ID_address_of, dynamic_object, e.type());
     auto heap_pointer =
       get_abstract_object(e.type(), false, false, heap_symbol, environment, ns);
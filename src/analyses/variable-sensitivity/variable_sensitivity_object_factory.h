@@ -18,6 +18,9 @@
 #include "abstract_object.h"
 #include "variable_sensitivity_configuration.h"
 
+#include <mutex>
+#include <unordered_map>
+
 class variable_sensitivity_object_factoryt;
 using variable_sensitivity_object_factory_ptrt =
   std::shared_ptr<variable_sensitivity_object_factoryt>;
@@ -32,7 +35,7 @@ class variable_sensitivity_object_factoryt
   }
 
   explicit variable_sensitivity_object_factoryt(const vsd_configt &options)
-    : configuration{options}, heap_allocations(0)
+    : configuration{options}
   {
   }
 
@@ -80,7 +83,13 @@ class variable_sensitivity_object_factoryt
   ABSTRACT_OBJECT_TYPET get_abstract_object_type(const typet &type) const;
 
   vsd_configt configuration;
-  mutable size_t heap_allocations;
+
+  /// Heap allocations are named after the function that contains them and
+  /// the number of allocations in that function so far. As each function is
+  /// analysed on a single thread, the names do not depend on the order in
+  /// which different functions are analysed.
+  mutable std::unordered_map<irep_idt, size_t> heap_allocations;
+  mutable std::mutex heap_allocations_mutex;
 };
 
 #endif // CPROVER_ANALYSES_VARIABLE_SENSITIVITY_VARIABLE_SENSITIVITY_OBJECT_FACTORY_H // NOLINT(*)
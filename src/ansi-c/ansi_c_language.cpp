@@ -65,6 +65,17 @@ bool ansi_c_languaget::parse(
 
   std::istringstream i_preprocessed(o_preprocessed.str());
 
+  return parse_preprocessed(i_preprocessed, path, message_handler);
+}
+
+bool ansi_c_languaget::parse_preprocessed(
+  std::istream &instream,
+  const std::string &path,
+  message_handlert &message_handler)
+{
+  // store the path
+  parse_path=path;
+
   // parsing
 
   std::string code;
@@ -92,7 +103,7 @@ bool ansi_c_languaget::parse(
   {
     ansi_c_parser.set_line_no(0);
     ansi_c_parser.set_file(path);
-    ansi_c_parser.in=&i_preprocessed;
+    ansi_c_parser.in = &instream;
     ansi_c_scanner_init(ansi_c_parser);
     result=ansi_c_parser.parse();
   }
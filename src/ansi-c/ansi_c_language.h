@@ -51,6 +51,13 @@ class ansi_c_languaget:public languaget
     const std::string &path,
     message_handlert &message_handler) override;
 
+  /// Like \ref parse, but \p instream holds text that \ref preprocess has
+  /// produced already
+  bool parse_preprocessed(
+    std::istream &instream,
+    const std::string &path,
+    message_handlert &message_handler);
+
   bool generate_support_functions(
     symbol_table_baset &symbol_table,
     message_handlert &message_handler) override;
@@ -10,10 +10,22 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/config.h>
 #include <util/cprover_prefix.h>
-#include <util/symbol_table_base.h>
+#include <util/exception_utils.h>
+#include <util/message.h>
+#include <util/sha256.h>
+#include <util/symbol_table.h>
+#include <util/version.h>
+
+#include <goto-programs/goto_functions.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
 
 #include "ansi_c_language.h"
 
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
 #include <sstream>
 
 static std::string get_cprover_library_text(
@@ -111,6 +123,140 @@ void cprover_c_library_factory(
   add_library(library_text, dest_symbol_table, message_handler);
 }
 
+/// The configuration that parsing and type checking depend on, beyond what
+/// preprocessing already takes into account
+static std::string typecheck_configuration()
+{
+  const auto &ansi_c = config.ansi_c;
+  std::ostringstream result;
+  result << ansi_c.int_width << ' ' << ansi_c.long_int_width << ' '
+         << ansi_c.bool_width << ' ' << ansi_c.char_width << ' '
+         << ansi_c.short_int_width << ' ' << ansi_c.long_long_int_width << ' '
+         << ansi_c.pointer_width << ' ' << ansi_c.single_width << ' '
+         << ansi_c.double_width << ' ' << ansi_c.long_double_width << ' '
+         << ansi_c.wchar_t_width << ' ' << ansi_c.char_is_unsigned << ' '
+         << ansi_c.wchar_t_is_unsigned << ' ' << ansi_c.for_has_scope << ' '
+         << ansi_c.ts_18661_3_Floatn_types << ' ' << ansi_c.gcc__float128_type
+         << ' ' << ansi_c.__float128_is_keyword << ' ' << ansi_c.float16_type
+         << ' ' << ansi_c.bf16_type << ' ' << ansi_c.fp16_type << ' '
+         << ansi_c.single_precision_constant << ' '
+         << static_cast<int>(ansi_c.c_standard) << ' '
+         << static_cast<int>(ansi_c.rounding_mode) << ' ' << ansi_c.alignment
+         << ' ' << ansi_c.memory_operand_size << ' '
+         << static_cast<int>(ansi_c.endianness) << ' '
+         << static_cast<int>(ansi_c.os) << ' ' << ansi_c.arch << ' '
+         << ansi_c.NULL_is_zero << ' ' << static_cast<int>(ansi_c.mode) << ' '
+         << static_cast<int>(ansi_c.preprocessor);
+  return result.str();
+}
+
+/// \return the key of the cache entry that holds the symbols that parsing
+///   and type checking \p preprocessed_text with \p keep produce
+static std::string library_cache_key(
+  const std::string &preprocessed_text,
+  const std::set<irep_idt> &keep)
+{
+  sha256t sha256;
+
+  // each part is preceded by its length to keep the key unambiguous
+  const auto add_string = [&sha256](const std::string &string) {
+    sha256.update(std::to_string(string.size()) + ':');
+    sha256.update(string);
+  };
+
+  add_string(CBMC_VERSION);
+  add_string(typecheck_configuration());
+  add_string(preprocessed_text);
+  for(const auto &identifier : keep)
+    add_string(id2string(identifier));
+
+  return sha256t::to_hex(sha256.digest());
+}
+
+/// The file in \p cache_directory that holds the entry with key \p key
+static std::string
+library_cache_file(const std::string &cache_directory, const std::string &key)
+{
+  return (std::filesystem::path(cache_directory) /
+          ("cprover-library-" + key + ".gb"))
+    .string();
+}
+
+/// Add the symbols stored in \p cache_file to \p symbol_table
+/// \return false on success, true if there is no such (valid) cache entry
+///   for \p key
+static bool read_library_cache(
+  const std::string &cache_file,
+  const std::string &key,
+  symbol_table_baset &symbol_table)
+{
+  std::ifstream in(cache_file, std::ios::binary);
+  if(!in)
+    return true;
+
+  // the first line holds the key of the entry
+  std::string stored_key;
+  if(!std::getline(in, stored_key) || stored_key != key)
+    return true;
+
+  symbol_tablet cached_symbol_table;
+  goto_functionst goto_functions;
+  null_message_handlert null_message_handler;
+  try
+  {
+    if(read_bin_goto_object(
+         in,
+         cache_file,
+         cached_symbol_table,
+         goto_functions,
+         null_message_handler))
+    {
+      return true;
+    }
+  }
+  catch(const deserialization_exceptiont &)
+  {
+    return true;
+  }
+
+  for(const auto &symbol_pair : cached_symbol_table.symbols)
+    symbol_table.insert(symbol_pair.second);
+
+  return false;
+}
+
+/// Store the symbols in \p symbol_table in \p cache_file as the entry with
+/// key \p key, failing silently
+static void write_library_cache(
+  const std::string &cache_file,
+  const std::string &key,
+  const symbol_table_baset &symbol_table)
+{
+  std::error_code error;
+  std::filesystem::create_directories(
+    std::filesystem::path(cache_file).parent_path(), error);
+
+  // Write to a file of our own first, such that concurrent runs never read a
+  // partially written entry.
+  std::random_device random;
+  const std::string temporary_file =
+    cache_file + "." + std::to_string(random()) + ".tmp";
+
+  {
+    std::ofstream out(temporary_file, std::ios::binary);
+    out << key << '\n';
+    if(!out || write_goto_binary(out, symbol_table, goto_functionst{}) || !out)
+    {
+      std::filesystem::remove(temporary_file, error);
+      return;
+    }
+  }
+
+  std::filesystem::rename(temporary_file, cache_file, error);
+  if(error)
+    std::filesystem::remove(temporary_file, error);
+}
+
 void add_library(
   const std::string &src,
   symbol_table_baset &symbol_table,
@@ -120,13 +266,60 @@ void add_library(
   if(src.empty())
     return;
 
+  ansi_c_languaget ansi_c_language;
+
+  // Parsing and type checking the library along with the internal additions
+  // takes much longer than reading the resulting symbols, which only depend
+  // on the preprocessed text and the configuration when the symbol table is
+  // empty. Hence these are cached across runs, in the directory given by the
+  // environment variable CBMC_LIBRARY_CACHE.
+  const char *cache_directory = std::getenv("CBMC_LIBRARY_CACHE");
+  if(
+    cache_directory == nullptr || *cache_directory == 0 ||
+    !symbol_table.symbols.empty())
+  {
+    std::istringstream in(src);
+    ansi_c_language.parse(in, "", message_handler);
+
+    ansi_c_language.typecheck(
+      symbol_table, "<built-in-library>", message_handler, true, keep);
+    return;
+  }
+
+  const std::size_t errors_and_warnings_before =
+    message_handler.get_message_count(messaget::M_ERROR) +
+    message_handler.get_message_count(messaget::M_WARNING);
+
   std::istringstream in(src);
+  std::ostringstream preprocessed;
+  if(ansi_c_language.preprocess(in, "", preprocessed, message_handler))
+    return;
 
-  ansi_c_languaget ansi_c_language;
-  ansi_c_language.parse(in, "", message_handler);
+  const std::string key = library_cache_key(preprocessed.str(), keep);
+  const std::string cache_file = library_cache_file(cache_directory, key);
+
+  if(!read_library_cache(cache_file, key, symbol_table))
+  {
+    messaget log{message_handler};
+    log.debug() << "Read library symbols from " << cache_file
+                << messaget::eom;
+    return;
+  }
+
+  std::istringstream preprocessed_in(preprocessed.str());
+  ansi_c_language.parse_preprocessed(preprocessed_in, "", message_handler);
 
   ansi_c_language.typecheck(
     symbol_table, "<built-in-library>", message_handler, true, keep);
+
+  // entries that would lose messages are not stored
+  if(
+    message_handler.get_message_count(messaget::M_ERROR) +
+      message_handler.get_message_count(messaget::M_WARNING) ==
+    errors_and_warnings_before)
+  {
+    write_library_cache(cache_file, key, symbol_table);
+  }
 }
 
 void cprover_c_library_factory_force_load(
@@ -10,13 +10,19 @@ Date: June 2003
 
 #include "goto_convert_functions.h"
 
+#include <util/buffered_message_handler.h>
+#include <util/journalling_symbol_table.h>
+#include <util/parallel_for.h>
 #include <util/std_code.h>
+#include <util/symbol_table.h>
 #include <util/symbol_table_builder.h>
 
 #include <goto-programs/goto_model.h>
 
 #include <linking/static_lifetime_init.h>
 
+#include <memory>
+
 goto_convert_functionst::goto_convert_functionst(
   symbol_table_baset &_symbol_table,
   message_handlert &_message_handler)
@@ -28,11 +34,13 @@ goto_convert_functionst::~goto_convert_functionst()
 {
 }
 
-void goto_convert_functionst::goto_convert(goto_functionst &functions)
+void goto_convert_functionst::goto_convert(
+  goto_functionst &functions,
+  std::size_t number_of_threads)
 {
   // warning! hash-table iterators are not stable
 
-  typedef std::list<irep_idt> symbol_listt;
+  typedef std::vector<irep_idt> symbol_listt;
   symbol_listt symbol_list;
 
   for(const auto &symbol_pair : symbol_table.symbols)
@@ -48,9 +56,27 @@ void goto_convert_functionst::goto_convert(goto_functionst &functions)
     }
   }
 
-  for(const auto &id : symbol_list)
+  bool parallel = symbol_list.size() > 1 &&
+                  effective_number_of_threads(number_of_threads) > 1;
+
+#if !IREP_ATOMIC_REF_COUNT
+  if(parallel)
   {
-    convert_function(id, functions.function_map[id]);
+    warning() << "parallel goto conversion requires a build with "
+              << "IREP_ATOMIC_REF_COUNT, converting sequentially"
+              << messaget::eom;
+    parallel = false;
+  }
+#endif
+
+  if(parallel)
+    convert_functions_in_parallel(symbol_list, functions, number_of_threads);
+  else
+  {
+    for(const auto &id : symbol_list)
+    {
+      convert_function(id, functions.function_map[id]);
+    }
   }
 
   functions.compute_location_numbers();
@@ -69,6 +95,135 @@ void goto_convert_functionst::goto_convert(goto_functionst &functions)
 #endif
 }
 
+/// Convert the functions \p function_ids using up to \p number_of_threads
+/// threads. Each thread converts functions against a private copy of the
+/// symbol table, which it restores after each function, hence every function
+/// is converted against the same symbol table. The symbols that the
+/// conversion of a function adds, such as temporaries, and the messages it
+/// produces are staged per function. The stages are then merged in the order
+/// of \p function_ids. A function is converted again, against the merged
+/// symbol table, if its conversion failed or modified existing symbols, or
+/// if any of its new symbols has been added by a preceding function. The
+/// result thus does not depend on the scheduling of the threads and matches
+/// that of converting sequentially.
+/// Requires ireps to be shareable between threads, i.e., a build with
+/// IREP_ATOMIC_REF_COUNT.
+void goto_convert_functionst::convert_functions_in_parallel(
+  const std::vector<irep_idt> &function_ids,
+  goto_functionst &functions,
+  std::size_t number_of_threads)
+{
+  struct staged_conversiont
+  {
+    goto_functionst::goto_functiont function;
+    std::vector<symbolt> new_symbols;
+    std::unique_ptr<buffered_message_handlert> message_handler;
+    bool convert_again = false;
+  };
+
+  std::vector<staged_conversiont> stages(function_ids.size());
+  std::vector<std::unique_ptr<symbol_tablet>> thread_symbol_tables(
+    effective_number_of_threads(number_of_threads));
+  message_handlert &output_message_handler = get_message_handler();
+
+  // The threads only read the symbol table and the goto functions.
+  parallel_for(
+    number_of_threads,
+    function_ids.size(),
+    [&](std::size_t thread, std::size_t index) {
+      const irep_idt &id = function_ids[index];
+      staged_conversiont &stage = stages[index];
+
+      const auto existing = functions.function_map.find(id);
+      if(
+        existing != functions.function_map.end() &&
+        existing->second.body_available())
+      {
+        // nothing to do, let convert_function decide that later
+        stage.convert_again = true;
+        return;
+      }
+
+      std::unique_ptr<symbol_tablet> &thread_symbol_table =
+        thread_symbol_tables[thread];
+      if(!thread_symbol_table)
+      {
+        thread_symbol_table = std::make_unique<symbol_tablet>();
+        for(const auto &symbol_pair : symbol_table.symbols)
+          thread_symbol_table->insert(symbol_pair.second);
+      }
+
+      journalling_symbol_tablet journal =
+        journalling_symbol_tablet::wrap(*thread_symbol_table);
+      symbol_table_buildert symbol_table_builder =
+        symbol_table_buildert::wrap(journal);
+      stage.message_handler =
+        std::make_unique<buffered_message_handlert>(output_message_handler);
+      goto_convert_functionst converter(
+        symbol_table_builder, *stage.message_handler);
+
+      try
+      {
+        converter.convert_function(id, stage.function);
+      }
+      catch(...)
+      {
+        // converting again will raise the exception in order
+        stage.convert_again = true;
+      }
+
+      if(
+        !journal.get_removed().empty() ||
+        journal.get_updated().size() != journal.get_inserted().size())
+      {
+        // existing symbols have been changed, start over with a fresh copy
+        stage.convert_again = true;
+        thread_symbol_table.reset();
+        return;
+      }
+
+      for(const auto &new_id : journal.get_inserted())
+      {
+        const auto symbol_it = thread_symbol_table->symbols.find(new_id);
+        stage.new_symbols.push_back(symbol_it->second);
+        thread_symbol_table->erase(symbol_it);
+      }
+    });
+
+  std::size_t converted_again = 0;
+
+  for(std::size_t index = 0; index < function_ids.size(); ++index)
+  {
+    const irep_idt &id = function_ids[index];
+    staged_conversiont &stage = stages[index];
+
+    // A fresh name chosen by the thread may since have been taken, in which
+    // case a sequential conversion would have chosen a different name.
+    for(const auto &new_symbol : stage.new_symbols)
+    {
+      if(symbol_table.has_symbol(new_symbol.name))
+        stage.convert_again = true;
+    }
+
+    if(stage.convert_again)
+    {
+      ++converted_again;
+      convert_function(id, functions.function_map[id]);
+      continue;
+    }
+
+    for(auto &new_symbol : stage.new_symbols)
+      symbol_table.insert(std::move(new_symbol));
+
+    stage.message_handler->replay();
+    functions.function_map[id] = std::move(stage.function);
+  }
+
+  statistics() << "Converted " << function_ids.size()
+               << " functions in parallel, " << converted_again
+               << " of them sequentially" << eom;
+}
+
 bool goto_convert_functionst::hide(const goto_programt &goto_program)
 {
   for(const auto &instruction : goto_program.instructions)
@@ -252,7 +407,8 @@ void goto_convert(goto_modelt &goto_model, message_handlert &message_handler)
 void goto_convert(
   symbol_table_baset &symbol_table,
   goto_functionst &functions,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  std::size_t number_of_threads)
 {
   symbol_table_buildert symbol_table_builder =
     symbol_table_buildert::wrap(symbol_table);
@@ -260,7 +416,7 @@ void goto_convert(
   goto_convert_functionst goto_convert_functions(
     symbol_table_builder, message_handler);
 
-  goto_convert_functions.goto_convert(functions);
+  goto_convert_functions.goto_convert(functions, number_of_threads);
 }
 
 void goto_convert(
@@ -18,13 +18,16 @@ Date: June 2003
 
 #include <goto-programs/goto_functions.h>
 
+#include <vector>
+
 class goto_modelt;
 
 // convert it all!
 void goto_convert(
   symbol_table_baset &symbol_table,
   goto_functionst &functions,
-  message_handlert &);
+  message_handlert &,
+  std::size_t number_of_threads = 1);
 
 // convert it all!
 void goto_convert(goto_modelt &, message_handlert &);
@@ -39,7 +42,15 @@ void goto_convert(
 class goto_convert_functionst : public goto_convertt
 {
 public:
-  void goto_convert(goto_functionst &functions);
+  /// Convert all functions in the symbol table that have a body.
+  /// \param functions: goto functions to add the converted functions to
+  /// \param number_of_threads: convert function bodies using up to this many
+  ///   threads, 0 meaning one per hardware thread; more than one requires a
+  ///   build with IREP_ATOMIC_REF_COUNT, see \ref convert_functions_in_parallel
+  void goto_convert(
+    goto_functionst &functions,
+    std::size_t number_of_threads = 1);
+
   void convert_function(
     const irep_idt &identifier,
     goto_functionst::goto_functiont &result);
@@ -53,6 +64,11 @@ class goto_convert_functionst : public goto_convertt
 protected:
   static bool hide(const goto_programt &);
 
+  void convert_functions_in_parallel(
+    const std::vector<irep_idt> &function_ids,
+    goto_functionst &functions,
+    std::size_t number_of_threads);
+
   //
   // function calls
   //
@@ -12,9 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "cbmc_parse_options.h"
 
 #include <util/config.h>
+#include <util/exception_utils.h>
 #include <util/exit_codes.h>
 #include <util/help_formatter.h>
 #include <util/invariant.h>
+#include <util/string2int.h>
 #include <util/unicode.h>
 #include <util/version.h>
 
@@ -42,6 +44,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-checker/bmc_util.h>
 #include <goto-checker/cover_goals_verifier_with_trace_storage.h>
 #include <goto-checker/multi_path_symex_checker.h>
+#include <goto-checker/multi_path_symex_parallel_checker.h>
 #include <goto-checker/multi_path_symex_only_checker.h>
 #include <goto-checker/properties.h>
 #include <goto-checker/single_loop_incremental_symex_checker.h>
@@ -49,6 +52,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-checker/single_path_symex_only_checker.h>
 #include <goto-checker/stop_on_fail_verifier.h>
 #include <goto-checker/stop_on_fail_verifier_with_fault_localization.h>
+#include <goto-checker/verification_cache.h>
 #include <goto-instrument/cover.h>
 #include <goto-instrument/full_slicer.h>
 #include <goto-instrument/nondet_static.h>
@@ -64,6 +68,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <fstream> // IWYU pragma: keep
 #include <iostream>
 #include <memory>
+#include <optional>
 
 cbmc_parse_optionst::cbmc_parse_optionst(int argc, const char **argv)
   : parse_options_baset(
@@ -228,6 +233,12 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("full-slice"))
     options.set_option("full-slice", true);
 
+  if(cmdline.isset("parallel-slicing"))
+  {
+    options.set_option(
+      "parallel-slicing", cmdline.get_value("parallel-slicing"));
+  }
+
   if(cmdline.isset("show-symex-strategies"))
   {
     log.status() << show_path_strategies() << messaget::eom;
@@ -330,6 +341,50 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("localize-faults"))
     options.set_option("localize-faults", true);
 
+  if(cmdline.isset("parallel-goto-conversion"))
+  {
+    options.set_option(
+      "parallel-goto-conversion",
+      cmdline.get_value("parallel-goto-conversion"));
+  }
+
+  if(cmdline.isset("parallel-properties"))
+  {
+    // only the verifier for all properties using multi-path symex decides
+    // properties in parallel
+    for(const char *conflicting : {"paths", "stop-on-fail", "localize-faults"})
+    {
+      if(cmdline.isset(conflicting))
+      {
+        throw invalid_command_line_argument_exceptiont(
+          "--parallel-properties cannot be used together with --" +
+            std::string(conflicting),
+          "--parallel-properties");
+      }
+    }
+
+    const std::string workers = cmdline.get_value("parallel-properties");
+    if(!string2optional_unsigned(workers).has_value())
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "expected a number of worker processes, got '" + workers + "'",
+        "--parallel-properties");
+    }
+
+    options.set_option("parallel-properties", workers);
+  }
+
+  if(cmdline.isset("parallel-paths"))
+  {
+    if(!cmdline.isset("paths"))
+    {
+      log.error() << "--parallel-paths requires --paths" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("parallel-paths", cmdline.get_value("parallel-paths"));
+  }
+
   if(cmdline.isset("unwind"))
   {
     options.set_option("unwind", cmdline.get_value("unwind"));
@@ -452,6 +507,12 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("paths-symex-explore-all", true);
   }
 
+  if(cmdline.isset("verification-cache"))
+  {
+    options.set_option(
+      "verification-cache", cmdline.get_value("verification-cache"));
+  }
+
   if(cmdline.isset("validate-ssa-equation"))
   {
     options.set_option("validate-ssa-equation", true);
@@ -761,6 +822,12 @@ int cbmc_parse_optionst::doit()
         std::make_unique<all_properties_verifier_with_fault_localizationt<
           multi_path_symex_checkert>>(options, ui_message_handler, goto_model);
     }
+    else if(options.is_set("parallel-properties"))
+    {
+      verifier = std::make_unique<all_properties_verifier_with_trace_storaget<
+        multi_path_symex_parallel_checkert>>(
+        options, ui_message_handler, goto_model);
+    }
     else
     {
       verifier = std::make_unique<
@@ -773,9 +840,29 @@ int cbmc_parse_optionst::doit()
     UNREACHABLE;
   }
 
-  const resultt result = (*verifier)();
+  std::optional<verification_cachet> verification_cache;
+  if(options.is_set("verification-cache"))
+  {
+    verification_cache.emplace(
+      options.get_option("verification-cache"),
+      options,
+      goto_model,
+      ui_message_handler);
+    verifier->use_cache(*verification_cache);
+  }
+
+  // there is nothing to do, not even symbolic execution, when all properties
+  // hold according to the cache
+  const resultt result =
+    verification_cache.has_value() &&
+        !has_properties_to_check(verifier->get_properties())
+      ? determine_result(verifier->get_properties())
+      : (*verifier)();
   verifier->report();
 
+  if(verification_cache.has_value())
+    verification_cache->update(verifier->get_properties());
+
   return result_to_exit_code(result);
 }
 
@@ -986,13 +1073,18 @@ bool cbmc_parse_optionst::process_goto_program(
                   << "https://github.com/diffblue/cbmc/issues/260"
                   << messaget::eom;
     log.status() << "Performing a full slice" << messaget::eom;
+    const std::size_t number_of_threads =
+      options.is_set("parallel-slicing")
+        ? options.get_unsigned_int_option("parallel-slicing")
+        : 1;
     if(options.is_set("property"))
       property_slicer(
         goto_model,
         options.get_list_option("property"),
-        log.get_message_handler());
+        log.get_message_handler(),
+        number_of_threads);
     else
-      full_slicer(goto_model, log.get_message_handler());
+      full_slicer(goto_model, log.get_message_handler(), number_of_threads);
   }
 
   // remove any skips introduced since coverage instrumentation
@@ -1029,10 +1121,23 @@ void cbmc_parse_optionst::help()
     " {y--stop-on-fail} \t stop analysis once a failed property is detected"
     " (implies {y--trace})\n"
     " {y--localize-faults} \t localize faults (experimental)\n"
+    " {y--parallel-properties} {un} \t decide properties using up to {un}"
+    " worker processes after running symex once ({y0} uses all cores;"
+    " not with {y--paths}, {y--stop-on-fail} or {y--localize-faults})\n"
+    " {y--parallel-paths} {un} \t resume paths using up to {un} threads with"
+    " {y--paths} ({y0} uses all cores; requires a build with"
+    " IREP_ATOMIC_REF_COUNT)\n"
+    " {y--verification-cache} {uf} \t report properties that held in an"
+    " earlier run on the same program with the same options, as recorded"
+    " in {uf}, without checking them again, and record the properties that"
+    " hold in {uf}\n"
     "\n"
     "C/C++ frontend options:\n"
     " {y--preprocess} \t stop after preprocessing\n"
     " {y--test-preprocessor} \t stop after preprocessing, discard output\n"
+    " {y--parallel-goto-conversion} {un} \t convert function bodies using up"
+    " to {un} threads ({y0} uses all cores; requires a build with"
+    " IREP_ATOMIC_REF_COUNT)\n"
     HELP_CONFIG_C_CPP
     HELP_ANSI_C_LANGUAGE
     HELP_FUNCTIONS
@@ -1056,8 +1161,11 @@ void cbmc_parse_optionst::help()
     HELP_CONFIG_LIBRARY
     HELP_REACHABILITY_SLICER
     " {y--full-slice} \t run full slicer (experimental)\n"
+    " {y--parallel-slicing} {un} \t compute the dependencies of"
+    " {y--full-slice} using up to {un} threads ({y0} uses all cores)\n"
     " {y--drop-unused-functions} \t drop functions trivially unreachable from"
-    " main function\n"
+    " main function; when given a single goto binary, only the functions"
+    " that are reachable are read from it\n"
     "\n"
     "Semantic transformations:\n"
     " {y--nondet-static} \t add nondeterministic initialization of variables"
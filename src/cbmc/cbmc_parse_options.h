@@ -37,7 +37,7 @@ class optionst;
   "(no-standard-checks)" \
   "(preprocess)(slice-by-trace):" \
   OPT_FUNCTIONS \
-  "(no-simplify)(full-slice)" \
+  "(no-simplify)(full-slice)(parallel-slicing):" \
   OPT_REACHABILITY_SLICER \
   "(no-propagation)(no-simplify-if)" \
   "(document-subgoals)(test-preprocessor)" \
@@ -56,6 +56,10 @@ class optionst;
   "(show-symbol-table)(show-parse-tree)" \
   "(drop-unused-functions)" \
   "(property):(stop-on-fail)(trace)" \
+  "(parallel-properties):" \
+  "(parallel-paths):" \
+  "(verification-cache):" \
+  "(parallel-goto-conversion):" \
   "(verbosity):(no-library)" \
   "(nondet-static)" \
   "(version)" \
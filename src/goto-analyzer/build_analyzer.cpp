@@ -39,7 +39,8 @@ std::unique_ptr<ai_baset> build_analyzer(
   // These support all of the option categories
   if(
     options.get_bool_option("recursive-interprocedural") ||
-    options.get_bool_option("three-way-merge"))
+    options.get_bool_option("three-way-merge") ||
+    options.get_bool_option("function-local"))
   {
     // Build the history factory
     std::unique_ptr<ai_history_factory_baset> hf = nullptr;
@@ -111,6 +112,17 @@ std::unique_ptr<ai_baset> build_analyzer(
             std::move(hf), std::move(df), std::move(st), mh);
         }
       }
+      else if(options.get_bool_option("function-local"))
+      {
+        return std::make_unique<ai_function_localt>(
+          std::move(hf),
+          std::move(df),
+          std::move(st),
+          mh,
+          options.is_set("parallel-functions")
+            ? options.get_unsigned_int_option("parallel-functions")
+            : 1);
+      }
     }
   }
   else if(options.get_bool_option("legacy-ait"))
@@ -225,6 +225,16 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("recursive-interprocedural", true);
     else if(cmdline.isset("three-way-merge"))
       options.set_option("three-way-merge", true);
+    else if(
+      cmdline.isset("function-local") || cmdline.isset("parallel-functions"))
+    {
+      options.set_option("function-local", true);
+      if(cmdline.isset("parallel-functions"))
+      {
+        options.set_option(
+          "parallel-functions", cmdline.get_value("parallel-functions"));
+      }
+    }
     else if(cmdline.isset("legacy-ait") || cmdline.isset("location-sensitive"))
     {
       options.set_option("legacy-ait", true);
@@ -758,6 +768,10 @@ void goto_analyzer_parse_optionst::help()
     " reasoning\n"
     " {y--three-way-merge} \t use VSD's three-way merge on return from function"
     " call\n"
+    " {y--function-local} \t analyse each function on its own, approximating"
+    " function calls\n"
+    " {y--parallel-functions} {un} \t function-local, analysing up to {un}"
+    " functions in parallel, 0 for one per hardware thread\n"
     " {y--legacy-concurrent} \t legacy-ait with an extended fixed-point for"
     " concurrency\n"
     " {y--location-sensitive} \t use location-sensitive abstract interpreter\n"
@@ -116,6 +116,8 @@ class optionst;
 #define GOTO_ANALYSER_OPTIONS_AI \
   "(recursive-interprocedural)" \
   "(three-way-merge)" \
+  "(function-local)" \
+  "(parallel-functions):" \
   "(legacy-ait)" \
   "(legacy-concurrent)"
 
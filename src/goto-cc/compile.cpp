@@ -324,8 +324,14 @@ bool compilet::link(std::optional<symbol_tablet> &&symbol_table)
   convert_symbols(goto_model);
 
   // parse object files
-  if(read_objects_and_link(object_files, goto_model, log.get_message_handler()))
+  if(read_objects_and_link(
+       object_files,
+       goto_model,
+       log.get_message_handler(),
+       number_of_linking_threads))
+  {
     return true;
+  }
 
   // produce entry point?
 
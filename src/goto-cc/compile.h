@@ -34,6 +34,8 @@ class compilet
   // configuration
   bool echo_file_name;
   bool validate_goto_model = false;
+  /// number of threads for reading object files, 0 meaning one per core
+  std::size_t number_of_linking_threads = 1;
 
   enum { PREPROCESS_ONLY, // gcc -E
          COMPILE_ONLY, // gcc -c
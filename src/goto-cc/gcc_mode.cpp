@@ -25,6 +25,7 @@ Author: CM Wintersteiger, 2006
 #include <util/invariant.h>
 #include <util/prefix.h>
 #include <util/run.h>
+#include <util/string2int.h>
 #include <util/suffix.h>
 #include <util/tempdir.h>
 #include <util/version.h>
@@ -425,6 +426,12 @@ int gcc_modet::doit()
   // model validation
   compiler.validate_goto_model = cmdline.isset("validate-goto-model");
 
+  if(cmdline.isset("parallel-linking"))
+  {
+    compiler.number_of_linking_threads =
+      unsafe_string2size_t(cmdline.get_value("parallel-linking"));
+  }
+
   // determine actions to be undertaken
   if(cmdline.isset('S'))
     compiler.mode=compilet::ASSEMBLE_ONLY;
@@ -74,6 +74,9 @@ void goto_cc_modet::help()
     "symbols\n"
     " {y--print-rejected-preprocessed-source} {ufile} \t "
     "copy failing (preprocessed) source to file\n"
+    " {y--parallel-linking} {un} \t read goto object files using up to {un} "
+    "threads when linking ({y0} uses all cores; requires a build with "
+    "IREP_ATOMIC_REF_COUNT)\n"
     "\n");
 }
 
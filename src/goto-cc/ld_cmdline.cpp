@@ -23,6 +23,7 @@ const char *goto_ld_options_with_argument[]=
   "--native-compiler",
   "--native-linker",
   "--validate-goto-model",
+  "--parallel-linking",
   nullptr
 };
 
@@ -23,6 +23,7 @@ Author: CM Wintersteiger, 2006
 #include <util/config.h>
 #include <util/invariant.h>
 #include <util/run.h>
+#include <util/string2int.h>
 
 #include "compile.h"
 #include "goto_cc_cmdline.h"
@@ -91,6 +92,12 @@ int ld_modet::doit()
   // model validation
   compiler.validate_goto_model = cmdline.isset("validate-goto-model");
 
+  if(cmdline.isset("parallel-linking"))
+  {
+    compiler.number_of_linking_threads =
+      unsafe_string2size_t(cmdline.get_value("parallel-linking"));
+  }
+
   // get configuration
   config.set(cmdline);
 
@@ -27,6 +27,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include <solvers/decision_procedure.h>
 
 #include <util/json_stream.h>
+#include <util/memory_info.h>
 #include <util/ui_message.h>
 
 #include "goto_symex_property_decider.h"
@@ -338,6 +339,17 @@ void postprocess_equation(
   messaget log(ui_message_handler);
   log.statistics() << "size of program expression: "
                    << equation.SSA_steps.size() << " steps" << messaget::eom;
+  log.statistics() << "expression sharing: " << equation.count_merged_ireps()
+                   << " distinct nodes, "
+                   << equation.count_merged_duplicates()
+                   << " duplicates merged" << messaget::eom;
+  const auto &simplifier_cache = symex.get_simplifier_cache_statistics();
+  log.statistics() << "simplifier cache: " << simplifier_cache.hits
+                   << " hits, " << simplifier_cache.misses << " misses"
+                   << messaget::eom;
+  log.statistics() << "Memory usage after symex:\n";
+  memory_info(log.statistics());
+  log.statistics() << messaget::eom;
 
   slice(symex, equation, ns, options, ui_message_handler);
 
@@ -423,3 +435,17 @@ void run_property_decider(
     result.progress = incremental_goto_checkert::resultt::progresst::FOUND_FAIL;
   }
 }
+
+void release_irep_node_pool(messaget &log)
+{
+#if IREP_NODE_POOL
+  node_poolt &pool = irept::dt::node_pool();
+  const std::size_t released = pool.release_free_slabs();
+  log.statistics() << "Released " << released << " irep node slabs"
+                   << messaget::eom;
+  pool.compute_statistics().dump_on_stream(log.statistics());
+  log.statistics() << messaget::eom;
+#else
+  (void)log;
+#endif
+}
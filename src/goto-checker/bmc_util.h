@@ -169,6 +169,12 @@ void run_property_decider(
   std::chrono::duration<double> solver_runtime,
   bool set_pass = true);
 
+/// Returns the memory of irep nodes that are no longer in use to the system
+/// and outputs the allocation counters of the irep node pool. Has no effect
+/// unless built with IREP_NODE_POOL.
+/// \param log: For outputting statistics
+void release_irep_node_pool(messaget &log);
+
 #define OPT_BMC                                                                \
   "(program-only)"                                                             \
   "(show-byte-ops)"                                                            \
@@ -182,6 +188,7 @@ void run_property_decider(
   "(partial-loops)"                                                            \
   "(paths):"                                                                   \
   "(show-symex-strategies)"                                                    \
+  "(paths-in-memory):"                                                         \
   "(depth):"                                                                   \
   "(max-field-sensitivity-array-size):"                                        \
   "(no-array-field-sensitivity)"                                               \
@@ -197,6 +204,8 @@ void run_property_decider(
 #define HELP_BMC                                                               \
   " {y--paths} [strategy] \t explore paths one at a time\n"                    \
   " {y--show-symex-strategies} \t list strategies for use with {y--paths}\n"   \
+  " {y--paths-in-memory} {un} \t keep at most {un} paths in memory with "      \
+  "{y--paths} {ycoverage} or {ycost}, re-creating the others when needed\n"    \
   " {y--show-goto-symex-steps} \t show which steps symex travels, includes "   \
   "diagnostic information\n"                                                   \
   " {y--show-points-to-sets} \t show points-to sets for pointer dereference. " \
@@ -94,6 +94,10 @@ operator()(boolbvt &boolbv, const symex_target_equationt &equation)
 
   failed = get_failed_property(boolbv, equation);
 
+  // The constraints below only hold while beautifying, which leaves the
+  // solver, with the clauses it has learnt, usable for further queries.
+  boolbv.push();
+
   // lock the failed assertion
   boolbv.set_to(failed->cond_handle, false);
 
@@ -145,4 +149,7 @@ operator()(boolbvt &boolbv, const symex_target_equationt &equation)
     bv_minimizet bv_minimize(boolbv, log.get_message_handler());
     bv_minimize(minimization_list);
   }
+
+  // the satisfying assignment remains available
+  boolbv.pop();
 }
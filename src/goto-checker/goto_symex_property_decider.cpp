@@ -21,7 +21,17 @@ goto_symex_property_decidert::goto_symex_property_decidert(
   ui_message_handlert &ui_message_handler,
   symex_target_equationt &equation,
   const namespacet &ns)
-  : options(options), ui_message_handler(ui_message_handler), equation(equation)
+  : options(options),
+    ui_message_handler(ui_message_handler),
+    equation(equation),
+    // Incremental SMT2 and string refinement ignore the assumption passed
+    // to the solver, and DIMACS output does not contain it.
+    use_assumptions(
+      !options.get_bool_option("dimacs") &&
+      !options.get_bool_option("refine-strings") &&
+      options.get_option("incremental-smt2-solver").empty() &&
+      !options.is_set("incremental-smt2-api")),
+    goals_assumption(nil_exprt())
 {
   solver_factoryt solvers(
     options,
@@ -98,7 +108,13 @@ void goto_symex_property_decidert::add_constraint_from_goals(
 
   // this is 'false' if there are no disjuncts
   exprt goal_disjunction = disjunction(disjuncts);
-  decision_procedure.set_to_true(goal_disjunction);
+
+  // Solving under an assumption rather than a constraint keeps the formula
+  // valid, and the learnt clauses useful, for later rounds.
+  if(use_assumptions)
+    goals_assumption = std::move(goal_disjunction);
+  else
+    decision_procedure.set_to_true(goal_disjunction);
 
   with_solver_hardness(decision_procedure, [](solver_hardnesst &hardness) {
     // SSA expr and involved steps have already been collected
@@ -111,7 +127,7 @@ void goto_symex_property_decidert::add_constraint_from_goals(
 
 decision_proceduret::resultt goto_symex_property_decidert::solve()
 {
-  return solver->decision_procedure()();
+  return solver->decision_procedure()(goals_assumption);
 }
 
 stack_decision_proceduret &
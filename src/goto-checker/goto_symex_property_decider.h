@@ -37,11 +37,12 @@ class goto_symex_property_decidert
   /// Convert the instances of a property into a goal variable
   void convert_goals();
 
-  /// Add disjunction of negated selected properties to the equation
+  /// Add disjunction of negated selected properties to the equation, as an
+  /// assumption for the next call to solve() where the solver supports it
   void add_constraint_from_goals(
     std::function<bool(const irep_idt &property_id)> select_property);
 
-  /// Calls solve() on the solver instance
+  /// Calls solve() on the solver instance, under the goals assumption
   decision_proceduret::resultt solve();
 
   /// Returns the solver instance
@@ -71,6 +72,13 @@ class goto_symex_property_decidert
   symex_target_equationt &equation;
   std::unique_ptr<solver_factoryt::solvert> solver;
 
+  /// Whether the goals are passed as an assumption to the solver instead of
+  /// being added as a constraint
+  const bool use_assumptions;
+
+  /// Disjunction of the selected goals, nil if not \ref use_assumptions
+  exprt goals_assumption;
+
   struct goalt
   {
     /// A property holds if all instances of it are true
@@ -13,6 +13,8 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <util/ui_message.h>
 
+#include "verification_cache.h"
+
 goto_verifiert::goto_verifiert(
   const optionst &_options,
   ui_message_handlert &ui_message_handler)
@@ -21,3 +23,8 @@ goto_verifiert::goto_verifiert(
     log(ui_message_handler)
 {
 }
+
+std::size_t goto_verifiert::use_cache(const verification_cachet &cache)
+{
+  return cache.apply(properties);
+}
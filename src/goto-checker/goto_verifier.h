@@ -18,6 +18,7 @@ Author: Daniel Kroening, Peter Schrammel
 
 class optionst;
 class ui_message_handlert;
+class verification_cachet;
 
 /// An implementation of `goto_verifiert` checks all properties in
 /// a goto model. It typically uses, but doesn't have to use, an
@@ -47,6 +48,11 @@ class goto_verifiert
     return properties;
   }
 
+  /// Takes the status of the properties that hold according to \p cache
+  /// from the cache, such that they are not checked again
+  /// \return the number of these properties
+  std::size_t use_cache(const verification_cachet &cache);
+
 protected:
   goto_verifiert(const optionst &, ui_message_handlert &);
 
@@ -87,6 +87,7 @@ void multi_path_symex_only_checkert::generate_equation()
     std::chrono::duration<double>(symex_stop - symex_start);
   log.statistics() << "Runtime Symex: " << symex_runtime.count() << "s"
                    << messaget::eom;
+  release_irep_node_pool(log);
 
   postprocess_equation(symex, equation, options, ns, ui_message_handler);
 }
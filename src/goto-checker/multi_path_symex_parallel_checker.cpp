@@ -0,0 +1,314 @@
+/*******************************************************************\
+
+Module: Goto Checker using Multi-Path Symbolic Execution
+        with Parallel Property Decision
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Multi-Path Symbolic Execution with properties decided
+/// by a pool of worker processes
+
+#include "multi_path_symex_parallel_checker.h"
+
+#include <util/message.h>
+#include <util/options.h>
+#include <util/signal_catcher.h>
+#include <util/ui_message.h>
+
+#include <goto-symex/slice.h>
+
+#include "bmc_util.h"
+
+#ifndef _WIN32
+#  include <sys/wait.h>
+
+#  include <cerrno>
+#  include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+multi_path_symex_parallel_checkert::multi_path_symex_parallel_checkert(
+  const optionst &options,
+  ui_message_handlert &ui_message_handler,
+  abstract_goto_modelt &goto_model)
+  : multi_path_symex_checkert(options, ui_message_handler, goto_model),
+    number_of_workers(options.get_unsigned_int_option("parallel-properties"))
+{
+  if(number_of_workers == 0)
+    number_of_workers = std::max(1u, std::thread::hardware_concurrency());
+}
+
+incremental_goto_checkert::resultt multi_path_symex_parallel_checkert::
+operator()(propertiest &properties)
+{
+  if(equation_generated)
+    return multi_path_symex_checkert::operator()(properties);
+
+  resultt result(resultt::progresst::DONE);
+
+  generate_equation();
+
+  output_coverage_report(
+    options.get_option("symex-coverage-report"),
+    goto_model,
+    symex,
+    ui_message_handler);
+
+  update_properties(properties, result.updated_properties);
+
+  // Have we got anything to check? Otherwise we return DONE.
+  if(!has_properties_to_check(properties))
+    return result;
+
+  decide_properties_in_workers(properties, result.updated_properties);
+
+  // Whatever the workers left undecided, or failing properties that
+  // we need a model for, are decided sequentially in this process.
+  if(!has_properties_to_check(properties))
+  {
+    equation_generated = true;
+    return result;
+  }
+
+  std::chrono::duration<double> solver_runtime =
+    prepare_property_decider(properties);
+
+  equation_generated = true;
+
+  run_property_decider(result, properties, solver_runtime);
+
+  return result;
+}
+
+#ifdef _WIN32
+
+void multi_path_symex_parallel_checkert::decide_properties_in_workers(
+  propertiest &,
+  std::unordered_set<irep_idt> &)
+{
+  log.warning() << "parallel property checking is not supported on this "
+                << "platform, deciding properties sequentially"
+                << messaget::eom;
+}
+
+#else
+
+void multi_path_symex_parallel_checkert::decide_properties_in_workers(
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  // properties are processed in the (deterministic) order of the map
+  std::vector<irep_idt> to_check;
+  for(const auto &property_pair : properties)
+  {
+    if(is_property_to_check(property_pair.second.status))
+      to_check.push_back(property_pair.first);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  log.status() << "Deciding " << to_check.size() << " properties using "
+               << number_of_workers << " worker processes" << messaget::eom;
+
+  // traces are built from a model in this process, hence properties that
+  // fail need to be decided again here
+  const bool decide_failing_locally = options.get_bool_option("trace");
+
+  struct workert
+  {
+    std::size_t index;
+    int result_fd;
+  };
+  std::map<pid_t, workert> running;
+  std::vector<property_statust> worker_results(
+    to_check.size(), property_statust::UNKNOWN);
+  std::size_t next = 0, failed_workers = 0;
+
+  while(next < to_check.size() || !running.empty())
+  {
+    // start workers while there are free slots
+    while(next < to_check.size() && running.size() < number_of_workers)
+    {
+      const std::size_t index = next++;
+      const irep_idt &property_id = to_check[index];
+
+      int fds[2];
+      if(pipe(fds) != 0)
+      {
+        ++failed_workers;
+        continue;
+      }
+
+      // make sure buffered output isn't duplicated by the worker
+      std::cout.flush();
+
+      const pid_t pid = fork();
+
+      if(pid == 0)
+      {
+        // worker process: never return into the caller
+        remove_signal_catcher();
+        close(fds[0]);
+
+        property_statust status = property_statust::ERROR;
+        try
+        {
+          status =
+            decide_property_in_worker(property_id, properties.at(property_id));
+        }
+        catch(...)
+        {
+          // reported as ERROR, the parent decides the property again
+        }
+
+        const ssize_t written = write(fds[1], &status, sizeof(status));
+        close(fds[1]);
+        _exit(written == sizeof(status) ? 0 : 1);
+      }
+
+      close(fds[1]);
+
+      if(pid < 0)
+      {
+        close(fds[0]);
+        ++failed_workers;
+        continue;
+      }
+
+      running.emplace(pid, workert{index, fds[0]});
+    }
+
+    if(running.empty())
+      break;
+
+    // wait for any worker to finish
+    int wait_status;
+    const pid_t pid = waitpid(-1, &wait_status, 0);
+    if(pid == -1)
+    {
+      if(errno == EINTR)
+        continue;
+      break;
+    }
+
+    auto worker_it = running.find(pid);
+    if(worker_it == running.end())
+      continue;
+
+    const workert &worker = worker_it->second;
+    property_statust status;
+    if(
+      WIFEXITED(wait_status) && WEXITSTATUS(wait_status) == 0 &&
+      read(worker.result_fd, &status, sizeof(status)) == sizeof(status) &&
+      status != property_statust::ERROR)
+    {
+      worker_results[worker.index] = status;
+    }
+    else
+      ++failed_workers;
+
+    close(worker.result_fd);
+    running.erase(worker_it);
+  }
+
+  // clean up after an unexpected waitpid failure
+  for(const auto &worker_pair : running)
+  {
+    kill(worker_pair.first, SIGKILL);
+    waitpid(worker_pair.first, nullptr, 0);
+    close(worker_pair.second.result_fd);
+    ++failed_workers;
+  }
+
+  std::size_t decided = 0;
+  for(std::size_t i = 0; i < to_check.size(); ++i)
+  {
+    const property_statust status = worker_results[i];
+    if(
+      status == property_statust::UNKNOWN ||
+      (status == property_statust::FAIL && decide_failing_locally))
+    {
+      continue;
+    }
+
+    properties.at(to_check[i]).status |= status;
+    updated_properties.insert(to_check[i]);
+    ++decided;
+  }
+
+  const auto stop = std::chrono::steady_clock::now();
+  log.statistics() << "Runtime parallel property decision: "
+                   << std::chrono::duration<double>(stop - start).count()
+                   << "s" << messaget::eom;
+  log.statistics() << "Properties decided by workers: " << decided << " of "
+                   << to_check.size() << messaget::eom;
+  if(failed_workers > 0)
+  {
+    log.warning() << failed_workers << " worker processes did not return "
+                  << "a result, deciding their properties sequentially"
+                  << messaget::eom;
+  }
+}
+
+#endif
+
+property_statust multi_path_symex_parallel_checkert::decide_property_in_worker(
+  const irep_idt &property_id,
+  const property_infot &property_info)
+{
+  // Workers must not write to the output of the parent.
+  null_message_handlert null_message_handler;
+  ui_message_handlert worker_message_handler(null_message_handler);
+
+  // Restrict the equation to the instances of the property at hand:
+  // anything after its last instance and all other assertions are ignored,
+  // then the equation is sliced with respect to the remaining assertions.
+  auto last_instance = equation.SSA_steps.end();
+  for(auto it = equation.SSA_steps.begin(); it != equation.SSA_steps.end();
+      ++it)
+  {
+    if(it->is_assert())
+    {
+      if(it->property_id == property_id)
+        last_instance = it;
+      else
+        it->ignore = true;
+    }
+  }
+
+  if(last_instance == equation.SSA_steps.end())
+    return property_statust::PASS;
+
+  for(auto it = std::next(last_instance); it != equation.SSA_steps.end(); ++it)
+    it->ignore = true;
+
+  slice(equation);
+
+  propertiest worker_properties;
+  worker_properties.emplace(property_id, property_info);
+
+  goto_symex_property_decidert worker_property_decider(
+    options, worker_message_handler, equation, ns);
+
+  std::chrono::duration<double> solver_runtime = ::prepare_property_decider(
+    worker_properties,
+    equation,
+    worker_property_decider,
+    worker_message_handler);
+
+  resultt result(resultt::progresst::DONE);
+  ::run_property_decider(
+    result,
+    worker_properties,
+    worker_property_decider,
+    worker_message_handler,
+    solver_runtime);
+
+  return worker_properties.at(property_id).status;
+}
@@ -0,0 +1,62 @@
+/*******************************************************************\
+
+Module: Goto Checker using Multi-Path Symbolic Execution
+        with Parallel Property Decision
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Multi-Path Symbolic Execution with properties decided
+/// by a pool of worker processes
+
+#ifndef CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_CHECKER_H
+#define CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_CHECKER_H
+
+#include "multi_path_symex_checker.h"
+
+/// Performs a multi-path symbolic execution using goto-symex once and then
+/// decides the properties in parallel: each property is handed to a worker
+/// that slices the equation with respect to that property and solves it with
+/// its own solver instance obtained from \ref solver_factoryt.
+///
+/// Workers are forked processes, which gives each of them a private
+/// copy-on-write view of the equation without requiring the expression
+/// representation to be thread-safe. At most `--parallel-properties` workers
+/// run at the same time. Properties that workers find to fail are decided
+/// again in this process if traces are requested, so that
+/// \ref goto_trace_providert can build traces from a model as usual.
+/// Properties whose worker did not return a result are decided in this
+/// process, too. On platforms without `fork` all properties are decided in
+/// this process as done by \ref multi_path_symex_checkert.
+class multi_path_symex_parallel_checkert : public multi_path_symex_checkert
+{
+public:
+  multi_path_symex_parallel_checkert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model);
+
+  /// \copydoc multi_path_symex_checkert::operator()(propertiest &properties)
+  resultt operator()(propertiest &) override;
+
+protected:
+  /// Maximum number of worker processes running concurrently
+  std::size_t number_of_workers;
+
+  /// Decide all properties to check in \p properties using the worker pool.
+  /// Properties that have been decided are added to \p updated_properties.
+  void decide_properties_in_workers(
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties);
+
+  /// Decide the single property \p property_id in the calling (worker)
+  /// process, reusing the equation generated by symex.
+  /// \return the status of the property
+  property_statust decide_property_in_worker(
+    const irep_idt &property_id,
+    const property_infot &property_info);
+};
+
+#endif // CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_CHECKER_H
@@ -11,17 +11,28 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "single_path_symex_checker.h"
 
+#include <util/buffered_message_handler.h>
+#include <util/parallel_for.h>
 #include <util/ui_message.h>
 
 #include "bmc_util.h"
 #include "counterexample_beautification.h"
 #include "symex_bmc.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 single_path_symex_checkert::single_path_symex_checkert(
   const optionst &options,
   ui_message_handlert &ui_message_handler,
   abstract_goto_modelt &goto_model)
-  : single_path_symex_only_checkert(options, ui_message_handler, goto_model)
+  : single_path_symex_only_checkert(options, ui_message_handler, goto_model),
+    number_of_threads(
+      options.is_set("parallel-paths")
+        ? options.get_unsigned_int_option("parallel-paths")
+        : 1)
 {
 }
 
@@ -40,6 +51,12 @@ operator()(propertiest &properties)
       return result;
   }
 
+  if(explored_in_parallel)
+  {
+    decide_replayed_paths(properties, result);
+    return result;
+  }
+
   if(!worklist->empty())
   {
     // We pop the item processed in the previous iteration.
@@ -51,6 +68,14 @@ operator()(propertiest &properties)
     symex_initialized = true;
 
     initialize_worklist();
+
+    if(use_parallel_exploration())
+    {
+      explore_paths_in_parallel(properties);
+      explored_in_parallel = true;
+      decide_replayed_paths(properties, result);
+      return result;
+    }
   }
 
   while(!has_finished_exploration(properties))
@@ -84,6 +109,7 @@ operator()(propertiest &properties)
 
   log.statistics() << "Runtime Symex: " << symex_runtime.count() << "s"
                    << messaget::eom;
+  release_irep_node_pool(log);
 
   final_update_properties(properties, result.updated_properties);
 
@@ -91,6 +117,416 @@ operator()(propertiest &properties)
   return result;
 }
 
+/// Returns whether the path that took the branches \p a is resumed before the
+/// path that took \p b with `--paths lifo`, which explores paths depth-first
+/// and resumes the jump target of a GOTO before its next instruction.
+static bool
+path_precedes(const std::vector<bool> &a, const std::vector<bool> &b)
+{
+  return std::lexicographical_compare(
+    a.begin(), a.end(), b.begin(), b.end(), [](bool x, bool y) {
+      return x && !y;
+    });
+}
+
+bool single_path_symex_checkert::use_parallel_exploration()
+{
+  if(effective_number_of_threads(number_of_threads) <= 1)
+    return false;
+
+#if !IREP_ATOMIC_REF_COUNT
+  log.warning() << "exploring paths in parallel requires a build with "
+                << "IREP_ATOMIC_REF_COUNT, using a single thread"
+                << messaget::eom;
+  return false;
+#elif defined(BDD_GUARDS)
+  log.warning() << "exploring paths in parallel is not supported with "
+                << "BDD_GUARDS, using a single thread" << messaget::eom;
+  return false;
+#else
+  if(
+    options.get_bool_option("symex-driven-lazy-loading") ||
+    options.get_bool_option("show-vcc") ||
+    options.get_bool_option("program-only") ||
+    options.get_bool_option("show-byte-ops") ||
+    !options.get_option("symex-coverage-report").empty() ||
+    options.get_bool_option("dimacs") || options.is_set("outfile") ||
+    options.is_set("write-solver-stats-to"))
+  {
+    log.warning() << "exploring paths in parallel is not supported with "
+                  << "options that output each path or formula, using a "
+                  << "single thread" << messaget::eom;
+    return false;
+  }
+
+  return true;
+#endif
+}
+
+void single_path_symex_checkert::explore_paths_in_parallel(
+  const propertiest &properties)
+{
+  const std::size_t threads = effective_number_of_threads(number_of_threads);
+  const bool lifo = options.get_option("exploration-strategy") != "fifo";
+  const bool stop_on_fail = options.get_bool_option("stop-on-fail") &&
+                            !options.get_bool_option("paths-symex-explore-all");
+
+  struct workert
+  {
+    workert(
+      bool lifo,
+      message_handlert &message_handler,
+      abstract_goto_modelt &goto_model)
+      : paths(lifo),
+        message_handler(message_handler),
+        ui_message_handler(this->message_handler),
+        unwindset(goto_model),
+        ns(goto_model.get_symbol_table(), symbol_table)
+    {
+      // Only warnings and errors are passed on, as the paths that a thread
+      // resumes depend on scheduling.
+      ui_message_handler.set_verbosity(std::min(
+        message_handler.get_verbosity(), (unsigned)messaget::M_WARNING));
+    }
+
+    path_work_stealing_dequet paths;
+    buffered_message_handlert message_handler;
+    ui_message_handlert ui_message_handler;
+    unwindsett unwindset;
+    symbol_tablet symbol_table;
+    namespacet ns;
+    std::chrono::duration<double> symex_runtime{0};
+    std::size_t resumed_paths = 0;
+    std::size_t stolen_paths = 0;
+  };
+
+  std::vector<std::unique_ptr<workert>> workers;
+  for(std::size_t i = 0; i < threads; ++i)
+  {
+    workers.push_back(
+      std::make_unique<workert>(lifo, ui_message_handler, goto_model));
+    // the initial state takes its L2 indices from the worklist
+    workers.back()->paths.share_unique_names_with(*worklist);
+  }
+
+  workers.front()->paths.push(worklist->peek());
+
+  // first path on which each property fails, and on which the solver reports
+  // an error, guarded by `results_mutex`
+  std::mutex results_mutex;
+  std::map<irep_idt, std::vector<bool>> first_failures;
+  std::optional<std::vector<bool>> first_failure;
+  std::optional<std::vector<bool>> first_error;
+
+  // paths that have been saved, but not yet been finished
+  std::atomic<std::size_t> pending_paths(1);
+  std::atomic<bool> aborted(false);
+  std::mutex idle_mutex;
+  std::condition_variable idle;
+
+  const auto next_path =
+    [&](std::size_t index, std::list<path_storaget::patht> &dest) {
+      while(!aborted)
+      {
+        if(workers[index]->paths.take(dest))
+          return true;
+
+        for(std::size_t i = 1; i < workers.size(); ++i)
+        {
+          if(workers[(index + i) % workers.size()]->paths.steal(dest))
+          {
+            ++workers[index]->stolen_paths;
+            return true;
+          }
+        }
+
+        if(pending_paths == 0)
+          return false;
+
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle.wait_for(lock, std::chrono::milliseconds(1));
+      }
+
+      return false;
+    };
+
+  const auto resume = [&](workert &worker, path_storaget::patht &path) {
+    const auto symex_start = std::chrono::steady_clock::now();
+
+    symex_bmct symex(
+      worker.ui_message_handler,
+      goto_model.get_symbol_table(),
+      path.equation,
+      options,
+      worker.paths,
+      guard_manager,
+      worker.unwindset);
+    ::setup_symex(symex, worker.ns, options, worker.ui_message_handler);
+
+    // the path may have been saved by another thread
+    path.state.dirty = &worker.paths.dirty;
+
+    worker.symbol_table = symex.resume_symex_from_saved_state(
+      goto_symext::get_goto_function(goto_model), path.state, &path.equation);
+
+    const auto symex_stop = std::chrono::steady_clock::now();
+    worker.symex_runtime +=
+      std::chrono::duration<double>(symex_stop - symex_start);
+    ++worker.resumed_paths;
+
+    postprocess_equation(
+      symex, path.equation, options, worker.ns, worker.ui_message_handler);
+
+    if(options.get_bool_option("validate-ssa-equation"))
+      symex.validate(validation_modet::INVARIANT);
+
+    return is_ready_to_decide(symex, path);
+  };
+
+  const auto decide = [&](workert &worker, path_storaget::patht &path) {
+    const std::vector<bool> &branches = path.state.saved_branches;
+
+    propertiest path_properties = properties;
+    std::unordered_set<irep_idt> updated_properties;
+    update_properties_status_from_symex_target_equation(
+      path_properties, updated_properties, path.equation);
+
+    {
+      // Properties need not be checked on this path if they already fail on
+      // an earlier one.
+      std::lock_guard<std::mutex> lock(results_mutex);
+      for(auto &property_pair : path_properties)
+      {
+        if(first_error && path_precedes(*first_error, branches))
+          property_pair.second.status = property_statust::ERROR;
+        const auto failure = first_failures.find(property_pair.first);
+        if(
+          failure != first_failures.end() &&
+          path_precedes(failure->second, branches))
+        {
+          property_pair.second.status = property_statust::FAIL;
+        }
+      }
+    }
+
+    // properties that do not occur on this path are still NOT_CHECKED
+    if(std::none_of(
+         path_properties.begin(),
+         path_properties.end(),
+         [](const propertiest::value_type &property_pair) {
+           return property_pair.second.status == property_statust::UNKNOWN;
+         }))
+    {
+      return;
+    }
+
+    goto_symex_property_decidert path_property_decider(
+      options, worker.ui_message_handler, path.equation, worker.ns);
+    auto solver_runtime = ::prepare_property_decider(
+      path_properties,
+      path.equation,
+      path_property_decider,
+      worker.ui_message_handler);
+
+    while(true)
+    {
+      resultt path_result(resultt::progresst::DONE);
+      ::run_property_decider(
+        path_result,
+        path_properties,
+        path_property_decider,
+        worker.ui_message_handler,
+        solver_runtime,
+        false);
+      solver_runtime = std::chrono::duration<double>(0);
+
+      std::lock_guard<std::mutex> lock(results_mutex);
+      for(const auto &property_id : path_result.updated_properties)
+      {
+        const property_statust status = path_properties.at(property_id).status;
+        if(status == property_statust::FAIL)
+        {
+          auto entry = first_failures.emplace(property_id, branches);
+          if(!entry.second && path_precedes(branches, entry.first->second))
+            entry.first->second = branches;
+          if(!first_failure || path_precedes(branches, *first_failure))
+            first_failure = branches;
+        }
+        else if(status == property_statust::ERROR)
+        {
+          if(!first_error || path_precedes(branches, *first_error))
+            first_error = branches;
+        }
+      }
+
+      if(
+        path_result.progress != resultt::progresst::FOUND_FAIL ||
+        stop_on_fail)
+      {
+        break;
+      }
+    }
+  };
+
+  const auto is_pruned = [&](const std::vector<bool> &branches) {
+    // Paths that continue a path are resumed after it in depth-first order,
+    // hence once a property fails, stop-on-fail does not need any path
+    // resumed after the failing one.
+    if(!stop_on_fail)
+      return false;
+    std::lock_guard<std::mutex> lock(results_mutex);
+    return first_failure && path_precedes(*first_failure, branches);
+  };
+
+  parallel_for(threads, threads, [&](std::size_t, std::size_t index) {
+    workert &worker = *workers[index];
+
+    try
+    {
+      // Symex looks up these analyses in the path storage that it saves paths
+      // to, while the call stack of a path may have been built by another
+      // thread.
+      for(const auto &function_pair :
+          goto_model.get_goto_functions().function_map)
+      {
+        if(!function_pair.second.body_available())
+          continue;
+        worker.paths.dirty.populate_dirty_for_function(
+          function_pair.first, function_pair.second);
+        auto emplace_result = worker.paths.safe_pointers.emplace(
+          function_pair.first, local_safe_pointerst{});
+        if(emplace_result.second)
+          emplace_result.first->second(function_pair.second.body);
+      }
+
+      std::list<path_storaget::patht> current;
+      while(next_path(index, current))
+      {
+        path_storaget::patht &path = current.front();
+
+        if(!is_pruned(path.state.saved_branches))
+        {
+          const std::size_t pushes = worker.paths.number_of_pushes();
+          const bool ready_to_decide = resume(worker, path);
+          const std::size_t new_paths =
+            worker.paths.number_of_pushes() - pushes;
+          if(new_paths > 0)
+          {
+            pending_paths += new_paths;
+            idle.notify_all();
+          }
+
+          if(ready_to_decide)
+            decide(worker, path);
+        }
+
+        current.clear();
+        if(--pending_paths == 0)
+          idle.notify_all();
+      }
+    }
+    catch(...)
+    {
+      aborted = true;
+      idle.notify_all();
+      throw;
+    }
+  });
+
+  std::size_t resumed_paths = 0;
+  std::size_t stolen_paths = 0;
+  for(auto &worker : workers)
+  {
+    worker->message_handler.replay();
+    symex_runtime += worker->symex_runtime;
+    resumed_paths += worker->resumed_paths;
+    stolen_paths += worker->stolen_paths;
+  }
+
+  log.statistics() << "Explored " << resumed_paths << " paths using "
+                   << threads << " threads, " << stolen_paths
+                   << " of them were stolen" << messaget::eom;
+
+  // An error stops checking the properties that have not failed yet, hence
+  // later failures are not reported.
+  error_path = first_error;
+  for(const auto &failure : first_failures)
+  {
+    if(!first_error || !path_precedes(*first_error, failure.second))
+      paths_to_replay.push_back(failure.second);
+  }
+  if(first_error)
+    paths_to_replay.push_back(*first_error);
+
+  std::sort(paths_to_replay.begin(), paths_to_replay.end(), path_precedes);
+  paths_to_replay.erase(
+    std::unique(paths_to_replay.begin(), paths_to_replay.end()),
+    paths_to_replay.end());
+
+  log.status() << "Deciding " << paths_to_replay.size()
+               << " path(s) again to report failures" << messaget::eom;
+}
+
+path_storaget::patht &
+single_path_symex_checkert::replay_path(const std::vector<bool> &branches)
+{
+  // A fresh path storage makes the names that symex generates independent of
+  // the scheduling of the threads.
+  replay_storage = std::make_unique<path_lifot>();
+
+  path_storaget::patht &path = follow_saved_branches(branches, *replay_storage);
+  const bool ready_to_decide = resume_path(path, *replay_storage);
+  INVARIANT(ready_to_decide, "replayed path must be ready to be decided");
+  return path;
+}
+
+void single_path_symex_checkert::decide_replayed_paths(
+  propertiest &properties,
+  resultt &result)
+{
+  while(next_path_to_replay < paths_to_replay.size())
+  {
+    const std::vector<bool> &branches = paths_to_replay[next_path_to_replay];
+    ++next_path_to_replay;
+
+    property_decider.reset();
+    path_storaget::patht &path = replay_path(branches);
+
+    update_properties(properties, result.updated_properties, path.equation);
+
+    property_decider = std::make_unique<goto_symex_property_decidert>(
+      options, ui_message_handler, path.equation, ns);
+
+    const auto solver_runtime =
+      prepare_property_decider(properties, path.equation, *property_decider);
+
+    run_property_decider(result, properties, *property_decider, solver_runtime);
+
+    if(error_path == branches)
+    {
+      // as on the threads, properties that have not failed yet are not
+      // checked on any further paths
+      for(auto &property_pair : properties)
+      {
+        if(is_property_to_check(property_pair.second.status))
+        {
+          property_pair.second.status = property_statust::ERROR;
+          result.updated_properties.insert(property_pair.first);
+        }
+      }
+    }
+
+    if(result.progress == resultt::progresst::FOUND_FAIL)
+      return;
+  }
+
+  log.statistics() << "Runtime Symex: " << symex_runtime.count() << "s"
+                   << messaget::eom;
+  release_irep_node_pool(log);
+
+  final_update_properties(properties, result.updated_properties);
+}
+
 bool single_path_symex_checkert::is_ready_to_decide(
   const symex_bmct &symex,
   const path_storaget::patht &)
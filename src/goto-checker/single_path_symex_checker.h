@@ -17,8 +17,20 @@ Author: Daniel Kroening, Peter Schrammel
 #include "single_path_symex_only_checker.h"
 #include "witness_provider.h"
 
+#include <optional>
+
 /// Uses goto-symex to symbolically execute each path in the
 /// goto model and calls a solver to find property violations.
+///
+/// With option `parallel-paths`, paths are resumed by several threads, each
+/// with its own solver; threads that have run out of paths steal paths from
+/// the others. Every path is then explored, unless `stop-on-fail` is set.
+/// For each property, the first path on which it fails in the order of
+/// `--paths lifo` is recorded, and these paths are then symbolically executed
+/// and decided again on the calling thread to report results and traces.
+/// The results thus do not depend on the scheduling of the threads. Paths
+/// are resumed using \ref ::setup_symex, i.e., without calling
+/// \ref setup_symex.
 class single_path_symex_checkert : public single_path_symex_only_checkert,
                                    public witness_providert,
                                    public goto_trace_providert
@@ -45,6 +57,42 @@ class single_path_symex_checkert : public single_path_symex_only_checkert,
   bool symex_initialized = false;
   std::unique_ptr<goto_symex_property_decidert> property_decider;
 
+  /// Number of threads to explore paths with, 0 meaning one per core
+  std::size_t number_of_threads;
+
+  /// Whether paths have been explored by several threads, after which
+  /// \ref paths_to_replay are decided again by \ref decide_replayed_paths
+  bool explored_in_parallel = false;
+
+  /// Paths, identified by `goto_symex_statet::saved_branches`, on which
+  /// properties fail for the first time or the solver reports an error, in
+  /// the order of exploring paths depth-first
+  std::vector<std::vector<bool>> paths_to_replay;
+  std::size_t next_path_to_replay = 0;
+
+  /// The first path on which the solver reported an error, if any
+  std::optional<std::vector<bool>> error_path;
+
+  /// Holds the path that has been replayed last
+  std::unique_ptr<path_storaget> replay_storage;
+
+  /// Returns whether paths can be explored by several threads
+  bool use_parallel_exploration();
+
+  /// Explores all paths, starting from the one in the worklist, using
+  /// \ref number_of_threads threads, and records \ref paths_to_replay.
+  /// The \p properties are not modified.
+  void explore_paths_in_parallel(const propertiest &properties);
+
+  /// Symbolically executes the path that took the \p branches again, starting
+  /// from the entry point, and decides it after the last of these branches
+  /// \return the path, which is held by \ref replay_storage
+  path_storaget::patht &replay_path(const std::vector<bool> &branches);
+
+  /// Replays and decides the remaining \ref paths_to_replay until a property
+  /// fails, and updates \p properties and \p result accordingly
+  void decide_replayed_paths(propertiest &properties, resultt &result);
+
   bool
   is_ready_to_decide(const symex_bmct &, const path_storaget::patht &) override;
 
@@ -28,7 +28,8 @@ single_path_symex_only_checkert::single_path_symex_only_checkert(
   : incremental_goto_checkert(options, ui_message_handler),
     goto_model(goto_model),
     ns(goto_model.get_symbol_table(), symex_symbol_table),
-    worklist(get_path_strategy(options.get_option("exploration-strategy"))),
+    worklist(
+      get_path_strategy(options.get_option("exploration-strategy"), options)),
     symex_runtime(0),
     unwindset(goto_model)
 {
@@ -54,6 +55,7 @@ operator()(propertiest &properties)
 
   log.statistics() << "Runtime Symex: " << symex_runtime.count() << "s"
                    << messaget::eom;
+  release_irep_node_pool(log);
 
   final_update_properties(properties, result.updated_properties);
 
@@ -62,14 +64,24 @@ operator()(propertiest &properties)
 
 void single_path_symex_only_checkert::initialize_worklist()
 {
-  // Put initial state into the work list
+  initialize_path_storage(*worklist);
+
+  worklist->recreate_path = [this](const std::vector<bool> &branches) {
+    return recreate_saved_path(branches);
+  };
+}
+
+void single_path_symex_only_checkert::initialize_path_storage(
+  path_storaget &path_storage)
+{
+  // Put initial state into the path storage
   symex_target_equationt equation(ui_message_handler);
   symex_bmct symex(
     ui_message_handler,
     goto_model.get_symbol_table(),
     equation,
     options,
-    *worklist,
+    path_storage,
     guard_manager,
     unwindset);
   setup_symex(symex);
@@ -82,6 +94,83 @@ void single_path_symex_only_checkert::initialize_worklist()
     goto_symext::get_goto_function(goto_model), symex_symbol_table, fields);
 }
 
+path_storaget::patht &
+single_path_symex_only_checkert::follow_saved_branches(
+  const std::vector<bool> &branches,
+  path_storaget &path_storage)
+{
+  initialize_path_storage(path_storage);
+
+  while(true)
+  {
+    path_storaget::patht &path = path_storage.peek();
+    const std::size_t depth = path.state.saved_branches.size();
+
+    if(depth == branches.size())
+    {
+      INVARIANT(
+        path.state.saved_branches == branches,
+        "re-created path must have taken the same branches");
+      return path;
+    }
+
+    const auto symex_start = std::chrono::steady_clock::now();
+
+    // Only the path that took all branches is post-processed, once it is
+    // resumed.
+    symex_bmct symex(
+      ui_message_handler,
+      goto_model.get_symbol_table(),
+      path.equation,
+      options,
+      path_storage,
+      guard_manager,
+      unwindset);
+    setup_symex(symex);
+
+    symex_symbol_table = symex.resume_symex_from_saved_state(
+      goto_symext::get_goto_function(goto_model), path.state, &path.equation);
+
+    const auto symex_stop = std::chrono::steady_clock::now();
+    symex_runtime += std::chrono::duration<double>(symex_stop - symex_start);
+
+    path_storage.pop();
+    INVARIANT(
+      path_storage.size() == 2,
+      "symex saves both branches of a GOTO when exploring paths");
+
+    // path_lifot resumes the jump target first
+    if(!branches[depth])
+    {
+      path_storage.peek();
+      path_storage.pop();
+    }
+  }
+}
+
+std::unique_ptr<path_storaget::patht>
+single_path_symex_only_checkert::recreate_saved_path(
+  const std::vector<bool> &branches)
+{
+  log.debug() << "Re-creating path after " << branches.size() << " branches"
+              << messaget::eom;
+
+  if(!recreation_storage)
+  {
+    recreation_storage = std::make_unique<path_lifot>();
+    // the names must not clash with those of the paths in the worklist, which
+    // the re-created path will be resumed with
+    recreation_storage->share_unique_names_with(*worklist);
+  }
+
+  auto result = std::make_unique<path_storaget::patht>(
+    follow_saved_branches(branches, *recreation_storage));
+  result->state.dirty = &worklist->dirty;
+  recreation_storage->clear();
+
+  return result;
+}
+
 bool single_path_symex_only_checkert::has_finished_exploration(
   const propertiest &properties)
 {
@@ -91,6 +180,13 @@ bool single_path_symex_only_checkert::has_finished_exploration(
 }
 
 bool single_path_symex_only_checkert::resume_path(path_storaget::patht &path)
+{
+  return resume_path(path, *worklist);
+}
+
+bool single_path_symex_only_checkert::resume_path(
+  path_storaget::patht &path,
+  path_storaget &path_storage)
 {
   const auto symex_start = std::chrono::steady_clock::now();
 
@@ -99,7 +195,7 @@ bool single_path_symex_only_checkert::resume_path(path_storaget::patht &path)
     goto_model.get_symbol_table(),
     path.equation,
     options,
-    *worklist,
+    path_storage,
     guard_manager,
     unwindset);
   setup_symex(symex);
@@ -52,10 +52,36 @@ class single_path_symex_only_checkert : public incremental_goto_checkert
   /// Adds the initial goto-symex state as a path to the worklist
   virtual void initialize_worklist();
 
+  /// Adds the initial goto-symex state as a path to \p path_storage
+  void initialize_path_storage(path_storaget &path_storage);
+
+  /// Symbolically executes the program from its entry point again, taking
+  /// the \p branches at the GOTOs at which paths are saved, and saving paths
+  /// in \p path_storage, which must be an empty \ref path_lifot
+  /// \return the path, held by \p path_storage, that took all \p branches;
+  ///   it has not been resumed after the last of the branches yet
+  path_storaget::patht &follow_saved_branches(
+    const std::vector<bool> &branches,
+    path_storaget &path_storage);
+
+  /// Paths saved while re-creating paths of the \ref worklist
+  std::unique_ptr<path_storaget> recreation_storage;
+
+  /// Re-creates the path of the \ref worklist that took \p branches at the
+  /// GOTOs at which paths were saved by symbolically executing the program
+  /// from its entry point again
+  std::unique_ptr<path_storaget::patht>
+  recreate_saved_path(const std::vector<bool> &branches);
+
   /// Continues exploring the given \p path using goto-symex
   /// \return whether the path is ready to be checked
   virtual bool resume_path(path_storaget::patht &path);
 
+  /// Continues exploring the given \p path using goto-symex, saving any
+  /// paths to be resumed later in \p path_storage
+  /// \return whether the path is ready to be checked
+  bool resume_path(path_storaget::patht &path, path_storaget &path_storage);
+
   /// Returns whether the given \p path produced by \p symex is ready to be
   /// checked
   virtual bool
@@ -16,6 +16,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include <util/exit_codes.h>
 #include <util/message.h>
 #include <util/options.h>
+#include <util/string_utils.h>
 #include <util/unicode.h>
 #include <util/version.h>
 
@@ -27,10 +28,15 @@ Author: Daniel Kroening, Peter Schrammel
 #include <solvers/sat/dimacs_cnf.h>
 #include <solvers/sat/external_sat.h>
 #include <solvers/sat/satcheck.h>
+#include <solvers/sat/satcheck_portfolio.h>
 #include <solvers/smt2_incremental/smt2_incremental_decision_procedure.h>
 #include <solvers/smt2_incremental/smt_solver_process.h>
 #include <solvers/strings/string_refinement.h>
 
+#ifdef HAVE_Z3_API
+#  include <solvers/smt2_incremental/smt_z3_api_solver_process.h>
+#endif
+
 #include <iostream>
 
 solver_factoryt::solver_factoryt(
@@ -114,8 +120,12 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_solver()
     return get_string_refinement();
   const auto incremental_smt2_solver =
     options.get_option("incremental-smt2-solver");
-  if(!incremental_smt2_solver.empty())
+  if(
+    !incremental_smt2_solver.empty() ||
+    options.is_set("incremental-smt2-api"))
+  {
     return get_incremental_smt2(incremental_smt2_solver);
+  }
   if(options.get_bool_option("smt2"))
     return get_smt2(get_smt2_solver_type());
   return get_default();
@@ -199,14 +209,99 @@ make_satcheck_prop(message_handlert &message_handler, const optionst &options)
   return satcheck;
 }
 
+/// Build a portfolio of the comma-separated SAT solvers given in the
+/// "portfolio" option, which race on each query.
+/// \return nullptr if none of the solvers is available
+static std::unique_ptr<propt> make_satcheck_portfolio(
+  message_handlert &message_handler,
+  const optionst &options,
+  bool no_simplifier)
+{
+  messaget log(message_handler);
+  auto portfolio = std::make_unique<satcheck_portfoliot>(message_handler);
+
+  const std::vector<std::string> solvers =
+    split_string(options.get_option("portfolio"), ',', true, true);
+
+  for(const auto &solver : solvers)
+  {
+    bool available = false;
+
+    if(solver == "minisat2")
+    {
+#if defined SATCHECK_MINISAT2
+      if(no_simplifier)
+        portfolio->add_solver<satcheck_minisat_no_simplifiert>();
+      else
+        portfolio->add_solver<satcheck_minisat_simplifiert>();
+      available = true;
+#endif
+    }
+    else if(solver == "glucose")
+    {
+#if defined SATCHECK_GLUCOSE
+      if(no_simplifier)
+        portfolio->add_solver<satcheck_glucose_no_simplifiert>();
+      else
+        portfolio->add_solver<satcheck_glucose_simplifiert>();
+      available = true;
+#endif
+    }
+    else if(solver == "cadical")
+    {
+#if defined SATCHECK_CADICAL
+      portfolio->add_solver<satcheck_cadicalt>();
+      available = true;
+#endif
+    }
+    else
+    {
+      log.error() << "solver '" << solver
+                  << "' cannot be part of a portfolio, use minisat2, glucose "
+                  << "or cadical" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(!available)
+    {
+      log.warning() << "The specified solver, '" << solver
+                    << "', is not available and is left out of the portfolio."
+                    << messaget::eom;
+    }
+  }
+
+  if(portfolio->number_of_solvers() == 0)
+  {
+    emit_solver_warning(message_handler, "portfolio");
+    return nullptr;
+  }
+
+  if(options.is_set("write-solver-stats-to"))
+  {
+    log.warning()
+      << "Configured solver does not support --write-solver-stats-to. "
+      << "Solver stats will not be written." << messaget::eom;
+  }
+
+  return portfolio;
+}
+
 static std::unique_ptr<propt>
-get_sat_solver(message_handlert &message_handler, const optionst &options)
+make_sat_solver(message_handlert &message_handler, const optionst &options)
 {
   const bool no_simplifier = options.get_bool_option("beautify") ||
                              !options.get_bool_option("sat-preprocessor") ||
                              options.get_bool_option("refine-arithmetic") ||
                              options.get_bool_option("refine-strings");
 
+  if(options.is_set("portfolio"))
+  {
+    auto portfolio =
+      make_satcheck_portfolio(message_handler, options, no_simplifier);
+    if(portfolio != nullptr)
+      return portfolio;
+  }
+
   if(options.is_set("sat-solver"))
   {
     const std::string &solver_option = options.get_option("sat-solver");
@@ -324,6 +419,21 @@ get_sat_solver(message_handlert &message_handler, const optionst &options)
   }
 }
 
+static std::unique_ptr<propt>
+get_sat_solver(message_handlert &message_handler, const optionst &options)
+{
+  auto sat_solver = make_sat_solver(message_handler, options);
+
+  if(options.get_bool_option("structural-hashing"))
+  {
+    // all SAT solvers generate their CNF via cnft
+    if(auto cnf = dynamic_cast<cnft *>(sat_solver.get()))
+      cnf->set_structural_hashing(true);
+  }
+
+  return sat_solver;
+}
+
 std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
 {
   auto sat_solver = get_sat_solver(message_handler, options);
@@ -333,6 +443,10 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
   auto bv_pointers = std::make_unique<bv_pointerst>(
     ns, *sat_solver, message_handler, get_array_constraints);
 
+  bv_pointers->word_level_preprocessing =
+    options.get_bool_option("word-level-preprocessing");
+  bv_pointers->lazy_arithmetic = options.get_bool_option("lazy-arithmetic");
+
   if(options.get_option("arrays-uf") == "never")
     bv_pointers->unbounded_array = bv_pointerst::unbounded_arrayt::U_NONE;
   else if(options.get_option("arrays-uf") == "always")
@@ -350,6 +464,7 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_dimacs()
   no_incremental_check();
 
   auto prop = std::make_unique<dimacs_cnft>(message_handler);
+  prop->set_structural_hashing(options.get_bool_option("structural-hashing"));
 
   std::string filename = options.get_option("outfile");
 
@@ -447,6 +562,32 @@ std::unique_ptr<std::ofstream> open_outfile_and_check(
   return out;
 }
 
+/// \return a solver process which uses the API of \p solver, which is linked
+///   into this process, rather than piping SMT-LIB text to a solver process
+static std::unique_ptr<smt_base_solver_processt> make_api_solver_process(
+  const std::string &solver,
+  message_handlert &message_handler,
+  std::unique_ptr<std::ostream> out_stream)
+{
+#ifdef HAVE_Z3_API
+  if(solver == "z3")
+  {
+    return std::make_unique<smt_z3_api_solver_processt>(
+      message_handler, std::move(out_stream));
+  }
+#endif
+
+  throw invalid_command_line_argument_exceptiont(
+    "the API of solver `" + solver + "' is not available in this build",
+    "--incremental-smt2-api",
+#ifdef HAVE_Z3_API
+    "use z3"
+#else
+    "build with the Z3 API, or use --incremental-smt2-solver"
+#endif
+  );
+}
+
 std::unique_ptr<solver_factoryt::solvert>
 solver_factoryt::get_incremental_smt2(std::string solver_command)
 {
@@ -477,14 +618,23 @@ solver_factoryt::get_incremental_smt2(std::string solver_command)
   else
   {
     const auto out_filename = options.get_option("dump-smt-formula");
+    const auto api_solver = options.get_option("incremental-smt2-api");
 
     // If no out_filename is provided `open_outfile_and_check` will return
     // `nullptr`, and the solver will work normally without any logging.
-    solver_process = std::make_unique<smt_piped_solver_processt>(
-      std::move(solver_command),
-      message_handler,
-      open_outfile_and_check(
-        out_filename, message_handler, "--dump-smt-formula"));
+    auto out_stream = open_outfile_and_check(
+      out_filename, message_handler, "--dump-smt-formula");
+
+    if(!api_solver.empty())
+    {
+      solver_process = make_api_solver_process(
+        api_solver, message_handler, std::move(out_stream));
+    }
+    else
+    {
+      solver_process = std::make_unique<smt_piped_solver_processt>(
+        std::move(solver_command), message_handler, std::move(out_stream));
+    }
   }
 
   return std::make_unique<solvert>(
@@ -600,11 +750,17 @@ static void parse_sat_options(const cmdlinet &cmdline, optionst &options)
 
   options.set_option("sat-preprocessor", !cmdline.isset("no-sat-preprocessor"));
 
+  if(cmdline.isset("structural-hashing"))
+    options.set_option("structural-hashing", true);
+
   if(cmdline.isset("dimacs"))
     options.set_option("dimacs", true);
 
   if(cmdline.isset("sat-solver"))
     options.set_option("sat-solver", cmdline.get_value("sat-solver"));
+
+  if(cmdline.isset("portfolio"))
+    options.set_option("portfolio", cmdline.get_value("portfolio"));
 }
 
 static void parse_smt2_options(const cmdlinet &cmdline, optionst &options)
@@ -660,6 +816,21 @@ static void parse_smt2_options(const cmdlinet &cmdline, optionst &options)
       solver_set = true;
   }
 
+  if(cmdline.isset("incremental-smt2-api"))
+  {
+    if(cmdline.isset("incremental-smt2-solver"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "--incremental-smt2-api and --incremental-smt2-solver cannot be used "
+        "together",
+        "--incremental-smt2-api");
+    }
+
+    options.set_option(
+      "incremental-smt2-api", cmdline.get_value("incremental-smt2-api")),
+      solver_set = true;
+  }
+
   if(cmdline.isset("yices"))
   {
     options.set_option("yices", true), solver_set = true;
@@ -708,6 +879,12 @@ void parse_solver_options(const cmdlinet &cmdline, optionst &options)
   if(cmdline.isset("beautify"))
     options.set_option("beautify", true);
 
+  if(cmdline.isset("word-level-preprocessing"))
+    options.set_option("word-level-preprocessing", true);
+
+  if(cmdline.isset("lazy-arithmetic"))
+    options.set_option("lazy-arithmetic", true);
+
   if(cmdline.isset("refine-arrays"))
   {
     options.set_option("refine", true);
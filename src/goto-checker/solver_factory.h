@@ -103,10 +103,15 @@ void parse_solver_options(const cmdlinet &cmdline, optionst &options);
   "(mathsat)"                                                                  \
   "(cprover-smt2)"                                                             \
   "(incremental-smt2-solver):"                                                 \
+  "(incremental-smt2-api):"                                                    \
   "(sat-solver):"                                                              \
+  "(portfolio):"                                                               \
   "(external-sat-solver):"                                                     \
   "(no-sat-preprocessor)"                                                      \
+  "(structural-hashing)"                                                       \
   "(beautify)"                                                                 \
+  "(word-level-preprocessing)"                                                 \
+  "(lazy-arithmetic)"                                                          \
   "(dimacs)"                                                                   \
   "(refine)"                                                                   \
   "(max-node-refinement):"                                                     \
@@ -118,10 +123,17 @@ void parse_solver_options(const cmdlinet &cmdline, optionst &options);
 
 #define HELP_SOLVER                                                            \
   " {y--sat-solver} {usolver} \t use specified SAT solver\n"                   \
+  " {y--portfolio} {usolvers} \t race the given comma-separated SAT solvers "  \
+  "(minisat2, glucose, cadical) on separate threads\n"                        \
   " {y--external-sat-solver} {ucmd} \t command to invoke SAT solver process\n" \
   " {y--no-sat-preprocessor} \t disable the SAT solver's simplifier\n"         \
+  " {y--structural-hashing} \t share and simplify gates when generating CNF\n" \
   " {y--dimacs} \t generate CNF in DIMACS format\n"                            \
   " {y--beautify} \t beautify the counterexample (greedy heuristic)\n"         \
+  " {y--word-level-preprocessing} \t "                                         \
+  "propagate equalities and narrow operations before bit-blasting\n"           \
+  " {y--lazy-arithmetic} \t "                                                  \
+  "bit-blast multiplication and division only when needed\n"                   \
   " {y--smt1} \t use default SMT1 solver (obsolete)\n"                         \
   " {y--smt2} \t use default SMT2 solver (Z3)\n"                               \
   " {y--bitwuzla} \t use Bitwuzla\n"                                           \
@@ -142,6 +154,9 @@ void parse_solver_options(const cmdlinet &cmdline, optionst &options);
   " {y--incremental-smt2-solver} {ucmd} \t "                                   \
   "command to invoke external SMT solver for incremental solving "             \
   "(experimental)\n"                                                           \
+  " {y--incremental-smt2-api} {usolver} \t "                                   \
+  "use the API of the given SMT solver (z3) in-process for incremental "       \
+  "solving (experimental)\n"                                                   \
   " {y--outfile} {ufilename} \t output formula to given file\n"                \
   " {y--dump-smt-formula} {ufilename} \t "                                     \
   "output smt incremental formula to the given file\n"                         \
@@ -0,0 +1,313 @@
+/*******************************************************************\
+
+Module: Verification Cache
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Re-use the results of earlier verification runs on an unchanged program
+
+#include "verification_cache.h"
+
+#include <util/options.h>
+#include <util/sha256.h>
+#include <util/symbol_table.h>
+#include <util/version.h>
+
+#include <goto-programs/abstract_goto_model.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/// First line of cache files, to be changed when the fingerprint or the
+/// format of the file changes
+static const char cache_header[] = "CBMC verification cache 3";
+
+/// Append \p size to \p sha256 in a fixed number of bytes, which keeps the
+/// message unambiguous when \p size is the length of what follows
+static void add_size(sha256t &sha256, std::size_t size)
+{
+  const std::uint64_t value = size;
+  for(std::size_t i = 0; i < 8; ++i)
+  {
+    const std::uint8_t byte = static_cast<std::uint8_t>(value >> (8 * i));
+    sha256.update(&byte, 1);
+  }
+}
+
+static void add_string(sha256t &sha256, const std::string &string)
+{
+  add_size(sha256, string.size());
+  sha256.update(string);
+}
+
+static void add_digest(sha256t &sha256, const sha256t::digestt &digest)
+{
+  sha256.update(digest.data(), digest.size());
+}
+
+namespace
+{
+/// Computes digests of ireps from the contents of their strings rather than
+/// from the numbers of the strings, which differ from run to run, and
+/// collects the identifiers of the symbols that the ireps refer to. The
+/// digest of an irep covers the digests of its operands, such that shared
+/// sub-trees are only visited once.
+class stable_digestt
+{
+public:
+  const sha256t::digestt &operator()(const irept &irep)
+  {
+    const auto entry = digests.find(&irep.read());
+    if(entry != digests.end())
+      return entry->second;
+
+    if(
+      irep.id() == ID_symbol || irep.id() == ID_struct_tag ||
+      irep.id() == ID_union_tag || irep.id() == ID_c_enum_tag)
+    {
+      const irep_idt &identifier = irep.get(ID_identifier);
+      if(!identifier.empty() && seen.insert(identifier).second)
+        worklist.push_back(identifier);
+    }
+
+    sha256t sha256;
+    add_string(sha256, id2string(irep.id()));
+
+    add_size(sha256, irep.get_sub().size());
+    for(const auto &sub : irep.get_sub())
+      add_digest(sha256, (*this)(sub));
+
+    for(const auto &named_sub : irep.get_named_sub())
+    {
+      // source locations do not change the semantics
+      if(named_sub.first == ID_C_source_location)
+        continue;
+
+      add_string(sha256, id2string(named_sub.first));
+      add_digest(sha256, (*this)(named_sub.second));
+    }
+
+    return digests.emplace(&irep.read(), sha256.digest()).first->second;
+  }
+
+  /// Identifiers referred to by the ireps seen so far, in the order in which
+  /// they were found
+  std::vector<irep_idt> worklist;
+
+private:
+  std::unordered_map<const void *, sha256t::digestt> digests;
+  std::unordered_set<irep_idt> seen;
+};
+} // namespace
+
+static void add_goto_program(
+  sha256t &sha256,
+  const goto_programt &goto_program,
+  stable_digestt &digest)
+{
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> index;
+  for(const auto &instruction : goto_program.instructions)
+    index.emplace(&instruction, index.size());
+
+  add_size(sha256, goto_program.instructions.size());
+  for(const auto &instruction : goto_program.instructions)
+  {
+    add_size(sha256, static_cast<std::size_t>(instruction.type()));
+    add_digest(sha256, digest(instruction.code()));
+    add_size(sha256, instruction.has_condition());
+    if(instruction.has_condition())
+      add_digest(sha256, digest(instruction.condition()));
+
+    // the cache maps property identifiers to results, hence the identifier
+    // of an assertion must be bound to its condition
+    if(instruction.is_assert())
+    {
+      const source_locationt &source_location = instruction.source_location();
+      add_string(sha256, id2string(source_location.get_property_id()));
+      add_string(sha256, id2string(source_location.get_property_class()));
+      add_string(sha256, id2string(source_location.get_comment()));
+    }
+
+    // targets are identified by their position, as location numbers also
+    // depend on all functions that precede this one
+    add_size(sha256, instruction.targets.size());
+    for(const auto &target : instruction.targets)
+      add_size(sha256, index.at(&*target));
+  }
+}
+
+std::string program_fingerprint(
+  const abstract_goto_modelt &goto_model,
+  const optionst &options)
+{
+  const goto_functionst &goto_functions = goto_model.get_goto_functions();
+  const symbol_tablet &symbol_table = goto_model.get_symbol_table();
+
+  const irep_idt entry_point = goto_functions.entry_point();
+  if(goto_functions.function_map.count(entry_point) == 0)
+    return {};
+
+  // the cache file itself does not change the results
+  optionst relevant_options;
+  relevant_options = options;
+  relevant_options.set_option("verification-cache", "");
+  std::ostringstream options_string;
+  relevant_options.output(options_string);
+
+  sha256t sha256;
+  add_string(sha256, CBMC_VERSION);
+  add_string(sha256, options_string.str());
+
+  stable_digestt digest;
+  digest.worklist.push_back(entry_point);
+
+  // The order of the identifiers only depends on the program, which makes
+  // the fingerprint independent of the order of the symbol table.
+  for(std::size_t i = 0; i < digest.worklist.size(); ++i)
+  {
+    const irep_idt identifier = digest.worklist[i];
+    add_string(sha256, id2string(identifier));
+
+    const symbolt *symbol = symbol_table.lookup(identifier);
+    add_size(sha256, symbol != nullptr);
+    if(symbol != nullptr)
+    {
+      add_digest(sha256, digest(symbol->type));
+      add_digest(sha256, digest(symbol->value));
+      add_size(sha256, symbol->is_static_lifetime);
+    }
+
+    const auto function = goto_functions.function_map.find(identifier);
+    add_size(sha256, function != goto_functions.function_map.end());
+    if(function != goto_functions.function_map.end())
+      add_goto_program(sha256, function->second.body, digest);
+  }
+
+  return sha256t::to_hex(sha256.digest());
+}
+
+verification_cachet::verification_cachet(
+  std::string _filename,
+  const optionst &options,
+  const abstract_goto_modelt &goto_model,
+  message_handlert &message_handler)
+  : filename(std::move(_filename)),
+    fingerprint(program_fingerprint(goto_model, options)),
+    log(message_handler)
+{
+  read();
+}
+
+void verification_cachet::read()
+{
+  std::ifstream in(filename);
+  if(!in)
+    return;
+
+  std::string line;
+  if(!std::getline(in, line) || line != cache_header)
+  {
+    log.warning() << "ignoring verification cache '" << filename
+                  << "' written by a different version" << messaget::eom;
+    return;
+  }
+
+  while(std::getline(in, line))
+  {
+    const std::size_t space = line.find(' ');
+    if(space == std::string::npos)
+      continue;
+
+    entries[line.substr(0, space)].insert(line.substr(space + 1));
+  }
+}
+
+void verification_cachet::write() const
+{
+  // Write to a file of our own first and then replace the cache file, such
+  // that concurrent runs never read a partially written cache file.
+  std::random_device random;
+  const std::string temporary_file =
+    filename + "." + std::to_string(random()) + ".tmp";
+
+  {
+    std::ofstream out(temporary_file);
+    if(out)
+    {
+      out << cache_header << '\n';
+      for(const auto &entry : entries)
+      {
+        for(const auto &property_id : entry.second)
+          out << entry.first << ' ' << property_id << '\n';
+      }
+    }
+
+    if(!out)
+    {
+      log.warning() << "failed to write verification cache '" << filename
+                    << "'" << messaget::eom;
+      out.close();
+      std::error_code error;
+      std::filesystem::remove(temporary_file, error);
+      return;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary_file, filename, error);
+  if(error)
+  {
+    log.warning() << "failed to write verification cache '" << filename
+                  << "': " << error.message() << messaget::eom;
+    std::filesystem::remove(temporary_file, error);
+  }
+}
+
+std::size_t verification_cachet::apply(propertiest &properties) const
+{
+  const auto entry = entries.find(fingerprint);
+  if(fingerprint.empty() || entry == entries.end())
+    return 0;
+
+  std::size_t count = 0;
+  for(auto &property_pair : properties)
+  {
+    if(
+      is_property_to_check(property_pair.second.status) &&
+      entry->second.count(id2string(property_pair.first)) != 0)
+    {
+      property_pair.second.status = property_statust::PASS;
+      ++count;
+    }
+  }
+
+  log.status() << "Verification cache: " << count << " of "
+               << properties.size() << " properties hold according to '"
+               << filename << "'" << messaget::eom;
+
+  return count;
+}
+
+void verification_cachet::update(const propertiest &properties)
+{
+  if(fingerprint.empty())
+    return;
+
+  std::set<std::string> &passing = entries[fingerprint];
+  passing.clear();
+  for(const auto &property_pair : properties)
+  {
+    if(property_pair.second.status == property_statust::PASS)
+      passing.insert(id2string(property_pair.first));
+  }
+
+  write();
+}
@@ -0,0 +1,83 @@
+/*******************************************************************\
+
+Module: Verification Cache
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Re-use the results of earlier verification runs on an unchanged program
+
+#ifndef CPROVER_GOTO_CHECKER_VERIFICATION_CACHE_H
+#define CPROVER_GOTO_CHECKER_VERIFICATION_CACHE_H
+
+#include <util/message.h>
+
+#include "properties.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+class abstract_goto_modelt;
+class optionst;
+
+/// Fingerprint of the program that symbolic execution of \p goto_model
+/// explores, i.e., of the goto functions, global variables and types that
+/// are transitively referenced from the entry point, and of the \p options
+/// that are used to verify it. Source locations are ignored, such that
+/// changes to unrelated code in the same file do not change the fingerprint.
+/// \return the fingerprint as a hexadecimal string, or the empty string if
+///   \p goto_model has no entry point
+std::string program_fingerprint(
+  const abstract_goto_modelt &goto_model,
+  const optionst &options);
+
+/// Records which properties hold in a program with a given fingerprint (see
+/// \ref program_fingerprint) in a file, such that a later run on a program
+/// with the same fingerprint can report these properties as passing without
+/// running symbolic execution or the solver for them.
+///
+/// As the fingerprint covers everything that may execute before a property
+/// is reached, changes to functions that the entry point cannot reach (e.g.,
+/// the functions of other harnesses in the same goto binary) keep the
+/// results of a harness, whereas any change to the code under verification
+/// discards them. Only passing properties are recorded, as failing ones need
+/// to be checked again to produce a trace.
+class verification_cachet
+{
+public:
+  verification_cachet(
+    std::string filename,
+    const optionst &options,
+    const abstract_goto_modelt &goto_model,
+    message_handlert &message_handler);
+
+  /// Set the status of the properties that hold according to the cache to
+  /// PASS
+  /// \return the number of these properties
+  std::size_t apply(propertiest &properties) const;
+
+  /// Record the properties that pass in \p properties and write the cache
+  /// file, keeping the entries for other fingerprints
+  void update(const propertiest &properties);
+
+  const std::string &get_fingerprint() const
+  {
+    return fingerprint;
+  }
+
+protected:
+  const std::string filename;
+  const std::string fingerprint;
+  messaget log;
+
+  /// The passing properties by fingerprint
+  std::map<std::string, std::set<std::string>> entries;
+
+  void read();
+  void write() const;
+};
+
+#endif // CPROVER_GOTO_CHECKER_VERIFICATION_CACHE_H
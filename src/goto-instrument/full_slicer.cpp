@@ -13,24 +13,277 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "full_slicer_class.h"
 
 #include <util/find_symbols.h>
+#include <util/parallel_for.h>
 
 #include <goto-programs/adjust_float_expressions.h>
 #include <goto-programs/remove_skip.h>
 
+#include <analyses/dependence_graph.h>
+
+#include <algorithm>
+#include <chrono>
+
+void full_slicert::compute_blocking_functions(
+  const goto_functionst &goto_functions)
+{
+  std::unordered_map<irep_idt, std::vector<irep_idt>> callers;
+  std::vector<irep_idt> worklist;
+
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    for(const auto &instruction : gf_entry.second.body.instructions)
+    {
+      if(instruction.is_assume())
+      {
+        if(blocking_functions.insert(gf_entry.first).second)
+          worklist.push_back(gf_entry.first);
+      }
+      else if(
+        instruction.is_function_call() &&
+        instruction.call_function().id() == ID_symbol)
+      {
+        const irep_idt &callee =
+          to_symbol_expr(instruction.call_function()).get_identifier();
+        callers[callee].push_back(gf_entry.first);
+      }
+    }
+  }
+
+  while(!worklist.empty())
+  {
+    const irep_idt callee = worklist.back();
+    worklist.pop_back();
+
+    const auto entry = callers.find(callee);
+    if(entry == callers.end())
+      continue;
+
+    for(const auto &caller : entry->second)
+    {
+      if(blocking_functions.insert(caller).second)
+        worklist.push_back(caller);
+    }
+  }
+}
+
+bool full_slicert::is_blocking_call(goto_programt::const_targett target) const
+{
+  if(!target->is_function_call() || target->call_function().id() != ID_symbol)
+    return false;
+
+  return blocking_functions.count(
+           to_symbol_expr(target->call_function()).get_identifier()) != 0;
+}
+
+void full_slicert::compute_control_dependencies(
+  const goto_functionst &goto_functions,
+  std::size_t number_of_threads)
+{
+  std::vector<std::pair<const goto_programt *, cfg_post_dominatorst *>>
+    functions;
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    if(gf_entry.second.body_available())
+    {
+      functions.emplace_back(
+        &gf_entry.second.body, &post_dominators[gf_entry.first]);
+    }
+  }
+
+  control_deps.resize(cfg.size());
+
+  // Neither computation copies any irept, and each function only writes to
+  // its own post-dominators and to the control dependencies of its own
+  // instructions. Hence functions can be processed in parallel.
+  parallel_for(
+    number_of_threads,
+    functions.size(),
+    [&functions, this](std::size_t, std::size_t index) {
+      cfg_post_dominatorst &pd = *functions[index].second;
+      pd(*functions[index].first);
+      compute_control_dependencies(pd);
+    });
+}
+
+void full_slicert::compute_control_dependencies(
+  const cfg_post_dominatorst &pd)
+{
+  // Better Slicing of Programs with Jumps and Switches
+  // Kumar and Horwitz, FASE'02:
+  // "Node N is control dependent on node M iff N postdominates, in
+  // the CFG, one but not all of M's CFG successors."
+  //
+  // Following Ferrante et al., TOPLAS'87, these are the nodes on the paths
+  // in the post-dominator tree from the successors of M up to (excluding)
+  // the immediate post-dominator of M. As in dependence_grapht, assumptions
+  // also introduce a control dependency: all post-dominators of their
+  // successor depend on them.
+
+  typedef cfg_post_dominatorst::cfgt pd_cfgt;
+  const pd_cfgt::entryt none = std::numeric_limits<pd_cfgt::entryt>::max();
+
+  // The post-dominators of a node form a chain, hence the immediate
+  // post-dominator is the strict post-dominator with most post-dominators.
+  std::vector<pd_cfgt::entryt> immediate_post_dominator(pd.cfg.size(), none);
+  for(pd_cfgt::entryt n = 0; n < pd.cfg.size(); ++n)
+  {
+    std::size_t post_dom_size = 0;
+    for(const auto &d : pd.cfg[n].dominators)
+    {
+      const std::size_t size = pd.get_node(d).dominators.size();
+      if(d != pd.cfg[n].PC && size > post_dom_size)
+      {
+        immediate_post_dominator[n] = pd.get_node_index(d);
+        post_dom_size = size;
+      }
+    }
+  }
+
+  for(pd_cfgt::entryt m = 0; m < pd.cfg.size(); ++m)
+  {
+    const goto_programt::const_targett m_PC = pd.cfg[m].PC;
+    const bool is_assume = m_PC->is_assume();
+    if(!is_assume && !m_PC->is_goto())
+      continue;
+
+    const cfgt::entryt m_entry = cfg.get_node_index(m_PC);
+    if(!node_reachable[m_entry])
+      continue;
+
+    // Successors that cannot reach the end of the function have no
+    // post-dominators. The post-dominators of M then only take the other
+    // successors into account, and hence none of these post-dominate all
+    // successors.
+    pd_cfgt::entryt stop = is_assume ? none : immediate_post_dominator[m];
+    for(const auto &edge : pd.cfg[m].out)
+    {
+      if(pd.cfg[edge.first].dominators.empty())
+        stop = none;
+    }
+
+    for(const auto &edge : pd.cfg[m].out)
+    {
+      if(pd.cfg[edge.first].dominators.empty())
+        continue;
+
+      for(pd_cfgt::entryt n = edge.first; n != none && n != stop;
+          n = immediate_post_dominator[n])
+      {
+        const goto_programt::const_targett n_PC = pd.cfg[n].PC;
+        if(n_PC == m_PC)
+          continue;
+
+        // successors of M may share post-dominators
+        auto &deps = control_deps[cfg.get_node_index(n_PC)];
+        if(deps.empty() || deps.back() != m_entry)
+          deps.push_back(m_entry);
+
+        // The post-dominators of a node that blocks depend on that node,
+        // which in turn depends on M.
+        if(is_assume && (n_PC->is_assume() || is_blocking_call(n_PC)))
+          break;
+      }
+    }
+  }
+
+  // As in dependence_grapht, any instruction that is reachable from a call
+  // of a function that may block depends on the call, even if the end of
+  // the function cannot be reached. Only the nearest such calls are
+  // recorded, as these in turn depend on the calls before them.
+  std::vector<std::vector<cfgt::entryt>> blocking_calls(pd.cfg.size());
+  std::vector<pd_cfgt::entryt> worklist;
+  for(pd_cfgt::entryt n = 0; n < pd.cfg.size(); ++n)
+  {
+    const goto_programt::const_targett n_PC = pd.cfg[n].PC;
+    if(is_blocking_call(n_PC) && node_reachable[cfg.get_node_index(n_PC)])
+      worklist.push_back(n);
+  }
+
+  while(!worklist.empty())
+  {
+    const pd_cfgt::entryt n = worklist.back();
+    worklist.pop_back();
+
+    const goto_programt::const_targett n_PC = pd.cfg[n].PC;
+    const std::vector<cfgt::entryt> calls =
+      is_blocking_call(n_PC)
+        ? std::vector<cfgt::entryt>{cfg.get_node_index(n_PC)}
+        : blocking_calls[n];
+
+    for(const auto &edge : pd.cfg[n].out)
+    {
+      if(!node_reachable[cfg.get_node_index(pd.cfg[edge.first].PC)])
+        continue;
+
+      std::vector<cfgt::entryt> &successor_calls = blocking_calls[edge.first];
+      const std::size_t old_size = successor_calls.size();
+      for(const auto &call : calls)
+      {
+        if(
+          std::find(successor_calls.begin(), successor_calls.end(), call) ==
+          successor_calls.end())
+        {
+          successor_calls.push_back(call);
+        }
+      }
+      if(successor_calls.size() != old_size)
+        worklist.push_back(edge.first);
+    }
+  }
+
+  for(pd_cfgt::entryt n = 0; n < pd.cfg.size(); ++n)
+  {
+    auto &deps = control_deps[cfg.get_node_index(pd.cfg[n].PC)];
+    deps.insert(deps.end(), blocking_calls[n].begin(), blocking_calls[n].end());
+  }
+}
+
 void full_slicert::add_dependencies(
   const cfgt::nodet &node,
   queuet &queue,
-  const dependence_grapht &dep_graph,
-  const dep_node_to_cfgt &dep_node_to_cfg)
+  const goto_functionst &goto_functions,
+  const reaching_definitions_analysist &reaching_definitions,
+  const namespacet &ns,
+  message_handlert &message_handler)
 {
-  const dependence_grapht::nodet &d_node=
-    dep_graph[dep_graph[node.PC].get_node_id()];
+  // instructions that cannot be reached do not depend on anything
+  if(!node_reachable[cfg.get_node_index(node.PC)])
+    return;
 
-  for(dependence_grapht::edgest::const_iterator
-      it=d_node.in.begin();
-      it!=d_node.in.end();
-      ++it)
-    add_to_queue(queue, dep_node_to_cfg[it->first], node.PC);
+  for(const auto &dep : control_deps[cfg.get_node_index(node.PC)])
+    add_to_queue(queue, dep, node.PC);
+
+  // data dependencies are only computed for instructions in the slice
+  for(const auto &dep : compute_data_dependencies(
+        node.function_id, node.PC, reaching_definitions, ns, message_handler))
+  {
+    add_to_queue(queue, cfg.get_node_index(dep), node.PC);
+  }
+
+  if(node.PC->is_end_function())
+  {
+    // the return value is defined at the end of the function
+    const goto_programt &body =
+      goto_functions.function_map.at(node.function_id).body;
+    forall_goto_program_instructions(i_it, body)
+    {
+      if(i_it->is_set_return_value())
+        add_to_queue(queue, cfg.get_node_index(i_it), node.PC);
+    }
+  }
+  else if(is_blocking_call(node.PC))
+  {
+    // whether the instructions after the call are executed depends on the
+    // assumptions in the function being called
+    const goto_programt &body =
+      goto_functions.function_map
+        .at(to_symbol_expr(node.PC->call_function()).get_identifier())
+        .body;
+    const goto_programt::const_targett end_function =
+      std::prev(body.instructions.end());
+    for(const auto &dep : control_deps[cfg.get_node_index(end_function)])
+      add_to_queue(queue, dep, node.PC);
+  }
 }
 
 void full_slicert::add_function_calls(
@@ -82,10 +335,7 @@ void full_slicert::add_decl_dead(
   }
 }
 
-void full_slicert::add_jumps(
-  queuet &queue,
-  jumpst &jumps,
-  const dependence_grapht::post_dominators_mapt &post_dominators)
+void full_slicert::add_jumps(queuet &queue, jumpst &jumps)
 {
   // Based on:
   // On slicing programs with jump statements
@@ -118,7 +368,7 @@ void full_slicert::add_jumps(
     const cfgt::nodet &j=cfg[*it];
 
     // is j in the slice already?
-    if(j.node_required)
+    if(node_required[*it])
     {
       jumps.erase(it);
       it=next;
@@ -129,7 +379,7 @@ void full_slicert::add_jumps(
     goto_programt::const_targett lex_succ=j.PC;
     for( ; !lex_succ->is_end_function(); ++lex_succ)
     {
-      if(cfg.get_node(lex_succ).node_required)
+      if(node_required[cfg.get_node_index(lex_succ)])
         break;
     }
     if(lex_succ->is_end_function())
@@ -161,7 +411,7 @@ void full_slicert::add_jumps(
           ++d_it)
       {
         const auto &node = cfg.get_node(*d_it);
-        if(node.node_required)
+        if(node_required[cfg.get_node_index(*d_it)])
         {
           const irep_idt &id2 = node.function_id;
           INVARIANT(id==id2,
@@ -192,32 +442,34 @@ void full_slicert::fixedpoint(
   queuet &queue,
   jumpst &jumps,
   decl_deadt &decl_dead,
-  const dependence_grapht &dep_graph)
+  const reaching_definitions_analysist &reaching_definitions,
+  const namespacet &ns,
+  message_handlert &message_handler)
 {
-  std::vector<cfgt::entryt> dep_node_to_cfg;
-  dep_node_to_cfg.reserve(dep_graph.size());
-
-  for(dependence_grapht::node_indext i = 0; i < dep_graph.size(); ++i)
-    dep_node_to_cfg.push_back(cfg.get_node_index(dep_graph[i].PC));
-
   // process queue until empty
   while(!queue.empty())
   {
     while(!queue.empty())
     {
       cfgt::entryt e=queue.top();
-      cfgt::nodet &node=cfg[e];
+      const cfgt::nodet &node=cfg[e];
       queue.pop();
 
       // already done by some earlier iteration?
-      if(node.node_required)
+      if(node_required[e])
         continue;
 
       // node is required
-      node.node_required=true;
+      node_required[e]=true;
 
       // add data and control dependencies of node
-      add_dependencies(node, queue, dep_graph, dep_node_to_cfg);
+      add_dependencies(
+        node,
+        queue,
+        goto_functions,
+        reaching_definitions,
+        ns,
+        message_handler);
 
       // retain all calls of the containing function
       add_function_calls(node, queue, goto_functions);
@@ -227,7 +479,7 @@ void full_slicert::fixedpoint(
     }
 
     // add any required jumps
-    add_jumps(queue, jumps, dep_graph.cfg_post_dominators());
+    add_jumps(queue, jumps);
   }
 }
 
@@ -264,6 +516,7 @@ void full_slicert::operator()(
     forall_goto_program_instructions(i_it, gf_entry.second.body)
       cfg.get_node(i_it).function_id = gf_entry.first;
   }
+  node_required.resize(cfg.size(), false);
 
   // fill queue with according to slicing criterion
   queuet queue;
@@ -296,12 +549,56 @@ void full_slicert::operator()(
     }
   }
 
-  // compute program dependence graph (and post-dominators)
-  dependence_grapht dep_graph(ns, message_handler);
-  dep_graph(goto_functions, ns);
+  // data dependencies are computed on demand from reaching definitions
+  const auto reaching_definitions_start = std::chrono::steady_clock::now();
+  reaching_definitions_analysist reaching_definitions(ns, message_handler);
+  reaching_definitions(goto_functions, ns);
+
+  // instructions that the analysis has not reached are unreachable
+  node_reachable.resize(cfg.size(), false);
+  for(const auto &instruction_and_index : cfg.entries())
+  {
+    node_reachable[instruction_and_index.second] =
+      !reaching_definitions.abstract_state_before(instruction_and_index.first)
+         ->is_bottom();
+  }
+  const auto reaching_definitions_stop = std::chrono::steady_clock::now();
+
+  // compute post-dominators and control dependencies
+  compute_blocking_functions(goto_functions);
+  compute_control_dependencies(goto_functions, number_of_threads);
+  const auto control_stop = std::chrono::steady_clock::now();
 
   // compute the fixedpoint
-  fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+  fixedpoint(
+    goto_functions,
+    queue,
+    jumps,
+    decl_dead,
+    reaching_definitions,
+    ns,
+    message_handler);
+  const auto fixedpoint_stop = std::chrono::steady_clock::now();
+
+  messaget log(message_handler);
+  const std::chrono::duration<double> reaching_definitions_runtime =
+    reaching_definitions_stop - reaching_definitions_start;
+  log.statistics() << "Runtime Reaching Definitions: "
+                   << reaching_definitions_runtime.count() << "s"
+                   << messaget::eom;
+  const std::chrono::duration<double> control_runtime =
+    control_stop - reaching_definitions_stop;
+  log.statistics() << "Runtime Control Dependencies: "
+                   << control_runtime.count() << "s" << messaget::eom;
+  const std::chrono::duration<double> fixedpoint_runtime =
+    fixedpoint_stop - control_stop;
+  log.statistics() << "Runtime Slicing: " << fixedpoint_runtime.count() << "s"
+                   << messaget::eom;
+  log.statistics() << "Slice retains "
+                   << std::count(
+                        node_required.begin(), node_required.end(), true)
+                   << " of " << node_required.size() << " instructions"
+                   << messaget::eom;
 
   // now replace those instructions that are not needed
   // by skips
@@ -312,10 +609,10 @@ void full_slicert::operator()(
     {
       Forall_goto_program_instructions(i_it, gf_entry.second.body)
       {
-        const auto &cfg_node = cfg.get_node(i_it);
+        const auto cfg_node_index = cfg.get_node_index(i_it);
         if(
           !i_it->is_end_function() && // always retained
-          !cfg_node.node_required)
+          !node_required[cfg_node_index])
         {
           i_it->turn_into_skip();
         }
@@ -324,6 +621,7 @@ void full_slicert::operator()(
         {
           std::string c="ins:"+std::to_string(i_it->location_number);
           c+=" req by:";
+          const auto &cfg_node = cfg[cfg_node_index];
           for(std::set<unsigned>::const_iterator req_it =
                 cfg_node.required_by.begin();
               req_it != cfg_node.required_by.end();
@@ -363,30 +661,41 @@ void full_slicer(
   full_slicert()(goto_functions, ns, a, message_handler);
 }
 
-void full_slicer(goto_modelt &goto_model, message_handlert &message_handler)
+void full_slicer(
+  goto_modelt &goto_model,
+  message_handlert &message_handler,
+  std::size_t number_of_threads)
 {
   assert_criteriont a;
   const namespacet ns(goto_model.symbol_table);
-  full_slicert()(goto_model.goto_functions, ns, a, message_handler);
+  full_slicert{number_of_threads}(
+    goto_model.goto_functions, ns, a, message_handler);
 }
 
 void property_slicer(
   goto_functionst &goto_functions,
   const namespacet &ns,
   const std::list<std::string> &properties,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  std::size_t number_of_threads)
 {
   properties_criteriont p(properties);
-  full_slicert()(goto_functions, ns, p, message_handler);
+  full_slicert{number_of_threads}(goto_functions, ns, p, message_handler);
 }
 
 void property_slicer(
   goto_modelt &goto_model,
   const std::list<std::string> &properties,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  std::size_t number_of_threads)
 {
   const namespacet ns(goto_model.symbol_table);
-  property_slicer(goto_model.goto_functions, ns, properties, message_handler);
+  property_slicer(
+    goto_model.goto_functions,
+    ns,
+    properties,
+    message_handler,
+    number_of_threads);
 }
 
 slicing_criteriont::~slicing_criteriont()
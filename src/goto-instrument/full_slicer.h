@@ -20,18 +20,25 @@ class message_handlert;
 
 void full_slicer(goto_functionst &, const namespacet &, message_handlert &);
 
-void full_slicer(goto_modelt &, message_handlert &);
+/// \param number_of_threads: number of threads used to compute control
+///   dependencies, 0 meaning one per core
+void full_slicer(
+  goto_modelt &,
+  message_handlert &,
+  std::size_t number_of_threads = 1);
 
 void property_slicer(
   goto_functionst &,
   const namespacet &,
   const std::list<std::string> &properties,
-  message_handlert &);
+  message_handlert &,
+  std::size_t number_of_threads = 1);
 
 void property_slicer(
   goto_modelt &,
   const std::list<std::string> &properties,
-  message_handlert &);
+  message_handlert &,
+  std::size_t number_of_threads = 1);
 
 class slicing_criteriont
 {
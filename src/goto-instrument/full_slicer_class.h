@@ -15,11 +15,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <stack>
 #include <vector>
 #include <list>
+#include <unordered_set>
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/cfg.h>
 
-#include <analyses/dependence_graph.h>
+#include <analyses/cfg_dominators.h>
+#include <analyses/reaching_definitions.h>
 
 #include "full_slicer.h"
 
@@ -35,9 +37,26 @@ echo 'digraph g {' > c.dot ; cat c.goto | \
   dot -Tpdf -oc-red.pdf c-red.dot
 #endif
 
+/// Slices a program with respect to a slicing criterion, keeping only those
+/// instructions that the criterion transitively depends on.
+///
+/// Rather than building the full program dependence graph (see
+/// \ref dependence_grapht), the slicer computes the dependencies of only those
+/// instructions that turn out to be required, starting from the slicing
+/// criterion. Control dependencies are computed from the post-dominators of
+/// each function, which can be done for several functions in parallel. Data
+/// dependencies are computed from the result of the reaching-definitions
+/// analysis once an instruction is found to be required.
 class full_slicert
 {
 public:
+  /// \param number_of_threads: number of threads used to compute control
+  ///   dependencies, 0 meaning one per core
+  explicit full_slicert(std::size_t number_of_threads = 1)
+    : number_of_threads(number_of_threads)
+  {
+  }
+
   void operator()(
     goto_functionst &goto_functions,
     const namespacet &ns,
@@ -45,13 +64,10 @@ class full_slicert
     message_handlert &message_handler);
 
 protected:
+  std::size_t number_of_threads;
+
   struct cfg_nodet
   {
-    cfg_nodet():node_required(false)
-    {
-    }
-
-    bool node_required;
     irep_idt function_id;
 #ifdef DEBUG_FULL_SLICERT
     std::set<unsigned> required_by;
@@ -61,23 +77,56 @@ class full_slicert
   typedef cfg_baset<cfg_nodet> cfgt;
   cfgt cfg;
 
-  typedef std::vector<cfgt::entryt> dep_node_to_cfgt;
+  /// One bit per CFG node, set for the nodes in the slice
+  std::vector<bool> node_required;
+
+  /// One bit per CFG node, set for the nodes that the reaching-definitions
+  /// analysis has reached
+  std::vector<bool> node_reachable;
+
   typedef std::stack<cfgt::entryt> queuet;
   typedef std::list<cfgt::entryt> jumpst;
   typedef std::unordered_map<irep_idt, queuet> decl_deadt;
+  typedef std::map<irep_idt, cfg_post_dominatorst> post_dominators_mapt;
+
+  post_dominators_mapt post_dominators;
+
+  /// For each CFG node the nodes it is control dependent on, omitting those
+  /// that are implied by the control dependencies of other nodes; this list
+  /// is empty for most nodes
+  std::vector<std::vector<cfgt::entryt>> control_deps;
+
+  /// Functions that may block execution as they (transitively) contain
+  /// assumptions; the callers of these functions need to retain the
+  /// assumptions when retaining instructions that follow the call
+  std::unordered_set<irep_idt> blocking_functions;
+
+  void compute_blocking_functions(const goto_functionst &goto_functions);
+
+  void compute_control_dependencies(
+    const goto_functionst &goto_functions,
+    std::size_t number_of_threads);
+
+  void compute_control_dependencies(const cfg_post_dominatorst &pd);
+
+  bool is_blocking_call(goto_programt::const_targett target) const;
 
   void fixedpoint(
     goto_functionst &goto_functions,
     queuet &queue,
     jumpst &jumps,
     decl_deadt &decl_dead,
-    const dependence_grapht &dep_graph);
+    const reaching_definitions_analysist &reaching_definitions,
+    const namespacet &ns,
+    message_handlert &message_handler);
 
   void add_dependencies(
     const cfgt::nodet &node,
     queuet &queue,
-    const dependence_grapht &dep_graph,
-    const dep_node_to_cfgt &dep_node_to_cfg);
+    const goto_functionst &goto_functions,
+    const reaching_definitions_analysist &reaching_definitions,
+    const namespacet &ns,
+    message_handlert &message_handler);
 
   void add_function_calls(
     const cfgt::nodet &node,
@@ -89,10 +138,7 @@ class full_slicert
     queuet &queue,
     decl_deadt &decl_dead);
 
-  void add_jumps(
-    queuet &queue,
-    jumpst &jumps,
-    const dependence_grapht::post_dominators_mapt &post_dominators);
+  void add_jumps(queuet &queue, jumpst &jumps);
 
   void add_to_queue(
     queuet &queue,
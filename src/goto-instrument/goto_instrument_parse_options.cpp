@@ -1766,12 +1766,21 @@ void goto_instrument_parse_optionst::instrument_goto_program()
                   << "https://github.com/diffblue/cbmc/issues/260"
                   << messaget::eom;
     log.status() << "Performing a full slice" << messaget::eom;
+    const std::size_t number_of_threads =
+      cmdline.isset("parallel-slicing")
+        ? unsafe_string2size_t(cmdline.get_value("parallel-slicing"))
+        : 1;
     if(cmdline.isset("property"))
+    {
       property_slicer(
-        goto_model, cmdline.get_values("property"), ui_message_handler);
+        goto_model,
+        cmdline.get_values("property"),
+        ui_message_handler,
+        number_of_threads);
+    }
     else
     {
-      full_slicer(goto_model, ui_message_handler);
+      full_slicer(goto_model, ui_message_handler, number_of_threads);
     }
   }
 
@@ -2011,6 +2020,8 @@ void goto_instrument_parse_optionst::help()
     HELP_REACHABILITY_SLICER
     HELP_FP_REACHABILITY_SLICER
     " {y--full-slice} \t slice away instructions that don't affect assertions\n"
+    " {y--parallel-slicing} {un} \t compute the dependencies of"
+    " {y--full-slice} using up to {un} threads ({y0} uses all cores)\n"
     " {y--property} {uid} \t slice with respect to specific property only\n"
     " {y--slice-global-inits} \t slice away initializations of unused global"
     " variables\n"
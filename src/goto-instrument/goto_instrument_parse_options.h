@@ -80,7 +80,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(custom-bitvector-analysis)" \
   "(show-struct-alignment)(interval-analysis)(show-intervals)" \
   "(show-uninitialized)(show-locations)" \
-  "(full-slice)(slice-global-inits)" \
+  "(full-slice)(parallel-slicing):(slice-global-inits)" \
   OPT_REACHABILITY_SLICER \
   OPT_FP_REACHABILITY_SLICER \
   "(inline)(partial-inline)(function-inline):(log):(no-caching)" \
@@ -27,6 +27,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/mode.h>
 #include <linking/static_lifetime_init.h>
 
+#include "lazy_goto_binary.h"
 #include "read_goto_binary.h"
 
 #include <fstream>
@@ -201,7 +202,27 @@ goto_modelt initialize_goto_model(
   initialize_from_source_files(
     sources, options, language_files, goto_model.symbol_table, message_handler);
 
-  if(read_objects_and_link(binaries, goto_model, message_handler))
+  // Unused functions are dropped anyway, hence only the functions that are
+  // reachable from the entry point are read from a single goto binary. As
+  // the entry point may yet need to be generated, these are read after
+  // conversion below.
+  std::unique_ptr<lazy_goto_binaryt> lazy_goto_binary;
+  if(
+    options.get_bool_option("drop-unused-functions") && sources.empty() &&
+    binaries.size() == 1)
+  {
+    lazy_goto_binary = lazy_goto_binaryt::open(binaries.front());
+  }
+
+  if(lazy_goto_binary)
+  {
+    msg.status() << "Reading GOTO program from file " << binaries.front()
+                 << messaget::eom;
+    lazy_goto_binary->read_symbol_table(
+      goto_model.symbol_table, goto_model.goto_functions);
+    config.set_from_symbol_table(goto_model.symbol_table);
+  }
+  else if(read_objects_and_link(binaries, goto_model, message_handler))
     throw incorrect_goto_program_exceptiont{"failed to read/link goto model"};
 
   set_up_custom_entry_point(
@@ -222,7 +243,19 @@ goto_modelt initialize_goto_model(
   goto_convert(
     goto_model.symbol_table,
     goto_model.goto_functions,
-    message_handler);
+    message_handler,
+    options.is_set("parallel-goto-conversion")
+      ? options.get_unsigned_int_option("parallel-goto-conversion")
+      : 1);
+
+  if(lazy_goto_binary)
+  {
+    const std::size_t number_of_functions_read =
+      lazy_goto_binary->read_reachable_functions(goto_model.goto_functions);
+    msg.statistics() << "Read " << number_of_functions_read << " of "
+                     << lazy_goto_binary->number_of_functions()
+                     << " goto functions" << messaget::eom;
+  }
 
   if(options.is_set("validate-goto-model"))
   {
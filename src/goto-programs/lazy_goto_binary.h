@@ -0,0 +1,96 @@
+/*******************************************************************\
+
+Module: Read goto object files on demand
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Read goto object files on demand
+
+#ifndef CPROVER_GOTO_PROGRAMS_LAZY_GOTO_BINARY_H
+#define CPROVER_GOTO_PROGRAMS_LAZY_GOTO_BINARY_H
+
+#include <util/irep_serialization.h>
+
+#include "goto_function.h"
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class goto_functionst;
+class mapped_filet;
+class symbol_table_baset;
+
+/// A goto binary of version 7 or later, which starts with an index of its
+/// strings, its symbol table, and each of its goto functions, see
+/// \ref write_goto_binary. This makes it possible to only read the goto
+/// functions that are needed, e.g., those reachable from the entry point.
+/// Goto binaries that are files of their own are mapped into memory, such
+/// that the parts that are not needed are not even read from disk, and
+/// strings are looked up without copying them.
+class lazy_goto_binaryt
+{
+public:
+  /// Map the goto binary \p filename into memory
+  /// \return nullptr if \p filename is not a goto binary of version 7 or
+  ///   later (but, e.g., an ELF file with a goto-cc section or an older goto
+  ///   binary), which then needs to be read by \ref read_goto_binary
+  static std::unique_ptr<lazy_goto_binaryt> open(const std::string &filename);
+
+  /// Read the index and the contents of a goto binary from \p in, which
+  /// needs to be positioned after the version number
+  explicit lazy_goto_binaryt(std::istream &in);
+
+  ~lazy_goto_binaryt();
+
+  /// Read the symbol table into \p symbol_table, and add a goto function
+  /// without body for each function symbol to \p goto_functions
+  void
+  read_symbol_table(symbol_table_baset &symbol_table, goto_functionst &) const;
+
+  /// Read the bodies of all functions
+  void read_functions(goto_functionst &goto_functions) const;
+
+  /// Read the bodies of the functions that the entry point of
+  /// \p goto_functions refers to, directly or transitively, unless they have
+  /// a body already. Functions are referred to by calls, but also by taking
+  /// their address.
+  /// \return the number of functions read
+  std::size_t read_reachable_functions(goto_functionst &goto_functions) const;
+
+  std::size_t number_of_functions() const
+  {
+    return functions.size();
+  }
+
+  struct indext;
+
+protected:
+  lazy_goto_binaryt() = default;
+
+  std::unique_ptr<mapped_filet> file;
+
+  /// The index and the sections where they are not mapped into memory
+  std::string buffer;
+
+  /// Find the sections described by \p index in \p sections
+  void read_sections(const indext &index, std::string_view sections);
+
+  mutable irep_string_tablet string_table;
+  std::string_view symbols;
+
+  /// The section of each function, by function name
+  std::unordered_map<irep_idt, std::string_view> functions;
+
+  /// Read the body of \p identifier into \p goto_function
+  void read_function(
+    const irep_idt &identifier,
+    goto_functiont &goto_function) const;
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_LAZY_GOTO_BINARY_H
@@ -67,8 +67,11 @@ static bool link_functions(
   }
 
   // rename symbols in existing functions
-  for(auto &dest_entry : dest_functions.function_map)
-    rename_symbols_in_function(dest_entry.second, rename_dest_symbol);
+  if(!rename_dest_symbol.empty())
+  {
+    for(auto &dest_entry : dest_functions.function_map)
+      rename_symbols_in_function(dest_entry.second, rename_dest_symbol);
+  }
 
   // merge functions
   for(auto &gf_entry : src_functions.function_map)
@@ -127,12 +130,16 @@ std::optional<replace_symbolt::expr_mapt> link_goto_model(
   goto_modelt &&src,
   message_handlert &message_handler)
 {
+  // Only functions of src can collide with weak functions of dest, hence
+  // there is no need to walk all of dest, which may be large when linking many
+  // files.
   std::unordered_set<irep_idt> weak_symbols;
 
-  for(const auto &symbol_pair : dest.symbol_table.symbols)
+  for(const auto &gf_entry : src.goto_functions.function_map)
   {
-    if(symbol_pair.second.is_weak)
-      weak_symbols.insert(symbol_pair.first);
+    const symbolt *symbol = dest.symbol_table.lookup(gf_entry.first);
+    if(symbol != nullptr && symbol->is_weak)
+      weak_symbols.insert(gf_entry.first);
   }
 
   linkingt linking(dest.symbol_table, message_handler);
@@ -13,13 +13,20 @@ Date: June 2006
 
 #include "read_bin_goto_object.h"
 
+#include <util/exception_utils.h>
+#include <util/find_symbols.h>
 #include <util/irep_serialization.h>
+#include <util/mapped_file.h>
 #include <util/message.h>
 #include <util/symbol_table_base.h>
 
 #include "goto_functions.h"
+#include "lazy_goto_binary.h"
 #include "write_goto_binary.h"
 
+#include <istream>
+#include <unordered_set>
+
 static void read_bin_symbol_table_object(
   std::istream &in,
   symbol_table_baset &symbol_table,
@@ -95,99 +102,106 @@ static void copy_parameter_identifiers(
   }
 }
 
-static void read_bin_functions_object(
+/// Read the instructions of a single function into \p f
+static void read_bin_function(
   std::istream &in,
-  goto_functionst &functions,
+  goto_functionst::goto_functiont &f,
   irep_serializationt &irepconverter)
 {
-  const std::size_t count = irepconverter.read_gb_word(in); // # of functions
-
-  for(std::size_t fct_index = 0; fct_index < count; ++fct_index)
+  typedef std::map<
+    goto_programt::targett,
+    std::list<unsigned>,
+    goto_programt::target_less_than>
+    target_mapt;
+  target_mapt target_map;
+  typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
+  rev_target_mapt rev_target_map;
+
+  bool hidden=false;
+
+  std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
+  for(std::size_t ins_index = 0; ins_index < ins_count; ++ins_index)
   {
-    irep_idt fname=irepconverter.read_gb_string(in);
-    goto_functionst::goto_functiont &f = functions.function_map[fname];
+    goto_programt::targett itarget = f.body.add_instruction();
 
-    typedef std::map<
-      goto_programt::targett,
-      std::list<unsigned>,
-      goto_programt::target_less_than>
-      target_mapt;
-    target_mapt target_map;
-    typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
-    rev_target_mapt rev_target_map;
+    // take copies as references into irepconverter are not stable
+    codet code =
+      static_cast<const codet &>(irepconverter.reference_convert(in));
+    source_locationt source_location = static_cast<const source_locationt &>(
+      irepconverter.reference_convert(in));
+    goto_program_instruction_typet instruction_type =
+      (goto_program_instruction_typet)irepconverter.read_gb_word(in);
+    exprt guard =
+      static_cast<const exprt &>(irepconverter.reference_convert(in));
 
-    bool hidden=false;
+    goto_programt::instructiont instruction{
+      code, source_location, instruction_type, guard, {}};
 
-    std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
-    for(std::size_t ins_index = 0; ins_index < ins_count; ++ins_index)
-    {
-      goto_programt::targett itarget = f.body.add_instruction();
-
-      // take copies as references into irepconverter are not stable
-      codet code =
-        static_cast<const codet &>(irepconverter.reference_convert(in));
-      source_locationt source_location = static_cast<const source_locationt &>(
-        irepconverter.reference_convert(in));
-      goto_program_instruction_typet instruction_type =
-        (goto_program_instruction_typet)irepconverter.read_gb_word(in);
-      exprt guard =
-        static_cast<const exprt &>(irepconverter.reference_convert(in));
-
-      goto_programt::instructiont instruction{
-        code, source_location, instruction_type, guard, {}};
-
-      instruction.target_number = irepconverter.read_gb_word(in);
-      if(instruction.is_target() &&
-         rev_target_map.insert(
-           rev_target_map.end(),
-           std::make_pair(instruction.target_number, itarget))->second!=itarget)
-        UNREACHABLE;
-
-      std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
-      for(std::size_t i=0; i<t_count; i++)
-        // just save the target numbers
-        target_map[itarget].push_back(irepconverter.read_gb_word(in));
-
-      std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
-
-      for(std::size_t i=0; i<l_count; i++)
-      {
-        irep_idt label=irepconverter.read_string_ref(in);
-        instruction.labels.push_back(label);
-        if(label == CPROVER_PREFIX "HIDE")
-          hidden=true;
-        // The above info is also held in the goto_functiont object, and could
-        // be stored in the binary.
-      }
+    instruction.target_number = irepconverter.read_gb_word(in);
+    if(instruction.is_target() &&
+       rev_target_map.insert(
+         rev_target_map.end(),
+         std::make_pair(instruction.target_number, itarget))->second!=itarget)
+      UNREACHABLE;
 
-      itarget->swap(instruction);
-    }
+    std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
+    for(std::size_t i=0; i<t_count; i++)
+      // just save the target numbers
+      target_map[itarget].push_back(irepconverter.read_gb_word(in));
 
-    // Resolve targets
-    for(target_mapt::iterator tit = target_map.begin();
-        tit!=target_map.end();
-        tit++)
+    std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
+
+    for(std::size_t i=0; i<l_count; i++)
     {
-      goto_programt::targett ins = tit->first;
+      irep_idt label=irepconverter.read_string_ref(in);
+      instruction.labels.push_back(label);
+      if(label == CPROVER_PREFIX "HIDE")
+        hidden=true;
+      // The above info is also held in the goto_functiont object, and could
+      // be stored in the binary.
+    }
 
-      for(std::list<unsigned>::iterator nit = tit->second.begin();
-          nit!=tit->second.end();
-          nit++)
-      {
-        unsigned n=*nit;
-        rev_target_mapt::const_iterator entry=rev_target_map.find(n);
-        INVARIANT(
-          entry != rev_target_map.end(),
-          "something from the target map should also be in the reverse target "
-          "map");
-        ins->targets.push_back(entry->second);
-      }
+    itarget->swap(instruction);
+  }
+
+  // Resolve targets
+  for(target_mapt::iterator tit = target_map.begin();
+      tit!=target_map.end();
+      tit++)
+  {
+    goto_programt::targett ins = tit->first;
+
+    for(std::list<unsigned>::iterator nit = tit->second.begin();
+        nit!=tit->second.end();
+        nit++)
+    {
+      unsigned n=*nit;
+      rev_target_mapt::const_iterator entry=rev_target_map.find(n);
+      INVARIANT(
+        entry != rev_target_map.end(),
+        "something from the target map should also be in the reverse target "
+        "map");
+      ins->targets.push_back(entry->second);
     }
+  }
 
-    f.body.update();
+  f.body.update();
 
-    if(hidden)
-      f.make_hidden();
+  if(hidden)
+    f.make_hidden();
+}
+
+static void read_bin_functions_object(
+  std::istream &in,
+  goto_functionst &functions,
+  irep_serializationt &irepconverter)
+{
+  const std::size_t count = irepconverter.read_gb_word(in); // # of functions
+
+  for(std::size_t fct_index = 0; fct_index < count; ++fct_index)
+  {
+    irep_idt fname=irepconverter.read_gb_string(in);
+    read_bin_function(in, functions.function_map[fname], irepconverter);
   }
 
   functions.compute_location_numbers();
@@ -253,23 +267,29 @@ bool read_bin_goto_object(
     }
   }
 
-  irep_serializationt::ireps_containert ic;
-  irep_serializationt irepconverter(ic);
-
-  const std::size_t version = irepconverter.read_gb_word(in);
+  const std::size_t version = irep_serializationt::read_gb_word(in);
 
-  if(version < GOTO_BINARY_VERSION)
+  if(version < GOTO_BINARY_VERSION_WITHOUT_INDEX)
   {
     message.error() << "The input was compiled with an old version of "
                        "goto-cc; please recompile"
                     << messaget::eom;
     return true;
   }
-  else if(version == GOTO_BINARY_VERSION)
+  else if(version == GOTO_BINARY_VERSION_WITHOUT_INDEX)
   {
+    irep_serializationt::ireps_containert ic;
+    irep_serializationt irepconverter(ic);
     read_bin_goto_object(in, symbol_table, functions, irepconverter);
     return false;
   }
+  else if(version == GOTO_BINARY_VERSION)
+  {
+    lazy_goto_binaryt goto_binary(in);
+    goto_binary.read_symbol_table(symbol_table, functions);
+    goto_binary.read_functions(functions);
+    return false;
+  }
   else
   {
     message.error() << "The input was compiled with an unsupported version of "
@@ -278,3 +298,254 @@ bool read_bin_goto_object(
     return true;
   }
 }
+
+namespace
+{
+/// Reads from memory without copying it
+class memory_streambuft : public std::streambuf
+{
+public:
+  explicit memory_streambuft(std::string_view contents)
+  {
+    char *begin = const_cast<char *>(contents.data());
+    setg(begin, begin, begin + contents.size());
+  }
+
+  std::size_t position() const
+  {
+    return static_cast<std::size_t>(gptr() - eback());
+  }
+
+  std::size_t remaining() const
+  {
+    return static_cast<std::size_t>(egptr() - gptr());
+  }
+
+  void skip(std::size_t n)
+  {
+    PRECONDITION(n <= remaining());
+    setg(eback(), gptr() + n, egptr());
+  }
+};
+} // namespace
+
+struct lazy_goto_binaryt::indext
+{
+  std::size_t number_of_strings;
+  std::size_t strings_size;
+  std::size_t symbols_size;
+
+  /// The string number of the name and the size of each function section
+  std::vector<std::pair<std::size_t, std::size_t>> functions;
+
+  /// The size of all sections
+  std::size_t sections_size() const
+  {
+    std::size_t result = strings_size + symbols_size;
+    for(const auto &function : functions)
+      result += function.second;
+    return result;
+  }
+};
+
+/// Read the index, the size of which is the first word of \p in
+static lazy_goto_binaryt::indext read_index(std::istream &in)
+{
+  lazy_goto_binaryt::indext index;
+  index.number_of_strings = irep_serializationt::read_gb_word(in);
+  index.strings_size = irep_serializationt::read_gb_word(in);
+  index.symbols_size = irep_serializationt::read_gb_word(in);
+
+  const std::size_t number_of_functions = irep_serializationt::read_gb_word(in);
+  for(std::size_t i = 0; i < number_of_functions; ++i)
+  {
+    const std::size_t name = irep_serializationt::read_gb_word(in);
+    index.functions.emplace_back(name, irep_serializationt::read_gb_word(in));
+  }
+
+  return index;
+}
+
+std::unique_ptr<lazy_goto_binaryt>
+lazy_goto_binaryt::open(const std::string &filename)
+{
+  std::unique_ptr<lazy_goto_binaryt> result{new lazy_goto_binaryt()};
+
+  try
+  {
+    result->file = std::make_unique<mapped_filet>(filename);
+  }
+  catch(const system_exceptiont &)
+  {
+    return nullptr;
+  }
+
+  const std::string_view contents = result->file->contents();
+  if(contents.substr(0, 4) != std::string_view{"\x7f" "GBF"})
+    return nullptr;
+
+  memory_streambuft header_buffer{contents.substr(4)};
+  std::istream header{&header_buffer};
+  if(irep_serializationt::read_gb_word(header) != GOTO_BINARY_VERSION)
+    return nullptr;
+
+  const std::size_t index_size = irep_serializationt::read_gb_word(header);
+  if(index_size > header_buffer.remaining())
+    throw deserialization_exceptiont("goto binary index truncated");
+
+  const std::string_view index_contents =
+    contents.substr(4 + header_buffer.position(), index_size);
+  memory_streambuft index_buffer{index_contents};
+  std::istream index_in{&index_buffer};
+  const indext index = ::read_index(index_in);
+
+  result->read_sections(
+    index, contents.substr(4 + header_buffer.position() + index_size));
+
+  return result;
+}
+
+lazy_goto_binaryt::lazy_goto_binaryt(std::istream &in)
+{
+  const std::size_t index_size = irep_serializationt::read_gb_word(in);
+  buffer.resize(index_size);
+  if(!in.read(buffer.data(), static_cast<std::streamsize>(index_size)))
+    throw deserialization_exceptiont("goto binary index truncated");
+
+  indext index;
+  {
+    memory_streambuft index_buffer{buffer};
+    std::istream index_in{&index_buffer};
+    index = ::read_index(index_in);
+  }
+
+  // the sections are read from the stream as a whole, as a stream may not
+  // support seeking
+  const std::size_t sections_size = index.sections_size();
+  buffer.resize(index_size + sections_size);
+  if(!in.read(
+       buffer.data() + index_size,
+       static_cast<std::streamsize>(sections_size)))
+  {
+    throw deserialization_exceptiont("goto binary truncated");
+  }
+
+  read_sections(index, std::string_view{buffer}.substr(index_size));
+}
+
+lazy_goto_binaryt::~lazy_goto_binaryt() = default;
+
+void lazy_goto_binaryt::read_sections(
+  const indext &index,
+  std::string_view sections)
+{
+  if(index.sections_size() > sections.size())
+    throw deserialization_exceptiont("goto binary truncated");
+
+  const std::string_view strings = sections.substr(0, index.strings_size);
+  memory_streambuft strings_buffer{strings};
+  std::istream strings_in{&strings_buffer};
+  for(std::size_t i = 0; i < index.number_of_strings; ++i)
+  {
+    const std::size_t length = irep_serializationt::read_gb_word(strings_in);
+    if(length > strings_buffer.remaining())
+      throw deserialization_exceptiont("goto binary string truncated");
+
+    string_table.push_back(strings.substr(strings_buffer.position(), length));
+    strings_buffer.skip(length);
+  }
+
+  std::size_t offset = index.strings_size;
+  symbols = sections.substr(offset, index.symbols_size);
+  offset += index.symbols_size;
+
+  for(const auto &function : index.functions)
+  {
+    functions.emplace(
+      string_table[function.first], sections.substr(offset, function.second));
+    offset += function.second;
+  }
+}
+
+void lazy_goto_binaryt::read_symbol_table(
+  symbol_table_baset &symbol_table,
+  goto_functionst &goto_functions) const
+{
+  memory_streambuft symbols_buffer{symbols};
+  std::istream in{&symbols_buffer};
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic, string_table);
+
+  read_bin_symbol_table_object(in, symbol_table, irepconverter);
+  copy_parameter_identifiers(symbol_table, goto_functions);
+}
+
+void lazy_goto_binaryt::read_function(
+  const irep_idt &identifier,
+  goto_functiont &goto_function) const
+{
+  memory_streambuft function_buffer{functions.at(identifier)};
+  std::istream in{&function_buffer};
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic, string_table);
+
+  read_bin_function(in, goto_function, irepconverter);
+}
+
+void lazy_goto_binaryt::read_functions(goto_functionst &goto_functions) const
+{
+  for(const auto &function : functions)
+    read_function(function.first, goto_functions.function_map[function.first]);
+
+  goto_functions.compute_location_numbers();
+}
+
+std::size_t
+lazy_goto_binaryt::read_reachable_functions(goto_functionst &goto_functions) const
+{
+  std::vector<irep_idt> worklist{goto_functionst::entry_point()};
+  std::unordered_set<irep_idt> seen{worklist.begin(), worklist.end()};
+  std::size_t count = 0;
+
+  while(!worklist.empty())
+  {
+    const irep_idt identifier = worklist.back();
+    worklist.pop_back();
+
+    const bool in_binary = functions.find(identifier) != functions.end();
+    auto function_it = goto_functions.function_map.find(identifier);
+    if(function_it == goto_functions.function_map.end())
+    {
+      if(!in_binary)
+        continue; // not a function
+      function_it =
+        goto_functions.function_map.emplace(identifier, goto_functiont{})
+          .first;
+    }
+
+    goto_functiont &goto_function = function_it->second;
+    if(!goto_function.body_available() && in_binary)
+    {
+      read_function(identifier, goto_function);
+      ++count;
+    }
+
+    for(const auto &instruction : goto_function.body.instructions)
+    {
+      find_symbols_sett symbols_in_instruction;
+      find_symbols(instruction.code(), symbols_in_instruction);
+      if(instruction.has_condition())
+        find_symbols(instruction.condition(), symbols_in_instruction);
+
+      for(const auto &symbol : symbols_in_instruction)
+      {
+        if(seen.insert(symbol).second)
+          worklist.push_back(symbol);
+      }
+    }
+  }
+
+  goto_functions.compute_location_numbers();
+
+  return count;
+}
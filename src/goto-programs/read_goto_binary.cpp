@@ -11,8 +11,10 @@ Module: Read Goto Programs
 
 #include "read_goto_binary.h"
 
+#include <util/buffered_message_handler.h>
 #include <util/config.h>
 #include <util/message.h>
+#include <util/parallel_for.h>
 #include <util/replace_symbol.h>
 #include <util/tempfile.h>
 #include <util/unicode.h>
@@ -23,7 +25,10 @@ Module: Read Goto Programs
 #include "osx_fat_reader.h"
 #include "read_bin_goto_object.h"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <vector>
 
 static bool read_goto_binary(
   const std::string &filename,
@@ -256,47 +261,115 @@ bool is_goto_binary(
   return false;
 }
 
-/// \brief reads an object file, and also updates config
-/// \param file_name: file name of the goto binary
-/// \param dest: the goto model returned
-/// \param message_handler: for diagnostics
-/// \return nullopt on error, type replacements to be applied otherwise
-static std::optional<replace_symbolt::expr_mapt> read_object_and_link(
-  const std::string &file_name,
-  goto_modelt &dest,
-  message_handlert &message_handler)
+/// Read the goto binaries \p file_names on up to \p number_of_threads
+/// threads. Messages are recorded per file, such that they can be output in
+/// the order of the files.
+static std::vector<std::optional<goto_modelt>> read_goto_binaries(
+  const std::vector<std::string> &file_names,
+  std::vector<buffered_message_handlert> &message_handlers,
+  std::size_t number_of_threads)
 {
-  messaget(message_handler).status()
-    << "Reading GOTO program from file " << file_name << messaget::eom;
+  std::vector<std::optional<goto_modelt>> goto_models(file_names.size());
 
-  // we read into a temporary model
-  auto temp_model = read_goto_binary(file_name, message_handler);
-  if(!temp_model.has_value())
-    return {};
+  parallel_for(
+    number_of_threads,
+    file_names.size(),
+    [&](std::size_t, std::size_t index) {
+      messaget(message_handlers[index]).status()
+        << "Reading GOTO program from file " << file_names[index]
+        << messaget::eom;
+
+      goto_models[index] =
+        read_goto_binary(file_names[index], message_handlers[index]);
+    });
 
-  return link_goto_model(dest, std::move(*temp_model), message_handler);
+  return goto_models;
 }
 
 bool read_objects_and_link(
   const std::list<std::string> &file_names,
   goto_modelt &dest,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  std::size_t number_of_threads)
 {
   if(file_names.empty())
     return false;
 
+  messaget log{message_handler};
+
+  number_of_threads = effective_number_of_threads(number_of_threads);
+#if !IREP_ATOMIC_REF_COUNT
+  if(number_of_threads > 1)
+  {
+    log.warning() << "parallel reading of goto binaries requires a build "
+                  << "with IREP_ATOMIC_REF_COUNT, reading sequentially"
+                  << messaget::eom;
+    number_of_threads = 1;
+  }
+#endif
+
+  // Files are read in batches, each of which is linked in the order of the
+  // files once read, such that the result does not depend on the number of
+  // threads, and such that only a batch of goto models is held in memory
+  // at a time.
+  const std::size_t batch_size =
+    number_of_threads == 1 ? 1 : 4 * number_of_threads;
+
+  std::chrono::duration<double> read_runtime{0};
+  std::chrono::duration<double> link_runtime{0};
   replace_symbolt::expr_mapt object_type_updates;
 
-  for(const auto &file_name : file_names)
+  for(auto batch_begin = file_names.begin(); batch_begin != file_names.end();)
   {
-    auto updates_opt = read_object_and_link(file_name, dest, message_handler);
-    if(!updates_opt.has_value())
-      return true;
+    std::vector<std::string> batch;
+    for(; batch_begin != file_names.end() && batch.size() < batch_size;
+        ++batch_begin)
+    {
+      batch.push_back(*batch_begin);
+    }
+
+    const auto read_start = std::chrono::steady_clock::now();
+    std::vector<buffered_message_handlert> message_handlers(
+      batch.size(), buffered_message_handlert{message_handler});
+    auto goto_models =
+      read_goto_binaries(batch, message_handlers, number_of_threads);
+    const auto read_stop = std::chrono::steady_clock::now();
+    read_runtime += read_stop - read_start;
+
+    for(std::size_t index = 0; index < batch.size(); ++index)
+    {
+      message_handlers[index].replay();
+      if(!goto_models[index].has_value())
+        return true;
+
+      auto updates_opt = link_goto_model(
+        dest, std::move(*goto_models[index]), message_handler);
+      if(!updates_opt.has_value())
+        return true;
+
+      object_type_updates.insert(updates_opt->begin(), updates_opt->end());
+
+      // free the memory of the goto model that was linked
+      goto_models[index].reset();
+    }
 
-    object_type_updates.insert(updates_opt->begin(), updates_opt->end());
+    link_runtime += std::chrono::steady_clock::now() - read_stop;
   }
 
+  const auto finalize_start = std::chrono::steady_clock::now();
   finalize_linking(dest, object_type_updates);
+  const std::chrono::duration<double> finalize_runtime =
+    std::chrono::steady_clock::now() - finalize_start;
+
+  log.statistics() << "Read " << file_names.size() << " goto binaries using "
+                   << std::min(number_of_threads, file_names.size())
+                   << " threads" << messaget::eom;
+  log.statistics() << "Runtime Read Goto Binaries: " << read_runtime.count()
+                   << "s" << messaget::eom;
+  log.statistics() << "Runtime Link Goto Binaries: " << link_runtime.count()
+                   << "s" << messaget::eom;
+  log.statistics() << "Runtime Finalize Linking: " << finalize_runtime.count()
+                   << "s" << messaget::eom;
 
   // reading successful, let's update config
   config.set_from_symbol_table(dest.symbol_table);
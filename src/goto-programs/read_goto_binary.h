@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 #define CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 
+#include <cstddef>
 #include <list>
 #include <optional>
 #include <string>
@@ -25,13 +26,18 @@ read_goto_binary(const std::string &filename, message_handlert &);
 bool is_goto_binary(const std::string &filename, message_handlert &);
 
 /// Reads object files and updates the config if any files were read.
+/// Files are linked in the order given, independently of the number of
+/// threads.
 /// \param file_names: file names of goto binaries; if empty, just returns false
 /// \param [out] dest: GOTO model to update.
 /// \param message_handler: for diagnostics
+/// \param number_of_threads: number of threads used to read and deserialize
+///   the files, 0 meaning one per hardware thread
 /// \return True on error, false otherwise
 bool read_objects_and_link(
   const std::list<std::string> &file_names,
   goto_modelt &dest,
-  message_handlert &message_handler);
+  message_handlert &message_handler,
+  std::size_t number_of_threads = 1);
 
 #endif // CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
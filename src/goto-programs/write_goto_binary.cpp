@@ -12,6 +12,8 @@ Author: CM Wintersteiger
 #include "write_goto_binary.h"
 
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 #include <util/exception_utils.h>
 #include <util/irep_serialization.h>
@@ -140,6 +142,67 @@ static void write_goto_binary(
   write_goto_functions_binary(out, goto_functions, irepconverter);
 }
 
+/// Writes a goto program in the format of version 7: an index that holds the
+/// number of strings, the size of the sections of strings and of symbols, and
+/// the number of functions followed by the name and the size of the section
+/// of each function; followed by these sections. Strings are kept in their
+/// own section, to which all sections refer. Ireps are only shared within a
+/// section, such that any section can be read without reading the others.
+static void write_indexed_goto_binary(
+  std::ostream &out,
+  const symbol_table_baset &symbol_table,
+  const goto_functionst &goto_functions)
+{
+  irep_string_tablet string_table;
+
+  std::ostringstream symbols_out;
+  {
+    irep_serializationt::ireps_containert irepc;
+    irep_serializationt irepconverter(irepc, string_table);
+    write_symbol_table_binary(symbols_out, symbol_table, irepconverter);
+  }
+  const std::string symbols = symbols_out.str();
+
+  std::vector<std::pair<std::size_t, std::string>> functions;
+  for(const auto &fct : goto_functions.function_map)
+  {
+    if(!fct.second.body_available())
+      continue;
+
+    irep_serializationt::ireps_containert irepc;
+    irep_serializationt irepconverter(irepc, string_table);
+    std::ostringstream function_out;
+    write_instructions_binary(function_out, irepconverter, fct);
+    functions.emplace_back(string_table.number(fct.first), function_out.str());
+  }
+
+  // all strings are known once all other sections have been written
+  std::ostringstream strings_out;
+  for(const auto &s : string_table.get_strings())
+  {
+    write_gb_word(strings_out, s.size());
+    strings_out << id2string(s);
+  }
+  const std::string strings = strings_out.str();
+
+  std::ostringstream index_out;
+  write_gb_word(index_out, string_table.get_strings().size());
+  write_gb_word(index_out, strings.size());
+  write_gb_word(index_out, symbols.size());
+  write_gb_word(index_out, functions.size());
+  for(const auto &function : functions)
+  {
+    write_gb_word(index_out, function.first);
+    write_gb_word(index_out, function.second.size());
+  }
+  const std::string index = index_out.str();
+
+  write_gb_word(out, index.size());
+  out << index << strings << symbols;
+  for(const auto &function : functions)
+    out << function.second;
+}
+
 /// Writes a goto program to disc
 bool write_goto_binary(
   std::ostream &out,
@@ -164,10 +227,7 @@ bool write_goto_binary(
   out << char(0x7f) << "GBF";
   write_gb_word(out, version);
 
-  irep_serializationt::ireps_containert irepc;
-  irep_serializationt irepconverter(irepc);
-
-  if(version < GOTO_BINARY_VERSION)
+  if(version < GOTO_BINARY_VERSION_WITHOUT_INDEX)
   {
     throw invalid_command_line_argument_exceptiont(
       "version " + std::to_string(version) + " no longer supported",
@@ -179,7 +239,15 @@ bool write_goto_binary(
       "unknown goto binary version " + std::to_string(version),
       "supported version = " + std::to_string(GOTO_BINARY_VERSION));
   }
-  write_goto_binary(out, symbol_table, goto_functions, irepconverter);
+  if(version == GOTO_BINARY_VERSION_WITHOUT_INDEX)
+  {
+    irep_serializationt::ireps_containert irepc;
+    irep_serializationt irepconverter(irepc);
+    write_goto_binary(out, symbol_table, goto_functions, irepconverter);
+  }
+  else
+    write_indexed_goto_binary(out, symbol_table, goto_functions);
+
   return false;
 }
 
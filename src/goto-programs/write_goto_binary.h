@@ -12,7 +12,14 @@ Author: CM Wintersteiger
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
 
-#define GOTO_BINARY_VERSION 6
+/// Since version 7, goto binaries start with an index of their strings,
+/// their symbol table, and each of their goto functions, which can be read
+/// independently of each other, see \ref lazy_goto_binaryt
+#define GOTO_BINARY_VERSION 7
+
+/// The last version that serializes all of a goto binary as one stream of
+/// ireps, which can still be read and written
+#define GOTO_BINARY_VERSION_WITHOUT_INDEX 6
 
 #include <iosfwd>
 #include <string>
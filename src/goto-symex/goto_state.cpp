@@ -27,6 +27,69 @@ void goto_statet::output_propagation_map(std::ostream &out)
   }
 }
 
+/// \return true iff \p dereference was computed from the row of \p value_set
+///   that currently holds the values of \p pointer
+static bool is_current(
+  const symex_dereference_resultt &dereference,
+  const exprt &pointer,
+  const value_sett &value_set)
+{
+  const auto entry =
+    value_set.find_entry(to_symbol_expr(pointer).get_identifier());
+  return entry != nullptr &&
+         entry->object_map.get_d() == dereference.object_map.get_d();
+}
+
+std::optional<exprt> goto_statet::find_dereference(
+  const symbol_exprt &pointer,
+  bool is_not_null) const
+{
+  const auto dereference = dereferenced_pointers.find(pointer);
+  if(
+    !dereference.has_value() ||
+    dereference->get().is_not_null != is_not_null ||
+    !is_current(dereference->get(), pointer, value_set))
+  {
+    return {};
+  }
+
+  return dereference->get().result;
+}
+
+void goto_statet::record_dereference(
+  const symbol_exprt &pointer,
+  bool is_not_null,
+  const exprt &result)
+{
+  const auto entry = value_set.find_entry(pointer.get_identifier());
+  if(entry == nullptr)
+    return;
+
+  dereferenced_pointers.insert_or_replace(
+    pointer, symex_dereference_resultt{entry->object_map, is_not_null, result});
+}
+
+void goto_statet::merge_dereferences(const goto_statet &other)
+{
+  decltype(dereferenced_pointers)::delta_viewt delta_view;
+  other.dereferenced_pointers.get_delta_view(
+    dereferenced_pointers, delta_view, false);
+
+  for(const auto &delta_entry : delta_view)
+  {
+    if(!is_current(delta_entry.m, delta_entry.k, value_set))
+      continue;
+
+    if(!delta_entry.is_in_both_maps())
+      dereferenced_pointers.insert(delta_entry.k, delta_entry.m);
+    else if(!is_current(
+              delta_entry.get_other_map_value(), delta_entry.k, value_set))
+    {
+      dereferenced_pointers.replace(delta_entry.k, delta_entry.m);
+    }
+  }
+}
+
 /// Given a condition that must hold on this path, propagate as much knowledge
 /// as possible. For example, if the condition is (x == 5), whether that's an
 /// assumption or a GOTO condition that we just passed through, we can propagate
@@ -24,6 +24,18 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 // by the parent class.
 class goto_symex_statet;
 
+/// The result of dereferencing a pointer symbol, together with the row of the
+/// value set that it was computed from.
+struct symex_dereference_resultt
+{
+  /// Rows of \ref value_sett are copy-on-write: as this holds a reference to
+  /// the row's data, any change to the row creates new data instead of
+  /// modifying this.
+  value_sett::object_mapt object_map;
+  bool is_not_null;
+  exprt result;
+};
+
 /// Container for data that varies per program point, e.g. the constant
 /// propagator state, when state needs to branch. This is copied out of
 /// goto_symex_statet at a control-flow fork and then back into it at a
@@ -42,6 +54,29 @@ class goto_statet
   /// \see goto_symext::dereference_rec
   sharing_mapt<exprt, symbol_exprt, false, irep_hash> dereference_cache;
 
+  /// Results of dereferencing L1 pointer symbols, which are re-used for as
+  /// long as the pointer's value set is unchanged.
+  /// \see goto_symext::dereference_rec
+  sharing_mapt<exprt, symex_dereference_resultt, false, irep_hash>
+    dereferenced_pointers;
+
+  /// \return the result of an earlier dereference of the L1 pointer symbol
+  ///   \p pointer, provided that neither the value set of \p pointer nor
+  ///   \p is_not_null have changed since
+  std::optional<exprt>
+  find_dereference(const symbol_exprt &pointer, bool is_not_null) const;
+
+  /// Record \p result as the result of dereferencing the L1 pointer symbol
+  /// \p pointer with its current value set
+  void record_dereference(
+    const symbol_exprt &pointer,
+    bool is_not_null,
+    const exprt &result);
+
+  /// Add those results of \p other's dereferences that are still valid with
+  /// the (already merged) value set of this state
+  void merge_dereferences(const goto_statet &other);
+
   const symex_level2t &get_level2() const
   {
     return level2;
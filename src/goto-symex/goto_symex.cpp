@@ -32,7 +32,7 @@ Author: Daniel Kroening, kroening@kroening.com
 void goto_symext::do_simplify(exprt &expr)
 {
   if(symex_config.simplify_opt)
-    simplify(expr, ns);
+    simplifier.simplify(expr);
 }
 
 void goto_symext::symex_assign(
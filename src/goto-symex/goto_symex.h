@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 
 #include <util/message.h>
+#include <util/simplify_expr_class.h>
 
 #include "complexity_limiter.h"
 #include "shadow_memory.h"
@@ -67,6 +68,7 @@ class goto_symext
       path_segment_vccs(0),
       _total_vccs(std::numeric_limits<unsigned>::max()),
       _remaining_vccs(std::numeric_limits<unsigned>::max()),
+      simplifier(ns),
       complexity_module(mh, options),
       shadow_memory(
         std::bind(
@@ -833,6 +835,11 @@ class goto_symext
   unsigned _total_vccs, _remaining_vccs;
   ///@}
 
+  /// Simplifier used by \ref do_simplify. It is kept across symex steps, such
+  /// that its cache of simplification results for shared expressions is
+  /// reused; the cache is cleared whenever \ref ns is reset.
+  simplify_exprt simplifier;
+
   complexity_limitert complexity_module;
 
   /// Shadow memory instrumentation API
@@ -848,6 +855,12 @@ class goto_symext
     return _total_vccs;
   }
 
+  const simplify_exprt::cache_statisticst &
+  get_simplifier_cache_statistics() const
+  {
+    return simplifier.get_cache_statistics();
+  }
+
   unsigned get_remaining_vccs() const
   {
     INVARIANT(
@@ -27,6 +27,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 class incremental_dirtyt;
 class symex_target_equationt;
@@ -223,6 +224,11 @@ class goto_symex_statet final : public goto_statet
   /// of a GOTO
   bool has_saved_next_instruction;
 
+  /// \brief The branches that this path took at each GOTO at which paths
+  /// were saved, true for the jump target. This identifies the path
+  /// independently of the order in which paths are explored.
+  std::vector<bool> saved_branches;
+
   /// \brief Should the additional validation checks be run?
   bool run_validation_checks;
 
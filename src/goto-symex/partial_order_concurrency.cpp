@@ -68,7 +68,10 @@ void partial_order_concurrencyt::add_init_writes(
     init_done.insert(a);
   }
 
-  equation.SSA_steps.splice(equation.SSA_steps.begin(), init_steps);
+  // the initial writes go first
+  for(auto &step : equation.SSA_steps)
+    init_steps.push_back(std::move(step));
+  equation.SSA_steps = std::move(init_steps);
 }
 
 void partial_order_concurrencyt::build_event_lists(
@@ -12,13 +12,19 @@ Author: Kareem Khazem <karkhaz@karkhaz.com>
 
 #include <util/cmdline.h>
 #include <util/exit_codes.h>
+#include <util/options.h>
+
+#include "complexity_limiter.h"
+
+#include <cmath>
 
 nondet_symbol_exprt symex_nondet_generatort::
 operator()(typet type, source_locationt location)
 {
-  return nondet_symbol_exprt{"symex::nondet" + std::to_string(nondet_count++),
-                             std::move(type),
-                             std::move(location)};
+  return nondet_symbol_exprt{
+    "symex::nondet" + std::to_string((*nondet_count)++),
+    std::move(type),
+    std::move(location)};
 }
 
 // _____________________________________________________________________________
@@ -81,6 +87,196 @@ void path_fifot::clear()
   paths.clear();
 }
 
+// _____________________________________________________________________________
+// path_work_stealing_dequet
+
+path_storaget::patht &path_work_stealing_dequet::private_peek()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return lifo ? paths.back() : paths.front();
+}
+
+void path_work_stealing_dequet::push(const path_storaget::patht &path)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  paths.push_back(path);
+  ++pushes;
+}
+
+void path_work_stealing_dequet::private_pop()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if(lifo)
+    paths.pop_back();
+  else
+    paths.pop_front();
+}
+
+std::size_t path_work_stealing_dequet::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return paths.size();
+}
+
+void path_work_stealing_dequet::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  paths.clear();
+}
+
+std::size_t path_work_stealing_dequet::number_of_pushes() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return pushes;
+}
+
+bool path_work_stealing_dequet::take(std::list<patht> &dest)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if(paths.empty())
+    return false;
+  dest.splice(dest.end(), paths, lifo ? std::prev(paths.end()) : paths.begin());
+  return true;
+}
+
+bool path_work_stealing_dequet::steal(std::list<patht> &dest)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if(paths.empty())
+    return false;
+  dest.splice(dest.end(), paths, paths.begin());
+  return true;
+}
+
+// _____________________________________________________________________________
+// path_priority_queuet
+
+/// Path conditions larger than this are considered equally expensive
+static const std::size_t max_path_condition_size = 1 << 16;
+
+/// \return the largest number of unwindings of any loop or recursion on the
+///   call stack of the current thread of \p state
+static std::size_t unwinding_depth(const goto_symex_statet &state)
+{
+  std::size_t depth = 0;
+
+  for(const auto &frame : state.call_stack())
+  {
+    for(const auto &loop : frame.loop_iterations)
+      depth = std::max<std::size_t>(depth, loop.second.count);
+  }
+
+  return depth;
+}
+
+double path_priority_queuet::score(const entryt &entry) const
+{
+  const auto found = resumes.find(entry.location);
+  const std::size_t previous_resumes =
+    found == resumes.end() ? 0 : found->second;
+
+  return entry.fixed_score +
+         weights.coverage / static_cast<double>(1 + previous_resumes);
+}
+
+void path_priority_queuet::push(const path_storaget::patht &path)
+{
+  const std::size_t path_condition_size =
+    complexity_limitert::bounded_expr_size(
+      path.state.guard.as_expr(), max_path_condition_size);
+
+  entryt entry;
+  entry.fixed_score =
+    -weights.unwinding * static_cast<double>(unwinding_depth(path.state)) -
+    weights.equation_size *
+      std::log2(1.0 + static_cast<double>(path.equation.SSA_steps.size())) -
+    weights.solver_cost *
+      std::log2(1.0 + static_cast<double>(path_condition_size));
+  entry.location = path.state.saved_target;
+  entry.path = std::make_unique<patht>(path);
+
+  const double initial_score = score(entry);
+  paths.emplace(keyt{initial_score, pushes++}, std::move(entry));
+
+  spill();
+}
+
+void path_priority_queuet::spill()
+{
+  if(max_paths_in_memory == 0 || !recreate_path)
+    return;
+
+  const std::size_t peeked = next && next->path ? 1 : 0;
+
+  while(!paths.empty() && paths.size() + peeked > max_paths_in_memory)
+  {
+    auto node = paths.extract(paths.begin());
+    node.mapped().branches = node.mapped().path->state.saved_branches;
+    node.mapped().path.reset();
+    spilled_paths.insert(std::move(node));
+    ++spills;
+  }
+}
+
+path_storaget::patht &path_priority_queuet::private_peek()
+{
+  if(next)
+    return *next->path;
+
+  while(true)
+  {
+    const bool take_spilled =
+      !spilled_paths.empty() &&
+      (paths.empty() || paths.rbegin()->first < spilled_paths.rbegin()->first);
+    queuet &queue = take_spilled ? spilled_paths : paths;
+    const auto best = std::prev(queue.end());
+
+    // the score may have dropped since it was computed, in which case
+    // another path may be the better choice now
+    const double current_score = score(best->second);
+    if(current_score < best->first.first)
+    {
+      auto node = queue.extract(best);
+      node.key().first = current_score;
+      queue.insert(std::move(node));
+      continue;
+    }
+
+    next = std::make_unique<entryt>(std::move(best->second));
+    queue.erase(best);
+    break;
+  }
+
+  ++resumes[next->location];
+
+  if(!next->path)
+  {
+    next->path = recreate_path(next->branches);
+    CHECK_RETURN(next->path != nullptr);
+    spill();
+  }
+
+  return *next->path;
+}
+
+void path_priority_queuet::private_pop()
+{
+  PRECONDITION(next != nullptr);
+  next.reset();
+}
+
+std::size_t path_priority_queuet::size() const
+{
+  return paths.size() + spilled_paths.size() + (next ? 1 : 0);
+}
+
+void path_priority_queuet::clear()
+{
+  paths.clear();
+  spilled_paths.clear();
+  next.reset();
+}
+
 // _____________________________________________________________________________
 // path_strategy_choosert
 
@@ -88,14 +284,14 @@ static const std::map<
   const std::string,
   std::pair<
     const std::string,
-    const std::function<std::unique_ptr<path_storaget>()>>>
+    const std::function<std::unique_ptr<path_storaget>(const optionst &)>>>
   path_strategies(
     {{"lifo",
       {" lifo                         next instruction is pushed before\n"
        "                              goto target; paths are popped in\n"
        "                              last-in, first-out order. Explores\n"
        "                              the program tree depth-first.\n",
-       []() { // NOLINT(whitespace/braces)
+       [](const optionst &) { // NOLINT(whitespace/braces)
          return std::make_unique<path_lifot>();
        }}},
      {"fifo",
@@ -103,8 +299,27 @@ static const std::map<
        "                              goto target; paths are popped in\n"
        "                              first-in, first-out order. Explores\n"
        "                              the program tree breadth-first.\n",
-       []() { // NOLINT(whitespace/braces)
+       [](const optionst &) { // NOLINT(whitespace/braces)
          return std::make_unique<path_fifot>();
+       }}},
+     {"coverage",
+      {" coverage                     paths resuming at locations that no\n"
+       "                              path has been resumed at yet are\n"
+       "                              popped first, while paths deep in\n"
+       "                              loops are popped last.\n",
+       [](const optionst &options) { // NOLINT(whitespace/braces)
+         return std::make_unique<path_priority_queuet>(
+           path_priority_queuet::weightst{8.0, 1.0, 0.25, 0.25},
+           options.get_unsigned_int_option("paths-in-memory"));
+       }}},
+     {"cost",
+      {" cost                         paths with small equations and\n"
+       "                              path conditions, which are likely\n"
+       "                              cheap to solve, are popped first.\n",
+       [](const optionst &options) { // NOLINT(whitespace/braces)
+         return std::make_unique<path_priority_queuet>(
+           path_priority_queuet::weightst{1.0, 0.5, 1.0, 1.0},
+           options.get_unsigned_int_option("paths-in-memory"));
        }}}});
 
 std::string show_path_strategies()
@@ -126,11 +341,17 @@ bool is_valid_path_strategy(const std::string strategy)
 }
 
 std::unique_ptr<path_storaget> get_path_strategy(const std::string strategy)
+{
+  return get_path_strategy(strategy, optionst{});
+}
+
+std::unique_ptr<path_storaget>
+get_path_strategy(const std::string strategy, const optionst &options)
 {
   auto found = path_strategies.find(strategy);
   INVARIANT(
     found != path_strategies.end(), "Unknown strategy '" + strategy + "'.");
-  return found->second.second();
+  return found->second.second(options);
 }
 
 void parse_path_strategy_options(
@@ -157,4 +378,18 @@ void parse_path_strategy_options(
   {
     options.set_option("exploration-strategy", default_path_strategy());
   }
+
+  if(cmdline.isset("paths-in-memory"))
+  {
+    // only the priority queues re-create paths that they dropped
+    const std::string strategy = options.get_option("exploration-strategy");
+    if(strategy != "coverage" && strategy != "cost")
+    {
+      log.error() << "--paths-in-memory requires --paths coverage or "
+                     "--paths cost, but the strategy is '"
+                  << strategy << "'" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("paths-in-memory", cmdline.get_value("paths-in-memory"));
+  }
 }
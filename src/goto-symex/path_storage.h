@@ -13,7 +13,12 @@
 #include "goto_symex_state.h"
 #include "symex_target_equation.h"
 
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 
 class cmdlinet;
 class optionst;
@@ -24,8 +29,16 @@ class symex_nondet_generatort
 public:
   nondet_symbol_exprt operator()(typet type, source_locationt location);
 
+  /// Continue numbering with the counter of \p other, which from then on is
+  /// shared by both generators, also when they are used by different threads
+  void share_counter_with(const symex_nondet_generatort &other)
+  {
+    nondet_count = other.nondet_count;
+  }
+
 private:
-  std::size_t nondet_count = 0;
+  std::shared_ptr<std::atomic<std::size_t>> nondet_count =
+    std::make_shared<std::atomic<std::size_t>>(0);
 };
 
 /// \brief Storage for symbolic execution paths to be resumed later
@@ -93,6 +106,12 @@ class path_storaget
   /// Counter for nondet objects, which require unique names
   symex_nondet_generatort build_symex_nondet;
 
+  /// Re-creates a path from the branches it took at the GOTOs at which paths
+  /// were saved, see \ref goto_symex_statet::saved_branches. If set, storages
+  /// may use this to keep only some of their paths in memory.
+  std::function<std::unique_ptr<patht>(const std::vector<bool> &)>
+    recreate_path;
+
   /// Map function identifiers to \ref local_safe_pointerst instances. This is
   /// to identify derferences that are guaranteed to be safe in a given
   /// execution context, thus helping to avoid symex to follow spurious
@@ -103,12 +122,23 @@ class path_storaget
   /// \p minimum_index.
   std::size_t get_unique_l1_index(const irep_idt &id, std::size_t minimum_index)
   {
-    return get_unique_index(l1_indices, id, minimum_index);
+    return get_unique_index(unique_indices->l1_indices, id, minimum_index);
   }
 
   std::size_t get_unique_l2_index(const irep_idt &id)
   {
-    return get_unique_index(l2_indices, id, 1);
+    return get_unique_index(unique_indices->l2_indices, id, 1);
+  }
+
+  /// Hand out L1 and L2 indices and nondet symbols from the same counters as
+  /// \p other, such that paths can move between the two storages. From then
+  /// on the counters are protected by a lock, as the storages may be used by
+  /// different threads. Must be called before any such thread is started.
+  void share_unique_names_with(path_storaget &other)
+  {
+    other.unique_indices->shared = true;
+    unique_indices = other.unique_indices;
+    build_symex_nondet.share_counter_with(other.build_symex_nondet);
   }
 
   /// Local variables are considered 'dirty' if they've had an address taken and
@@ -149,6 +179,10 @@ class path_storaget
     const irep_idt &id,
     std::size_t minimum_index)
   {
+    std::unique_lock<std::mutex> lock(unique_indices->mutex, std::defer_lock);
+    if(unique_indices->shared)
+      lock.lock();
+
     auto entry = unique_index_map.emplace(id, minimum_index);
 
     if(!entry.second)
@@ -157,9 +191,18 @@ class path_storaget
     return entry.first->second;
   }
 
-  /// Storage used by \ref get_unique_index.
-  name_index_mapt l1_indices;
-  name_index_mapt l2_indices;
+  /// Storage used by \ref get_unique_index, which may be shared with other
+  /// path storages, see \ref share_unique_names_with.
+  struct unique_indicest
+  {
+    name_index_mapt l1_indices;
+    name_index_mapt l2_indices;
+    bool shared = false;
+    std::mutex mutex;
+  };
+
+  std::shared_ptr<unique_indicest> unique_indices =
+    std::make_shared<unique_indicest>();
 };
 
 /// \brief LIFO save queue: depth-first search, try to finish paths
@@ -195,6 +238,147 @@ class path_fifot : public path_storaget
   void private_pop() override;
 };
 
+/// \brief Paths of one of several threads that explore paths in parallel
+///
+/// The owning thread resumes its paths in last-in, first-out order
+/// (depth-first) or in first-in, first-out order. Threads that have run out
+/// of paths steal the oldest path of another thread, which is closest to the
+/// root of the program tree and hence likely to lead to most further work.
+/// All operations take a lock. Paths are moved out of the storage before they
+/// are resumed, as another thread might steal them otherwise.
+class path_work_stealing_dequet : public path_storaget
+{
+public:
+  explicit path_work_stealing_dequet(bool lifo) : lifo(lifo)
+  {
+  }
+
+  void push(const patht &) override;
+  std::size_t size() const override;
+  void clear() override;
+
+  /// Move the next path to be resumed by the owning thread to the end of
+  /// \p dest
+  /// \return false if there is no path
+  bool take(std::list<patht> &dest);
+
+  /// Move the oldest path to the end of \p dest
+  /// \return false if there is no path
+  bool steal(std::list<patht> &dest);
+
+  /// \brief How many paths have been pushed so far?
+  std::size_t number_of_pushes() const;
+
+protected:
+  const bool lifo;
+  mutable std::mutex mutex;
+  std::list<patht> paths;
+  std::size_t pushes = 0;
+
+private:
+  patht &private_peek() override;
+  void private_pop() override;
+};
+
+/// \brief Priority queue of paths, ordered by a score that favours paths that
+/// are likely to cover new code at a low cost
+///
+/// The score of a path that resumes at location `l` is
+///
+///     coverage / (1 + r) - unwinding * u
+///       - equation_size * log2(1 + e) - solver_cost * log2(1 + g)
+///
+/// where `r` is the number of paths that have been resumed at `l` so far, `u`
+/// is the largest number of unwindings of any loop or recursion on the call
+/// stack, `e` is the number of SSA steps and `g` is the size of the path
+/// condition, bounded as in \ref complexity_limitert::bounded_expr_size.
+/// Paths with equal scores are resumed in last-in, first-out order. As scores
+/// only ever decrease, the score of a path is only re-computed when the path
+/// is the best candidate to be resumed next.
+///
+/// Given a bound on the number of paths to keep in memory, and provided that
+/// \ref path_storaget::recreate_path is set, paths with the lowest scores
+/// beyond that bound are reduced to the branches they took and are re-created
+/// when they are to be resumed.
+class path_priority_queuet : public path_storaget
+{
+public:
+  /// Factors of the terms of the score
+  struct weightst
+  {
+    double coverage;
+    double unwinding;
+    double equation_size;
+    double solver_cost;
+  };
+
+  /// \param weights: factors of the terms of the score
+  /// \param max_paths_in_memory: number of paths to keep in memory, or zero
+  ///   to keep all of them
+  path_priority_queuet(
+    const weightst &weights,
+    std::size_t max_paths_in_memory)
+    : weights(weights), max_paths_in_memory(max_paths_in_memory)
+  {
+  }
+
+  void push(const patht &) override;
+  std::size_t size() const override;
+  void clear() override;
+
+  /// \brief How many paths have been reduced to the branches they took?
+  std::size_t number_of_spilled_paths() const
+  {
+    return spills;
+  }
+
+protected:
+  struct entryt
+  {
+    /// The score without the coverage term, which changes over time
+    double fixed_score;
+    /// The location at which the path resumes
+    goto_programt::const_targett location;
+    /// The path, or nullptr if only its \ref branches are kept
+    std::unique_ptr<patht> path;
+    std::vector<bool> branches;
+  };
+
+  /// An upper bound of the score, and the number of the push such that of
+  /// paths with equal scores the one pushed last comes last
+  typedef std::pair<double, std::size_t> keyt;
+  typedef std::map<keyt, entryt> queuet;
+
+  const weightst weights;
+  const std::size_t max_paths_in_memory;
+
+  queuet paths;
+  queuet spilled_paths;
+
+  /// The path that has been peeked at, which is kept out of the queues as
+  /// symex pushes further paths while it is being resumed
+  std::unique_ptr<entryt> next;
+
+  std::size_t pushes = 0;
+  std::size_t spills = 0;
+
+  std::map<
+    goto_programt::const_targett,
+    std::size_t,
+    goto_programt::target_less_than>
+    resumes;
+
+  double score(const entryt &) const;
+
+  /// Reduce paths with the lowest scores to the branches they took until
+  /// at most \ref max_paths_in_memory paths are left in memory
+  void spill();
+
+private:
+  patht &private_peek() override;
+  void private_pop() override;
+};
+
 /// \brief suitable for displaying as a front-end help message
 std::string show_path_strategies();
 
@@ -205,8 +389,14 @@ bool is_valid_path_strategy(const std::string strategy);
 /// particular string before calling this function on that string.
 std::unique_ptr<path_storaget> get_path_strategy(const std::string strategy);
 
-/// \brief add `paths` and `exploration-strategy` option, suitable to be
-/// invoked from front-ends.
+/// As above, configuring the storage using \p options, such as
+/// `paths-in-memory`
+std::unique_ptr<path_storaget>
+get_path_strategy(const std::string strategy, const optionst &options);
+
+/// \brief add `paths`, `exploration-strategy` and `paths-in-memory` options,
+/// suitable to be invoked from front-ends. Exits with a usage error if
+/// `paths-in-memory` is given for a strategy other than coverage or cost.
 void parse_path_strategy_options(
   const cmdlinet &,
   optionst &,
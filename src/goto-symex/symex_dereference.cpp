@@ -320,21 +320,38 @@ void goto_symext::dereference_rec(
 
     tmp1 = state.field_sensitivity.apply(ns, state, std::move(tmp1), false);
 
-    // we need to set up some elaborate call-backs
-    symex_dereference_statet symex_dereference_state(state, ns);
-
-    value_set_dereferencet dereference(
-      ns,
-      state.symbol_table,
-      symex_dereference_state,
-      language_mode,
-      expr_is_not_null,
-      log.get_message_handler());
-
-    // std::cout << "**** " << format(tmp1) << '\n';
-    exprt tmp2 =
-      dereference.dereference(tmp1, symex_config.show_points_to_sets);
-    // std::cout << "**** " << format(tmp2) << '\n';
+    // Dereferencing a pointer symbol only depends on the pointer's value set,
+    // so an earlier result can be re-used while that value set is unchanged.
+    const bool memoise =
+      is_ssa_expr(tmp1) && !symex_config.show_points_to_sets;
+    std::optional<exprt> memoised;
+    if(memoise)
+      memoised = state.find_dereference(to_ssa_expr(tmp1), expr_is_not_null);
+
+    exprt tmp2;
+
+    if(memoised.has_value())
+      tmp2 = std::move(*memoised);
+    else
+    {
+      // we need to set up some elaborate call-backs
+      symex_dereference_statet symex_dereference_state(state, ns);
+
+      value_set_dereferencet dereference(
+        ns,
+        state.symbol_table,
+        symex_dereference_state,
+        language_mode,
+        expr_is_not_null,
+        log.get_message_handler());
+
+      // std::cout << "**** " << format(tmp1) << '\n';
+      tmp2 = dereference.dereference(tmp1, symex_config.show_points_to_sets);
+      // std::cout << "**** " << format(tmp2) << '\n';
+
+      if(memoise)
+        state.record_dereference(to_ssa_expr(tmp1), expr_is_not_null, tmp2);
+    }
 
 
     // this may yield a new auto-object
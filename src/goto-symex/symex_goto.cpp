@@ -410,10 +410,12 @@ void goto_symext::symex_goto(statet &state)
     path_storaget::patht next_instruction(target, state);
     next_instruction.state.saved_target = state_pc;
     next_instruction.state.has_saved_next_instruction = true;
+    next_instruction.state.saved_branches.push_back(false);
 
     path_storaget::patht jump_target(target, state);
     jump_target.state.saved_target = new_state_pc;
     jump_target.state.has_saved_jump_target = true;
+    jump_target.state.saved_branches.push_back(true);
     // `forward` tells us where the branch we're _currently_ executing is
     // pointing to; this needs to be inverted for the branch that we're saving,
     // so let its truth value for `backwards` be the same as ours for `forward`.
@@ -708,6 +710,9 @@ void goto_symext::merge_goto(
       // merge value sets
       state.value_set.make_union(goto_state.value_set);
 
+      // keep the dereferences of either branch that are still valid
+      state.merge_dereferences(goto_state);
+
       // adjust depth
       state.depth = std::min(state.depth, goto_state.depth);
     }
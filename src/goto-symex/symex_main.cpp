@@ -329,7 +329,8 @@ symbol_tablet goto_symext::symex_with_state(
   // that's needed to achieve a reset upon exiting this method
   struct reset_namespacet
   {
-    explicit reset_namespacet(namespacet &ns) : ns(ns)
+    reset_namespacet(namespacet &ns, simplify_exprt &simplifier)
+      : ns(ns), simplifier(simplifier)
     {
     }
 
@@ -340,9 +341,12 @@ symbol_tablet goto_symext::symex_with_state(
       // Move a new namespace containing this symbol table over the top of the
       // current one
       ns = namespacet(st);
+      // results cached for the previous namespace may no longer be valid
+      simplifier.clear_cache();
     }
 
     namespacet &ns;
+    simplify_exprt &simplifier;
   };
 
   // We'll be using ns during symbolic execution and it needs to know
@@ -350,10 +354,11 @@ symbol_tablet goto_symext::symex_with_state(
   // `state`'s symbol table and the symbol table of the original
   // goto-program.
   ns = namespacet(outer_symbol_table, state.symbol_table);
+  simplifier.clear_cache();
 
   // whichever way we exit this method, reset the namespace back to a sane state
   // as state.symbol_table might go out of scope
-  reset_namespacet reset_ns(ns);
+  reset_namespacet reset_ns(ns, simplifier);
 
   PRECONDITION(state.call_stack().top().end_of_function->is_end_function());
 
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <list>
 
+#include <util/chunked_vector.h>
 #include <util/invariant.h>
 #include <util/merge_irep.h>
 #include <util/message.h>
@@ -247,18 +248,30 @@ class symex_target_equationt:public symex_targett
       }));
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  /// Expressions entering the equation are merged such that structurally
+  /// identical expressions share their representation.
+  /// \return the number of distinct expression nodes
+  std::size_t count_merged_ireps() const
+  {
+    return merge_irep.size();
+  }
+
+  /// \return the number of expression nodes that were replaced by a shared
+  ///   one when entering the equation
+  std::size_t count_merged_duplicates() const
+  {
+    return merge_irep.number_of_merged();
+  }
+
+  /// The steps are stored in chunks of contiguous memory; iterators are
+  /// index-based and remain valid when further steps are added.
+  typedef chunked_vectort<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
-    SSA_stepst::iterator it=SSA_steps.begin();
-    for(; s!=0; s--)
-    {
-      PRECONDITION(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    PRECONDITION(s <= SSA_steps.size());
+    return SSA_steps.begin() + s;
   }
 
   void output(std::ostream &out) const;
@@ -296,11 +309,4 @@ class symex_target_equationt:public symex_targett
   std::size_t argument_count = 0;
 };
 
-inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a)<&(*b);
-}
-
 #endif // CPROVER_GOTO_SYMEX_SYMEX_TARGET_EQUATION_H
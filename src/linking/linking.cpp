@@ -42,26 +42,44 @@ static const typet &follow_tags_symbols(
 irep_idt
 linkingt::rename(const symbol_table_baset &src_symbol_table, const irep_idt &id)
 {
-  unsigned cnt=0;
+  const auto make_identifier = [&id](std::size_t cnt) -> irep_idt {
+    return id2string(id) + "$link" + std::to_string(cnt);
+  };
 
-  while(true)
-  {
-    irep_idt new_identifier=
-      id2string(id)+"$link"+std::to_string(++cnt);
+  const auto is_used = [&](std::size_t cnt) {
+    const irep_idt new_identifier = make_identifier(cnt);
+
+    if(main_symbol_table.has_symbol(new_identifier))
+      return true; // already in main symbol table
 
-    if(main_symbol_table.symbols.find(new_identifier)!=
-       main_symbol_table.symbols.end())
-      continue; // already in main symbol table
+    if(renamed_ids.find(new_identifier) != renamed_ids.end())
+      return true; // used this for renaming already
 
-    if(!renamed_ids.insert(new_identifier).second)
-      continue; // used this for renaming already
+    // used by some earlier linking call already
+    return src_symbol_table.has_symbol(new_identifier);
+  };
 
-    if(src_symbol_table.symbols.find(new_identifier)!=
-       src_symbol_table.symbols.end())
-      continue; // used by some earlier linking call already
+  // Suffixes are typically used from 1 onwards without gaps. When linking
+  // many files that all have the same file-local symbol, trying one suffix
+  // after the other would take quadratic time, hence we search for an unused
+  // suffix exponentially and then by bisection.
+  std::size_t upper = 1;
+  while(is_used(upper))
+    upper *= 2;
 
-    return new_identifier;
+  std::size_t lower = upper / 2; // 0, or a used suffix
+  while(upper - lower > 1)
+  {
+    const std::size_t middle = lower + (upper - lower) / 2;
+    if(is_used(middle))
+      lower = middle;
+    else
+      upper = middle;
   }
+
+  const irep_idt new_identifier = make_identifier(upper);
+  renamed_ids.insert(new_identifier);
+  return new_identifier;
 }
 
 linkingt::renamingt linkingt::needs_renaming_non_type(
@@ -1039,6 +1057,9 @@ void linkingt::copy_symbols(
   }
 
   // Apply type updates to initializers
+  if(object_type_updates.empty())
+    return;
+
   for(auto it = main_symbol_table.begin(); it != main_symbol_table.end(); ++it)
   {
     if(
@@ -1101,17 +1122,22 @@ bool linkingt::link(const symbol_table_baset &src_symbol_table)
     }
   }
 
-  // rename within main symbol table
-  for(auto &symbol_pair : main_symbol_table)
+  // rename within main symbol table; when linking many files, symbols of the
+  // main symbol table rarely need to be renamed, and walking the (growing)
+  // main symbol table for each file would make linking quadratic
+  if(!rename_main_symbol.empty())
   {
-    symbolt tmp = symbol_pair.second;
-    bool unmodified = rename_main_symbol(tmp.value);
-    unmodified &= rename_main_symbol(tmp.type);
-    if(!unmodified)
+    for(auto &symbol_pair : main_symbol_table)
     {
-      symbolt *sym_ptr = main_symbol_table.get_writeable(symbol_pair.first);
-      CHECK_RETURN(sym_ptr);
-      *sym_ptr = std::move(tmp);
+      symbolt tmp = symbol_pair.second;
+      bool unmodified = rename_main_symbol(tmp.value);
+      unmodified &= rename_main_symbol(tmp.type);
+      if(!unmodified)
+      {
+        symbolt *sym_ptr = main_symbol_table.get_writeable(symbol_pair.first);
+        CHECK_RETURN(sym_ptr);
+        *sym_ptr = std::move(tmp);
+      }
     }
   }
 
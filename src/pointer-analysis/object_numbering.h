@@ -25,6 +25,68 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/expr.h>
 #include <util/numbering.h>
 
+#if IREP_ATOMIC_REF_COUNT
+
+#  include <shared_mutex>
+#  include <unordered_map>
+#  include <vector>
+
+/// With IREP_ATOMIC_REF_COUNT, symbolic execution may run on several threads,
+/// and all value sets share a single numbering of objects. This numbering
+/// therefore protects its tables with a lock and returns objects by value, as
+/// another thread may add an object at any time.
+class object_numberingt final
+{
+public:
+  using number_type = std::size_t; // NOLINT
+  using key_type = exprt;          // NOLINT
+
+  number_type number(const exprt &a)
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex);
+      const auto it = numbers.find(a);
+      if(it != numbers.end())
+        return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    const auto result = numbers.emplace(a, number_type(numbers.size()));
+
+    if(result.second) // inserted?
+      data.push_back(a);
+
+    return result.first->second;
+  }
+
+  exprt at(number_type t) const
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return data.at(t);
+  }
+
+  exprt operator[](number_type t) const
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return data[t];
+  }
+
+  std::size_t size() const
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return data.size();
+  }
+
+private:
+  mutable std::shared_mutex mutex;
+  std::vector<exprt> data;
+  std::unordered_map<exprt, number_type, irep_hash> numbers;
+};
+
+#else
+
 typedef numberingt<exprt, irep_hash> object_numberingt;
 
+#endif
+
 #endif // CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
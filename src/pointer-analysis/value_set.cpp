@@ -323,17 +323,56 @@ bool value_sett::make_union_would_change(
 
 bool value_sett::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
+  if(dest.get_d() == src.get_d() || !make_union_would_change(dest, src))
+    return false;
 
-  for(object_map_dt::const_iterator it=src.read().begin();
-      it!=src.read().end();
-      it++)
+  if(dest.read().empty())
   {
-    if(insert(dest, *it))
-      result=true;
+    dest = src;
+    return true;
   }
 
-  return result;
+  // Both maps are ordered by object number, so they can be merged in a single
+  // pass, with the same result as inserting the elements of src one by one.
+  const object_map_dt &dest_map = dest.read();
+  const object_map_dt &src_map = src.read();
+  object_map_dt result;
+#if OBJECT_MAP_IS_SORTED_VECTOR
+  result.reserve(dest_map.size() + src_map.size());
+#endif
+
+  auto dest_it = dest_map.begin();
+  auto src_it = src_map.begin();
+  while(dest_it != dest_map.end() || src_it != src_map.end())
+  {
+    if(
+      src_it == src_map.end() ||
+      (dest_it != dest_map.end() && dest_it->first < src_it->first))
+    {
+      result.emplace_hint(result.end(), dest_it->first, dest_it->second);
+      ++dest_it;
+    }
+    else if(dest_it == dest_map.end() || src_it->first < dest_it->first)
+    {
+      result.emplace_hint(result.end(), src_it->first, src_it->second);
+      ++src_it;
+    }
+    else
+    {
+      // an object with different offsets has an unknown offset
+      offsett offset = dest_it->second;
+      if(offset && (!src_it->second || *offset != *src_it->second))
+        offset.reset();
+      result.emplace_hint(result.end(), dest_it->first, std::move(offset));
+      ++dest_it;
+      ++src_it;
+    }
+  }
+
+  // don't copy the old elements just to replace them
+  dest.clear();
+  dest.write().swap(result);
+  return true;
 }
 
 bool value_sett::eval_pointer_offset(
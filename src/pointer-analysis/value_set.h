@@ -18,6 +18,19 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/reference_counting.h>
 #include <util/sharing_map.h>
 
+// Store the objects of each value set in a sorted vector by default: unions
+// of value sets, as done at every merge of states, then walk over contiguous
+// memory instead of chasing the pointers of a tree.
+#ifndef OBJECT_MAP_IS_SORTED_VECTOR
+#  define OBJECT_MAP_IS_SORTED_VECTOR 1
+#endif
+
+#if OBJECT_MAP_IS_SORTED_VECTOR
+#  include <util/sorted_vector_as_map.h>
+#else
+#  include <map>
+#endif
+
 #include "object_numbering.h"
 #include "value_sets.h"
 
@@ -85,7 +98,12 @@ class value_sett
   /// the enclosing `value_sett`, such as `{ null, dynamic_object1 }`.
   /// The set is represented as a map from numbered `exprt`s to `offsett`
   /// instead of a set of pairs to make lookup by `exprt` easier.
+#if OBJECT_MAP_IS_SORTED_VECTOR
+  using object_map_dt =
+    sorted_vector_as_mapt<object_numberingt::number_type, offsett>;
+#else
   using object_map_dt = std::map<object_numberingt::number_type, offsett>;
+#endif
 
   static const object_map_dt empty_object_map;
 
@@ -0,0 +1,159 @@
+/*******************************************************************\
+
+Module: Micro-benchmark for Binary Decision Diagrams
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Micro-benchmark for the BDD library selected in bdd.h, which is miniBDD
+/// unless CBMC is built with CUDD. Build it with `make -C src/solvers
+/// bdd_benchmark` (or the `bdd_benchmark` CMake target) once with and once
+/// without CUDD to compare the two. As the benchmark only uses the interface
+/// of bdd.h, it can also be built at earlier revisions to compare different
+/// versions of miniBDD.
+///
+/// Usage: bdd_benchmark [n-queens size] [number of guard operations]
+
+#include "bdd.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/// The classic n-queens problem: the BDD of all placements of \p n queens on
+/// an \p n by \p n board such that no queen attacks another one.
+static bddt queens(bdd_managert &mgr, std::size_t n)
+{
+  auto square = [&mgr, n](std::size_t row, std::size_t column) {
+    return mgr.bdd_variable(row * n + column);
+  };
+
+  bddt result = mgr.bdd_true();
+
+  for(std::size_t row = 0; row < n; ++row)
+  {
+    // at least one queen in each row
+    bddt some = mgr.bdd_false();
+    for(std::size_t column = 0; column < n; ++column)
+      some = some.bdd_or(square(row, column));
+    result = result.bdd_and(some);
+
+    for(std::size_t column = 0; column < n; ++column)
+    {
+      // a queen on this square rules out all squares it attacks
+      bddt free = mgr.bdd_true();
+      for(std::size_t r = 0; r < n; ++r)
+      {
+        for(std::size_t c = 0; c < n; ++c)
+        {
+          if(r == row && c == column)
+            continue;
+          const bool attacked = r == row || c == column ||
+                                r + column == c + row || r + c == row + column;
+          if(attacked)
+            free = free.bdd_and(square(r, c).bdd_not());
+        }
+      }
+      result = result.bdd_and(square(row, column).bdd_not().bdd_or(free));
+    }
+  }
+
+  return result;
+}
+
+/// Manipulate guards the way symbolic execution does with BDD guards: at
+/// each branch the guard of the current path is split by a branch condition,
+/// assumptions strengthen it, and the paths are joined again in the reverse
+/// order of the branches.
+/// \return the number of paths that were found to be infeasible
+static std::size_t guards(bdd_managert &mgr, std::size_t operations)
+{
+  const std::size_t number_of_variables = 64;
+  const std::size_t maximum_depth = 24;
+
+  std::mt19937 random(42);
+  auto condition = [&mgr, &random]() {
+    const bddt variable = mgr.bdd_variable(random() % number_of_variables);
+    return random() % 2 == 0 ? variable : variable.bdd_not();
+  };
+
+  bddt guard = mgr.bdd_true();
+  std::vector<bddt> other_paths;
+  std::size_t infeasible_paths = 0;
+
+  for(std::size_t i = 0; i < operations; ++i)
+  {
+    const auto choice = random() % 4;
+    if(choice == 0 && other_paths.size() < maximum_depth)
+    {
+      // branch
+      const bddt branch_condition = condition();
+      other_paths.push_back(guard.bdd_and(branch_condition.bdd_not()));
+      guard = guard.bdd_and(branch_condition);
+    }
+    else if(choice == 1)
+    {
+      // assumption
+      guard = guard.bdd_and(condition());
+    }
+    else if(!other_paths.empty())
+    {
+      // join
+      guard = guard.bdd_or(other_paths.back());
+      other_paths.pop_back();
+    }
+    else
+    {
+      // all paths have been joined: start over with the next function
+      guard = mgr.bdd_true();
+    }
+
+    if(guard.is_false())
+    {
+      // continue with the path that was saved last
+      ++infeasible_paths;
+      if(other_paths.empty())
+        guard = mgr.bdd_true();
+      else
+      {
+        guard = other_paths.back();
+        other_paths.pop_back();
+      }
+    }
+  }
+
+  return infeasible_paths;
+}
+
+int main(int argc, const char **argv)
+{
+  const std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+  const std::size_t operations =
+    argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+
+  {
+    bdd_managert mgr;
+    const auto start = std::chrono::steady_clock::now();
+    const bool has_solution = !queens(mgr, n).is_false();
+    const auto stop = std::chrono::steady_clock::now();
+    std::cout << n << "-queens: "
+              << std::chrono::duration<double>(stop - start).count() << "s"
+              << (has_solution ? "" : " (no solution)") << '\n';
+  }
+
+  {
+    bdd_managert mgr;
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t infeasible_paths = guards(mgr, operations);
+    const auto stop = std::chrono::steady_clock::now();
+    std::cout << operations << " guard operations: "
+              << std::chrono::duration<double>(stop - start).count() << "s ("
+              << infeasible_paths << " infeasible paths)\n";
+  }
+
+  return 0;
+}
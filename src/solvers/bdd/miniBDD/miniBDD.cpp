@@ -15,8 +15,13 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/invariant.h>
 
+#include <algorithm>
 #include <iostream>
 
+/// Garbage is only collected once there are this many nodes without
+/// references, see mini_bdd_mgrt::dead_nodes
+static const std::size_t min_dead_nodes_to_collect = 1 << 12;
+
 void mini_bdd_nodet::remove_reference()
 {
   PRECONDITION_WITH_DIAGNOSTICS(
@@ -24,13 +29,47 @@ void mini_bdd_nodet::remove_reference()
 
   reference_counter--;
 
-  if(reference_counter == 0 && node_number >= 2)
+  if(reference_counter != 0 || node_number < 2)
+    return;
+
+  // The node is kept until the next garbage collection, as it may be needed
+  // again before then, but no longer references its successors. This is done
+  // without recursion, as BDDs may be deep.
+  std::stack<mini_bdd_nodet *> stack;
+  stack.push(this);
+
+  while(!stack.empty())
+  {
+    mini_bdd_nodet &n = *stack.top();
+    stack.pop();
+    mgr->dead_nodes++;
+
+    for(mini_bdd_nodet *successor : {n.low.node, n.high.node})
+    {
+      successor->reference_counter--;
+      if(successor->reference_counter == 0 && successor->node_number >= 2)
+        stack.push(successor);
+    }
+  }
+}
+
+void mini_bdd_nodet::revive()
+{
+  std::stack<mini_bdd_nodet *> stack;
+  stack.push(this);
+
+  while(!stack.empty())
   {
-    mini_bdd_mgrt::reverse_keyt reverse_key(var, low, high);
-    mgr->reverse_map.erase(reverse_key);
-    low.clear();
-    high.clear();
-    mgr->free.push(this);
+    mini_bdd_nodet &n = *stack.top();
+    stack.pop();
+    mgr->dead_nodes--;
+
+    for(mini_bdd_nodet *successor : {n.low.node, n.high.node})
+    {
+      successor->reference_counter++;
+      if(successor->reference_counter == 1 && successor->node_number >= 2)
+        stack.push(successor);
+    }
   }
 }
 
@@ -184,7 +223,8 @@ void mini_bdd_mgrt::DumpTikZ(
 class mini_bdd_applyt
 {
 public:
-  inline explicit mini_bdd_applyt(bool (*_fkt)(bool, bool)) : fkt(_fkt)
+  inline explicit mini_bdd_applyt(mini_bdd_mgrt::operationt _operation)
+    : operation(_operation)
   {
   }
 
@@ -194,46 +234,95 @@ class mini_bdd_applyt
   }
 
 protected:
-  bool (*fkt)(bool, bool);
-  mini_bddt APP_rec(const mini_bddt &x, const mini_bddt &y);
+  const mini_bdd_mgrt::operationt operation;
+  bool evaluate(bool x, bool y) const;
+  bool terminal_case(const mini_bddt &x, const mini_bddt &y, mini_bddt &result)
+    const;
   mini_bddt APP_non_rec(const mini_bddt &x, const mini_bddt &y);
-
-  typedef std::map<std::pair<unsigned, unsigned>, mini_bddt> Gt;
-  Gt G;
 };
 
-mini_bddt mini_bdd_applyt::APP_rec(const mini_bddt &x, const mini_bddt &y)
+bool mini_bdd_applyt::evaluate(bool x, bool y) const
 {
-  PRECONDITION_WITH_DIAGNOSTICS(
-    x.is_initialized() && y.is_initialized(),
-    "apply can only be called on initialized BDDs");
-  PRECONDITION_WITH_DIAGNOSTICS(
-    x.node->mgr == y.node->mgr,
-    "apply can only be called on BDDs with the same manager");
-
-  // dynamic programming
-  std::pair<unsigned, unsigned> key(x.node_number(), y.node_number());
-  Gt::const_iterator G_it = G.find(key);
-  if(G_it != G.end())
-    return G_it->second;
+  switch(operation)
+  {
+  case mini_bdd_mgrt::operationt::AND:
+    return x && y;
+  case mini_bdd_mgrt::operationt::OR:
+    return x || y;
+  case mini_bdd_mgrt::operationt::XOR:
+    return x != y;
+  case mini_bdd_mgrt::operationt::EQUAL:
+    return x == y;
+  case mini_bdd_mgrt::operationt::NONE:
+    break;
+  }
 
-  mini_bdd_mgrt *mgr = x.node->mgr;
+  UNREACHABLE;
+}
 
-  mini_bddt u;
+/// Compute the result of applying the operation to \p x and \p y into
+/// \p result without recursion, if possible
+/// \return true if the result was computed
+bool mini_bdd_applyt::terminal_case(
+  const mini_bddt &x,
+  const mini_bddt &y,
+  mini_bddt &result) const
+{
+  const mini_bdd_mgrt &mgr = *x.node->mgr;
 
   if(x.is_constant() && y.is_constant())
-    u = mini_bddt(fkt(x.is_true(), y.is_true()) ? mgr->True() : mgr->False());
-  else if(x.var() == y.var())
-    u =
-      mgr->mk(x.var(), APP_rec(x.low(), y.low()), APP_rec(x.high(), y.high()));
-  else if(x.var() < y.var())
-    u = mgr->mk(x.var(), APP_rec(x.low(), y), APP_rec(x.high(), y));
-  else /* x.var() > y.var() */
-    u = mgr->mk(y.var(), APP_rec(x, y.low()), APP_rec(x, y.high()));
+  {
+    result = evaluate(x.is_true(), y.is_true()) ? mgr.True() : mgr.False();
+    return true;
+  }
 
-  G[key] = u;
+  switch(operation)
+  {
+  case mini_bdd_mgrt::operationt::AND:
+    if(x.is_false() || y.is_true() || x.node == y.node)
+      result = x;
+    else if(y.is_false() || x.is_true())
+      result = y;
+    else
+      return false;
+    return true;
 
-  return u;
+  case mini_bdd_mgrt::operationt::OR:
+    if(x.is_true() || y.is_false() || x.node == y.node)
+      result = x;
+    else if(y.is_true() || x.is_false())
+      result = y;
+    else
+      return false;
+    return true;
+
+  case mini_bdd_mgrt::operationt::XOR:
+    if(x.node == y.node)
+      result = mgr.False();
+    else if(y.is_false())
+      result = x;
+    else if(x.is_false())
+      result = y;
+    else
+      return false;
+    return true;
+
+  case mini_bdd_mgrt::operationt::EQUAL:
+    if(x.node == y.node)
+      result = mgr.True();
+    else if(y.is_true())
+      result = x;
+    else if(x.is_true())
+      result = y;
+    else
+      return false;
+    return true;
+
+  case mini_bdd_mgrt::operationt::NONE:
+    break;
+  }
+
+  UNREACHABLE;
 }
 
 mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
@@ -241,16 +330,10 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
   struct stack_elementt
   {
     stack_elementt(mini_bddt &_result, const mini_bddt &_x, const mini_bddt &_y)
-      : result(_result),
-        x(_x),
-        y(_y),
-        key(x.node_number(), y.node_number()),
-        var(0),
-        phase(phaset::INIT)
+      : result(_result), x(_x), y(_y), var(0), phase(phaset::INIT)
     {
     }
     mini_bddt &result, x, y, lr, hr;
-    std::pair<unsigned, unsigned> key;
     unsigned var;
     enum class phaset
     {
@@ -277,78 +360,85 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
       x.node->mgr == y.node->mgr,
       "apply can only be called on BDDs with the same manager");
 
+    mini_bdd_mgrt &mgr = *x.node->mgr;
+
     switch(t.phase)
     {
     case stack_elementt::phaset::INIT:
     {
-      // dynamic programming
-      Gt::const_iterator G_it = G.find(t.key);
-      if(G_it != G.end())
+      if(terminal_case(x, y, t.result))
+      {
+        stack.pop();
+        break;
+      }
+
+      // dynamic programming, all operations are commutative
+      const unsigned first = std::min(x.node_number(), y.node_number());
+      const unsigned second = std::max(x.node_number(), y.node_number());
+      const auto &entry = mgr.computed_table_entry(operation, first, second);
+      if(
+        entry.operation == operation && entry.x == first &&
+        entry.y == second)
       {
-        t.result = G_it->second;
+        t.result = mini_bddt(&mgr.nodes[entry.result]);
         stack.pop();
       }
-      else
+      else if(x.var() == y.var())
       {
-        if(x.is_constant() && y.is_constant())
-        {
-          bool result_truth = fkt(x.is_true(), y.is_true());
-          const mini_bdd_mgrt &mgr = *x.node->mgr;
-          t.result = result_truth ? mgr.True() : mgr.False();
-          stack.pop();
-        }
-        else if(x.var() == y.var())
-        {
-          t.var = x.var();
-          t.phase = stack_elementt::phaset::FINISH;
-
-          INVARIANT(
-            x.low().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            y.low().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            x.high().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            y.high().var() > t.var, "applying won't break variable order");
-
-          stack.push(stack_elementt(t.lr, x.low(), y.low()));
-          stack.push(stack_elementt(t.hr, x.high(), y.high()));
-        }
-        else if(x.var() < y.var())
-        {
-          t.var = x.var();
-          t.phase = stack_elementt::phaset::FINISH;
-
-          INVARIANT(
-            x.low().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            x.high().var() > t.var, "applying won't break variable order");
-
-          stack.push(stack_elementt(t.lr, x.low(), y));
-          stack.push(stack_elementt(t.hr, x.high(), y));
-        }
-        else /* x.var() > y.var() */
-        {
-          t.var = y.var();
-          t.phase = stack_elementt::phaset::FINISH;
-
-          INVARIANT(
-            y.low().var() > t.var, "applying won't break variable order");
-          INVARIANT(
-            y.high().var() > t.var, "applying won't break variable order");
-
-          stack.push(stack_elementt(t.lr, x, y.low()));
-          stack.push(stack_elementt(t.hr, x, y.high()));
-        }
+        t.var = x.var();
+        t.phase = stack_elementt::phaset::FINISH;
+
+        INVARIANT(
+          x.low().var() > t.var, "applying won't break variable order");
+        INVARIANT(
+          y.low().var() > t.var, "applying won't break variable order");
+        INVARIANT(
+          x.high().var() > t.var, "applying won't break variable order");
+        INVARIANT(
+          y.high().var() > t.var, "applying won't break variable order");
+
+        stack.push(stack_elementt(t.lr, x.low(), y.low()));
+        stack.push(stack_elementt(t.hr, x.high(), y.high()));
+      }
+      else if(x.var() < y.var())
+      {
+        t.var = x.var();
+        t.phase = stack_elementt::phaset::FINISH;
+
+        INVARIANT(
+          x.low().var() > t.var, "applying won't break variable order");
+        INVARIANT(
+          x.high().var() > t.var, "applying won't break variable order");
+
+        stack.push(stack_elementt(t.lr, x.low(), y));
+        stack.push(stack_elementt(t.hr, x.high(), y));
+      }
+      else /* x.var() > y.var() */
+      {
+        t.var = y.var();
+        t.phase = stack_elementt::phaset::FINISH;
+
+        INVARIANT(
+          y.low().var() > t.var, "applying won't break variable order");
+        INVARIANT(
+          y.high().var() > t.var, "applying won't break variable order");
+
+        stack.push(stack_elementt(t.lr, x, y.low()));
+        stack.push(stack_elementt(t.hr, x, y.high()));
       }
     }
     break;
 
     case stack_elementt::phaset::FINISH:
     {
-      mini_bdd_mgrt *mgr = x.node->mgr;
-      t.result = mgr->mk(t.var, t.lr, t.hr);
-      G[t.key] = t.result;
+      t.result = mgr.mk(t.var, t.lr, t.hr);
+      const unsigned first = std::min(x.node_number(), y.node_number());
+      const unsigned second = std::max(x.node_number(), y.node_number());
+      auto &entry = mgr.computed_table_entry(operation, first, second);
+      entry.operation = operation;
+      entry.x = first;
+      entry.y = second;
+      entry.result = t.result.node_number();
       stack.pop();
     }
     break;
@@ -361,24 +451,14 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
   return u;
 }
 
-bool equal_fkt(bool x, bool y)
-{
-  return x == y;
-}
-
 mini_bddt mini_bddt::operator==(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(equal_fkt)(*this, other);
-}
-
-bool xor_fkt(bool x, bool y)
-{
-  return x ^ y;
+  return mini_bdd_applyt(mini_bdd_mgrt::operationt::EQUAL)(*this, other);
 }
 
 mini_bddt mini_bddt::operator^(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(xor_fkt)(*this, other);
+  return mini_bdd_applyt(mini_bdd_mgrt::operationt::XOR)(*this, other);
 }
 
 mini_bddt mini_bddt::operator!() const
@@ -388,24 +468,14 @@ mini_bddt mini_bddt::operator!() const
   return node->mgr->True() ^ *this;
 }
 
-bool and_fkt(bool x, bool y)
-{
-  return x && y;
-}
-
 mini_bddt mini_bddt::operator&(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(and_fkt)(*this, other);
-}
-
-bool or_fkt(bool x, bool y)
-{
-  return x || y;
+  return mini_bdd_applyt(mini_bdd_mgrt::operationt::AND)(*this, other);
 }
 
 mini_bddt mini_bddt::operator|(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(or_fkt)(*this, other);
+  return mini_bdd_applyt(mini_bdd_mgrt::operationt::OR)(*this, other);
 }
 
 mini_bdd_mgrt::mini_bdd_mgrt()
@@ -419,6 +489,13 @@ mini_bdd_mgrt::mini_bdd_mgrt()
 
 mini_bdd_mgrt::~mini_bdd_mgrt()
 {
+  // the nodes may be destroyed in any order, hence they must not remove their
+  // references to each other
+  for(auto &n : nodes)
+  {
+    n.low.node = nullptr;
+    n.high.node = nullptr;
+  }
 }
 
 mini_bddt
@@ -443,12 +520,16 @@ mini_bdd_mgrt::mk(unsigned var, const mini_bddt &low, const mini_bddt &high)
       return mini_bddt(it->second);
     else
     {
+      if(dead_nodes > std::max(number_of_nodes(), min_dead_nodes_to_collect))
+        collect_garbage();
+
       mini_bdd_nodet *n;
 
       if(free.empty())
       {
         unsigned new_number = nodes.back().node_number + 1;
-        nodes.push_back(mini_bdd_nodet(this, var, new_number, low, high));
+        nodes.push_back(
+          mini_bdd_nodet(this, var, new_number, mini_bddt(), mini_bddt()));
         n = &nodes.back();
       }
       else // reuse a node
@@ -456,31 +537,82 @@ mini_bdd_mgrt::mk(unsigned var, const mini_bddt &low, const mini_bddt &high)
         n = free.top();
         free.pop();
         n->var = var;
-        n->low = low;
-        n->high = high;
       }
 
-      reverse_map[reverse_key] = n;
+      // The node starts out without references, and hence without referencing
+      // its successors, until it is returned.
+      n->low.node = low.node;
+      n->high.node = high.node;
+      dead_nodes++;
+      reverse_map.emplace(reverse_key, n);
       return mini_bddt(n);
     }
   }
 }
 
+std::size_t mini_bdd_mgrt::collect_garbage()
+{
+  std::size_t freed = 0;
+
+  for(auto &n : nodes)
+  {
+    // nodes on the free list have no successors
+    if(n.node_number >= 2 && n.reference_counter == 0 && n.low.is_initialized())
+    {
+      reverse_map.erase(reverse_keyt(n.var, n.low, n.high));
+
+      // the references to the successors were removed when the node lost its
+      // last reference
+      n.low.node = nullptr;
+      n.high.node = nullptr;
+
+      free.push(&n);
+      freed++;
+    }
+  }
+
+  dead_nodes = 0;
+
+  // node numbers may now be re-used
+  for(auto &entry : computed_table)
+    entry.operation = operationt::NONE;
+
+  return freed;
+}
+
+mini_bdd_mgrt::computed_table_entryt &mini_bdd_mgrt::computed_table_entry(
+  operationt operation,
+  unsigned x,
+  unsigned y)
+{
+  // grow the table with the number of nodes, up to 2^22 entries, keeping its
+  // size a power of two
+  if(computed_table.size() < nodes.size() && computed_table.size() < (1 << 22))
+  {
+    std::size_t size = 1 << 10;
+    while(size < 2 * nodes.size() && size < (1 << 22))
+      size *= 2;
+    computed_table.clear();
+    computed_table.resize(size);
+  }
+
+  const std::size_t hash = static_cast<std::size_t>(operation) * 1000003 ^
+                           std::size_t{x} * 12582917 ^ std::size_t{y} * 4256249;
+
+  return computed_table[(hash ^ (hash >> 16)) & (computed_table.size() - 1)];
+}
+
 bool mini_bdd_mgrt::reverse_keyt::
-operator<(const mini_bdd_mgrt::reverse_keyt &y) const
+operator==(const mini_bdd_mgrt::reverse_keyt &other) const
 {
-  const reverse_keyt &x = *this;
+  return var == other.var && low == other.low && high == other.high;
+}
 
-  if(x.var < y.var)
-    return true;
-  else if(x.var > y.var)
-    return false;
-  else if(x.low < y.low)
-    return true;
-  else if(x.low > y.low)
-    return false;
-  else
-    return x.high < y.high;
+std::size_t mini_bdd_mgrt::reverse_key_hasht::
+operator()(const mini_bdd_mgrt::reverse_keyt &key) const
+{
+  return std::size_t{key.var} * 1000003 ^ std::size_t{key.low} * 12582917 ^
+         std::size_t{key.high} * 4256249;
 }
 
 void mini_bdd_mgrt::DumpTable(std::ostream &out) const
@@ -21,10 +21,11 @@ Author: Daniel Kroening, kroening@kroening.com
  * \date   Mon Sep 28 00:00:00 BST 2009
 */
 
-#include <list>
+#include <deque>
 #include <map>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class mini_bddt
@@ -80,6 +81,11 @@ class mini_bdd_nodet
 
   void add_reference();
   void remove_reference();
+
+protected:
+  // A node without references does not hold references to its successors,
+  // which hence may lose their last reference, too.
+  void revive();
 };
 
 class mini_bdd_mgrt
@@ -101,12 +107,19 @@ class mini_bdd_mgrt
   const mini_bddt &False() const;
 
   friend class mini_bdd_nodet;
+  friend class mini_bdd_applyt;
 
   // create a node (consulting the reverse-map)
   mini_bddt mk(unsigned var, const mini_bddt &low, const mini_bddt &high);
 
+  /// \return the number of nodes that are referenced
   std::size_t number_of_nodes();
 
+  /// Free the nodes that are no longer referenced. This also empties the
+  /// computed table, as node numbers may then be re-used.
+  /// \return the number of nodes that were freed
+  std::size_t collect_garbage();
+
   struct var_table_entryt
   {
     std::string label;
@@ -116,8 +129,19 @@ class mini_bdd_mgrt
   typedef std::vector<var_table_entryt> var_tablet;
   var_tablet var_table;
 
+  /// Operations whose results are kept in the computed table
+  enum class operationt : unsigned
+  {
+    NONE,
+    AND,
+    OR,
+    XOR,
+    EQUAL
+  };
+
 protected:
-  typedef std::list<mini_bdd_nodet> nodest;
+  // nodes are indexed by their node number and never move
+  typedef std::deque<mini_bdd_nodet> nodest;
   nodest nodes;
   mini_bddt true_bdd, false_bdd;
 
@@ -127,14 +151,40 @@ class mini_bdd_mgrt
     unsigned var, low, high;
     reverse_keyt(unsigned _var, const mini_bddt &_low, const mini_bddt &_high);
 
-    bool operator<(const reverse_keyt &) const;
+    bool operator==(const reverse_keyt &) const;
   };
 
-  typedef std::map<reverse_keyt, mini_bdd_nodet *> reverse_mapt;
+  struct reverse_key_hasht
+  {
+    std::size_t operator()(const reverse_keyt &) const;
+  };
+
+  typedef std::unordered_map<reverse_keyt, mini_bdd_nodet *, reverse_key_hasht>
+    reverse_mapt;
   reverse_mapt reverse_map;
 
   typedef std::stack<mini_bdd_nodet *> freet;
   freet free;
+
+  /// The number of nodes in the reverse-map without any references. These are
+  /// kept, such that \ref mk or the computed table can revive them, until
+  /// \ref mk collects garbage once there are more of them than nodes that are
+  /// referenced.
+  std::size_t dead_nodes = 0;
+
+  /// Results of earlier operations, which are kept across operations. An
+  /// entry is overwritten by any later result with the same hash.
+  struct computed_table_entryt
+  {
+    operationt operation = operationt::NONE;
+    unsigned x = 0, y = 0, result = 0;
+  };
+
+  typedef std::vector<computed_table_entryt> computed_tablet;
+  computed_tablet computed_table;
+
+  computed_table_entryt &
+  computed_table_entry(operationt operation, unsigned x, unsigned y);
 };
 
 mini_bddt restrict(const mini_bddt &u, unsigned var, const bool value);
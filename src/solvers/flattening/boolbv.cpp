@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/bitvector_types.h>
 #include <util/byte_operators.h>
 #include <util/config.h>
+#include <util/find_symbols.h>
 #include <util/floatbv_expr.h>
 #include <util/magic.h>
 #include <util/mp_arith.h>
@@ -50,6 +51,7 @@ const bvt &boolbvt::convert_bv(
   if(!cache_result.second)
   {
     // Found in cache
+    ++common_subterms;
     return cache_entry;
   }
 
@@ -82,11 +84,14 @@ const bvt &boolbvt::convert_bv(
 
 exprt boolbvt::handle(const exprt &expr)
 {
-  if(expr.type().id() == ID_bool)
-    return prop_conv_solvert::handle(expr);
-  auto bv = convert_bv(expr);
+  const exprt preprocessed =
+    word_level_preprocessing ? preprocessor(expr) : expr;
+
+  if(preprocessed.type().id() == ID_bool)
+    return prop_conv_solvert::handle(preprocessed);
+  auto bv = convert_bv(preprocessed);
   set_frozen(bv); // for incremental usage
-  return literal_vector_exprt{bv, expr.type()};
+  return literal_vector_exprt{bv, preprocessed.type()};
 }
 
 /// Print that the expression of x has failed conversion,
@@ -302,6 +307,9 @@ bvt boolbvt::convert_symbol(const exprt &expr)
   const irep_idt &identifier = expr.get(ID_identifier);
   CHECK_RETURN(!identifier.empty());
 
+  if(!pending_definitions.empty())
+    convert_pending_definition(identifier);
+
   bvt bv = map.get_literals(identifier, type, width);
 
   INVARIANT_WITH_DIAGNOSTICS(
@@ -522,12 +530,139 @@ void boolbvt::set_to(const exprt &expr, bool value)
 {
   PRECONDITION(expr.is_boolean());
 
+  // Equalities only hold globally in the root context.
+  if(word_level_preprocessing && assumption_stack.empty())
+  {
+    set_to_preprocessed(expr, value);
+    return;
+  }
+
   const auto equal_expr = expr_try_dynamic_cast<equal_exprt>(expr);
   if(value && equal_expr && !boolbv_set_equality_to_true(*equal_expr))
     return;
   SUB::set_to(expr, value);
 }
 
+void boolbvt::set_to_preprocessed(const exprt &expr, bool value)
+{
+  const auto equal_expr = expr_try_dynamic_cast<equal_exprt>(expr);
+
+  if(
+    value && equal_expr && equal_expr->lhs().id() == ID_symbol &&
+    equal_expr->lhs().type() == equal_expr->rhs().type() &&
+    !preprocessor.has_substitution(
+      to_symbol_expr(equal_expr->lhs()).get_identifier()))
+  {
+    // a definition of a symbol
+    const symbol_exprt &symbol = to_symbol_expr(equal_expr->lhs());
+    const irep_idt &identifier = symbol.get_identifier();
+    exprt rhs = preprocessor(equal_expr->rhs());
+    preprocessor.add_equality(symbol, rhs);
+
+    if(pending_definitions.find(identifier) != pending_definitions.end())
+      convert_pending_definition(identifier);
+    else if(can_defer_definition(symbol, rhs))
+    {
+      find_symbols(rhs, pending_dependencies);
+      pending_definitions.emplace(identifier, equal_exprt{symbol, rhs});
+      ++deferred_definitions;
+      return;
+    }
+
+    const equal_exprt definition{symbol, std::move(rhs)};
+    if(boolbv_set_equality_to_true(definition))
+      SUB::set_to(definition, true);
+    return;
+  }
+
+  const exprt preprocessed = preprocessor(expr);
+  const auto preprocessed_equal_expr =
+    expr_try_dynamic_cast<equal_exprt>(preprocessed);
+  if(value && preprocessed_equal_expr)
+  {
+    // the equality may map a symbol whose definition is still pending
+    if(preprocessed_equal_expr->lhs().id() == ID_symbol)
+    {
+      convert_pending_definition(
+        to_symbol_expr(preprocessed_equal_expr->lhs()).get_identifier());
+    }
+
+    if(!boolbv_set_equality_to_true(*preprocessed_equal_expr))
+      return;
+  }
+  SUB::set_to(preprocessed, value);
+}
+
+/// A definition can be deferred if its conversion only consists of mapping
+/// the symbol to the literals of the value, see
+/// \ref boolbv_set_equality_to_true, and the symbol has not been used yet.
+bool boolbvt::can_defer_definition(
+  const symbol_exprt &symbol,
+  const exprt &value) const
+{
+  const typet &type = symbol.type();
+
+  return equality_propagation && type.id() != ID_bool &&
+         type.id() != ID_pointer && !is_unbounded_array(type) &&
+         !map.get_map_entry(symbol.get_identifier()).has_value() &&
+         pending_dependencies.find(symbol.get_identifier()) ==
+           pending_dependencies.end() &&
+         !has_symbol_expr(value, symbol.get_identifier(), false);
+}
+
+/// Convert the pending definition of \p identifier, if any, after the
+/// pending definitions that it depends on. Chains of definitions may be
+/// long, so this does not recurse.
+void boolbvt::convert_pending_definition(const irep_idt &identifier)
+{
+  if(pending_definitions.find(identifier) == pending_definitions.end())
+    return;
+
+  // identifiers, and whether their dependencies have been pushed already
+  std::vector<std::pair<irep_idt, bool>> stack{{identifier, false}};
+
+  while(!stack.empty())
+  {
+    const auto top = stack.back();
+    stack.pop_back();
+
+    const auto entry = pending_definitions.find(top.first);
+    if(entry == pending_definitions.end())
+      continue;
+
+    if(!top.second)
+    {
+      stack.emplace_back(top.first, true);
+      for(const auto &dependency : find_symbol_identifiers(entry->second.rhs()))
+      {
+        if(pending_definitions.find(dependency) != pending_definitions.end())
+          stack.emplace_back(dependency, false);
+      }
+    }
+    else
+    {
+      const equal_exprt definition = std::move(entry->second);
+      pending_definitions.erase(entry);
+
+      if(boolbv_set_equality_to_true(definition))
+        SUB::set_to(definition, true);
+    }
+  }
+}
+
+void boolbvt::output_preprocessing_statistics()
+{
+  const auto &statistics = preprocessor.get_statistics();
+  log.statistics() << "Word-level preprocessing: " << statistics.constants
+                   << " constants and " << statistics.equalities
+                   << " equalities propagated, " << statistics.width_reductions
+                   << " operations narrowed, " << pending_definitions.size()
+                   << " of " << deferred_definitions
+                   << " deferred definitions unconstrained, "
+                   << common_subterms << " common subterms shared"
+                   << messaget::eom;
+}
+
 bool boolbvt::is_unbounded_array(const typet &type) const
 {
   if(type.id()!=ID_array)
@@ -17,6 +17,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/endianness_map.h>
 #include <util/expr.h>
 #include <util/mp_arith.h>
+#include <util/std_expr.h>
+
+#include <unordered_set>
 
 #include <solvers/lowering/functions.h>
 
@@ -24,6 +27,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "boolbv_map.h"
 #include "boolbv_width.h"
 #include "bv_utils.h" // IWYU pragma: keep
+#include "word_level_preprocessor.h"
 
 class binary_overflow_exprt;
 class bitreverse_exprt;
@@ -55,7 +59,8 @@ class boolbvt:public arrayst
       bv_width(_ns),
       bv_utils(_prop),
       functions(*this),
-      map(_prop)
+      map(_prop),
+      preprocessor(_ns)
   {
   }
 
@@ -66,6 +71,7 @@ class boolbvt:public arrayst
   virtual bvt convert_bitvector(const exprt &expr); // no cache
 
   // overloading
+  resultt dec_solve(const exprt &) override;
   exprt get(const exprt &expr) const override;
   void set_to(const exprt &expr, bool value) override;
   void print_assignment(std::ostream &out) const override;
@@ -82,11 +88,27 @@ class boolbvt:public arrayst
     finish_eager_conversion_quantifiers();
     functions.finish_eager_conversion();
     SUB::finish_eager_conversion();
+    if(word_level_preprocessing)
+      output_preprocessing_statistics();
   }
 
   enum class unbounded_arrayt { U_NONE, U_ALL, U_AUTO };
   unbounded_arrayt unbounded_array;
 
+  /// Simplify constraints with \ref word_level_preprocessort before
+  /// bit-blasting them, and only bit-blast the definition of a symbol once
+  /// the symbol is used elsewhere. Definitions of symbols that are never
+  /// used are unconstrained and thus eliminated; the values of these
+  /// symbols are computed from their definitions by \ref get.
+  bool word_level_preprocessing = false;
+
+  /// Over-approximate integer multiplication, division and remainder with
+  /// non-constant operands by fresh variables, and only add the full
+  /// circuit for an operation once a satisfying assignment violates its
+  /// semantics. Multipliers and dividers that are irrelevant for the
+  /// outcome are then never bit-blasted.
+  bool lazy_arithmetic = false;
+
   mp_integer get_value(const bvt &bv)
   {
     return get_value(bv, 0, bv.size());
@@ -134,6 +156,48 @@ class boolbvt:public arrayst
   typedef std::unordered_map<const exprt, bvt, irep_hash> bv_cachet;
   bv_cachet bv_cache;
 
+  // word-level preprocessing
+  word_level_preprocessort preprocessor;
+
+  /// definitions of symbols, by identifier, that are yet to be converted
+  std::unordered_map<irep_idt, equal_exprt> pending_definitions;
+  /// symbols that occur in pending definitions, which cannot be deferred
+  /// themselves without risking cyclic definitions
+  std::unordered_set<irep_idt> pending_dependencies;
+  std::size_t deferred_definitions = 0;
+  std::size_t common_subterms = 0;
+
+  /// values of symbols with pending definitions in the current model
+  mutable std::unordered_map<irep_idt, exprt> pending_values;
+  mutable std::size_t pending_values_solver_calls = 0;
+
+  void set_to_preprocessed(const exprt &expr, bool value);
+  bool can_defer_definition(const symbol_exprt &symbol, const exprt &value)
+    const;
+  void convert_pending_definition(const irep_idt &identifier);
+  exprt get_pending_definition(const irep_idt &identifier) const;
+  void output_preprocessing_statistics();
+
+  // lazy arithmetic
+  struct lazy_operationt
+  {
+    irep_idt id;
+    bv_utilst::representationt rep;
+    bvt op0, op1, result;
+    bool encoded = false;
+  };
+
+  std::vector<lazy_operationt> lazy_operations;
+  std::size_t lazy_refinement_iterations = 0;
+
+  bvt convert_lazy_operation(
+    const irep_idt &id,
+    const bvt &op0,
+    const bvt &op1,
+    bv_utilst::representationt rep);
+  bool refine_lazy_operations();
+  void output_lazy_arithmetic_statistics();
+
   bool type_conversion(
     const typet &src_type, const bvt &src,
     const typet &dest_type, bvt &dest);
@@ -54,6 +54,9 @@ bvt boolbvt::convert_div(const div_exprt &expr)
       expr.type().id()==ID_signedbv?bv_utilst::representationt::SIGNED:
                                     bv_utilst::representationt::UNSIGNED;
 
+    if(lazy_arithmetic && !bv_utilst::is_constant(op1))
+      return convert_lazy_operation(ID_div, op0, op1, rep);
+
     bv_utils.divider(op0, op1, res, rem, rep);
   }
 
@@ -8,6 +8,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/arith_tools.h>
 #include <util/c_types.h>
+#include <util/expr_initializer.h>
+#include <util/find_symbols.h>
 #include <util/namespace.h>
 #include <util/simplify_expr.h>
 #include <util/std_expr.h>
@@ -44,11 +46,92 @@ exprt boolbvt::get(const exprt &expr) const
         return bv_get_rec(skeleton, map_entry.literal_map, 0);
       }
     }
+
+    if(pending_definitions.find(identifier) != pending_definitions.end())
+      return get_pending_definition(identifier);
+
+    // consistent with the values of pending definitions that use it
+    if(
+      pending_dependencies.find(identifier) != pending_dependencies.end() &&
+      symbols.find(identifier) == symbols.end())
+    {
+      const auto zero =
+        zero_initializer(expr.type(), expr.source_location(), ns);
+      if(zero.has_value())
+        return *zero;
+    }
   }
 
   return SUB::get(expr);
 }
 
+/// Compute the value of a symbol whose definition has not been converted
+/// from the values of the symbols in its definition. Symbols that have
+/// not been converted either are unconstrained and taken to be zero.
+exprt boolbvt::get_pending_definition(const irep_idt &identifier) const
+{
+  if(pending_values_solver_calls != get_number_of_solver_calls())
+  {
+    pending_values.clear();
+    pending_values_solver_calls = get_number_of_solver_calls();
+  }
+
+  // evaluate the definitions that this one depends on first
+  std::vector<std::pair<irep_idt, bool>> stack{{identifier, false}};
+
+  while(!stack.empty())
+  {
+    const auto top = stack.back();
+    stack.pop_back();
+
+    if(pending_values.find(top.first) != pending_values.end())
+      continue;
+
+    const exprt &rhs = pending_definitions.at(top.first).rhs();
+
+    if(!top.second)
+    {
+      stack.emplace_back(top.first, true);
+      for(const auto &dependency : find_symbol_identifiers(rhs))
+      {
+        if(
+          pending_definitions.find(dependency) != pending_definitions.end() &&
+          pending_values.find(dependency) == pending_values.end())
+        {
+          stack.emplace_back(dependency, false);
+        }
+      }
+      continue;
+    }
+
+    exprt value = rhs;
+    value.visit_pre([this](exprt &node) {
+      if(node.id() != ID_symbol && node.id() != ID_nondet_symbol)
+        return;
+
+      const irep_idt &node_identifier = node.get(ID_identifier);
+      const auto pending_value = pending_values.find(node_identifier);
+
+      if(pending_value != pending_values.end())
+        node = pending_value->second;
+      else if(
+        !map.get_map_entry(node_identifier).has_value() &&
+        symbols.find(node_identifier) == symbols.end() &&
+        pending_definitions.find(node_identifier) == pending_definitions.end())
+      {
+        const auto zero =
+          zero_initializer(node.type(), node.source_location(), ns);
+        if(zero.has_value())
+          node = *zero;
+      }
+    });
+
+    pending_values[top.first] = simplify_expr(get(value), ns);
+  }
+
+  return pending_values.at(identifier);
+}
+
 exprt boolbvt::bv_get_rec(const exprt &expr, const bvt &bv, std::size_t offset)
   const
 {
@@ -0,0 +1,166 @@
+/*******************************************************************\
+
+Module: Lazy Encoding of Multiplication and Division
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Lazy encoding of multiplication and division
+
+#include "boolbv.h"
+
+#include <util/arith_tools.h>
+
+#include <algorithm>
+
+/// Results of operations with fresh variables, which only satisfy simple
+/// properties of the operation, and the full circuit is added by
+/// \ref boolbvt::refine_lazy_operations when needed.
+bvt boolbvt::convert_lazy_operation(
+  const irep_idt &id,
+  const bvt &op0,
+  const bvt &op1,
+  bv_utilst::representationt rep)
+{
+  PRECONDITION(op0.size() == op1.size());
+
+  lazy_operationt operation;
+  operation.id = id;
+  operation.rep = rep;
+  operation.op0 = op0;
+  operation.op1 = op1;
+  operation.result = prop.new_variables(op0.size());
+
+  // the circuit may be added after solving
+  set_frozen(operation.op0);
+  set_frozen(operation.op1);
+  set_frozen(operation.result);
+
+  if(id == ID_mult)
+  {
+    // x*0==0 and 0*x==0
+    literalt op0_zero = bv_utils.is_zero(op0);
+    literalt op1_zero = bv_utils.is_zero(op1);
+    literalt res_zero = bv_utils.is_zero(operation.result);
+    prop.l_set_to_true(prop.limplies(prop.lor(op0_zero, op1_zero), res_zero));
+
+    // x*1==x and 1*x==x
+    prop.l_set_to_true(prop.limplies(
+      bv_utils.is_one(op0), bv_utils.equal(op1, operation.result)));
+    prop.l_set_to_true(prop.limplies(
+      bv_utils.is_one(op1), bv_utils.equal(op0, operation.result)));
+  }
+
+  lazy_operations.push_back(std::move(operation));
+  return lazy_operations.back().result;
+}
+
+/// \return \p value, which is read as an unsigned number, in the two's
+///   complement interpretation if \p is_signed
+static mp_integer
+interpret(const mp_integer &value, std::size_t width, bool is_signed)
+{
+  if(is_signed && value >= power(2, width - 1))
+    return value - power(2, width);
+  return value;
+}
+
+/// Add the full circuit for every lazily encoded operation whose result in
+/// the current satisfying assignment is wrong.
+/// \return true if any circuit was added
+bool boolbvt::refine_lazy_operations()
+{
+  std::vector<std::size_t> spurious;
+
+  // get all values before modifying the formula
+  for(std::size_t i = 0; i < lazy_operations.size(); ++i)
+  {
+    const lazy_operationt &operation = lazy_operations[i];
+    if(operation.encoded)
+      continue;
+
+    const std::size_t width = operation.result.size();
+    const bool is_signed = operation.rep == bv_utilst::representationt::SIGNED;
+    const mp_integer op0 =
+      interpret(get_value(operation.op0), width, is_signed);
+    const mp_integer op1 =
+      interpret(get_value(operation.op1), width, is_signed);
+
+    // the result of division by zero is unconstrained
+    if(operation.id != ID_mult && op1 == 0)
+      continue;
+
+    mp_integer expected;
+    if(operation.id == ID_mult)
+      expected = op0 * op1;
+    else if(operation.id == ID_div)
+      expected = op0 / op1;
+    else if(operation.id == ID_mod)
+      expected = op0 % op1;
+    else
+      UNREACHABLE;
+
+    const mp_integer modulus = power(2, width);
+    expected %= modulus;
+    if(expected < 0)
+      expected += modulus;
+
+    if(get_value(operation.result) != expected)
+      spurious.push_back(i);
+  }
+
+  for(const std::size_t i : spurious)
+  {
+    lazy_operationt &operation = lazy_operations[i];
+
+    bvt circuit;
+    if(operation.id == ID_mult)
+      circuit = bv_utils.multiplier(operation.op0, operation.op1, operation.rep);
+    else
+    {
+      bvt res, rem;
+      bv_utils.divider(operation.op0, operation.op1, res, rem, operation.rep);
+      circuit = operation.id == ID_div ? res : rem;
+    }
+
+    bv_utils.set_equal(circuit, operation.result);
+    operation.encoded = true;
+  }
+
+  return !spurious.empty();
+}
+
+decision_proceduret::resultt boolbvt::dec_solve(const exprt &assumption)
+{
+  while(true)
+  {
+    const resultt result = SUB::dec_solve(assumption);
+
+    if(result != resultt::D_SATISFIABLE || !refine_lazy_operations())
+    {
+      if(!lazy_operations.empty())
+        output_lazy_arithmetic_statistics();
+      return result;
+    }
+
+    ++lazy_refinement_iterations;
+    log.progress() << "Lazy arithmetic: satisfying assignment is spurious, "
+                   << "refining" << messaget::eom;
+  }
+}
+
+void boolbvt::output_lazy_arithmetic_statistics()
+{
+  const std::size_t encoded = std::count_if(
+    lazy_operations.begin(),
+    lazy_operations.end(),
+    [](const lazy_operationt &operation) { return operation.encoded; });
+
+  log.statistics() << "Lazy arithmetic: " << encoded << " of "
+                   << lazy_operations.size()
+                   << " multiplications and divisions bit-blasted after "
+                   << lazy_refinement_iterations << " refinement iterations"
+                   << messaget::eom;
+}
@@ -41,6 +41,9 @@ bvt boolbvt::convert_mod(const mod_exprt &expr)
   const bvt &dividend_bv = convert_bv(expr.dividend(), width);
   const bvt &divisor_bv = convert_bv(expr.divisor(), width);
 
+  if(lazy_arithmetic && !bv_utilst::is_constant(divisor_bv))
+    return convert_lazy_operation(ID_mod, dividend_bv, divisor_bv, rep);
+
   bvt res, rem;
 
   bv_utils.divider(dividend_bv, divisor_bv, res, rem, rep);
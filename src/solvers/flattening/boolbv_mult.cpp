@@ -73,7 +73,14 @@ bvt boolbvt::convert_mult(const mult_exprt &expr)
 
       const bvt &op = convert_bv(*it, width);
 
-      bv = bv_utils.multiplier(bv, op, rep);
+      if(
+        lazy_arithmetic && !bv_utilst::is_constant(bv) &&
+        !bv_utilst::is_constant(op))
+      {
+        bv = convert_lazy_operation(ID_mult, bv, op, rep);
+      }
+      else
+        bv = bv_utils.multiplier(bv, op, rep);
     }
 
     return bv;
@@ -0,0 +1,288 @@
+/*******************************************************************\
+
+Module: Word-Level Preprocessing
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Word-level simplification of constraints before bit-blasting
+
+#include "word_level_preprocessor.h"
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+
+#include <utility>
+
+static bool is_integer_bitvector(const typet &type)
+{
+  return type.id() == ID_signedbv || type.id() == ID_unsignedbv;
+}
+
+/// \return the operand of a typecast from a narrower integer type, or
+///   nullptr if \p expr is not such a typecast
+static const exprt *extended_operand(const exprt &expr)
+{
+  if(expr.id() != ID_typecast)
+    return nullptr;
+
+  const exprt &op = to_typecast_expr(expr).op();
+  if(!is_integer_bitvector(expr.type()) || !is_integer_bitvector(op.type()))
+    return nullptr;
+
+  if(
+    to_bitvector_type(op.type()).get_width() >=
+    to_bitvector_type(expr.type()).get_width())
+  {
+    return nullptr;
+  }
+
+  return &op;
+}
+
+/// \return true if sign or zero extension from the type of \p op to
+///   \p type preserves the order of values
+static bool preserves_order(const exprt &op, const typet &type)
+{
+  return op.type().id() == ID_unsignedbv || type.id() == ID_signedbv;
+}
+
+bool word_level_preprocessort::add_equality(
+  const symbol_exprt &symbol,
+  const exprt &value)
+{
+  if(value.type() != symbol.type() || has_substitution(symbol.get_identifier()))
+    return false;
+
+  if(
+    !value.is_constant() && value.id() != ID_symbol &&
+    value.id() != ID_nondet_symbol)
+  {
+    return false;
+  }
+
+  if(value == symbol)
+    return false;
+
+  substitutions.emplace(symbol.get_identifier(), value);
+  return true;
+}
+
+exprt word_level_preprocessort::operator()(const exprt &expr)
+{
+  exprt result = expr;
+
+  if(rewrite(result))
+    return simplify_expr(std::move(result), ns);
+
+  return result;
+}
+
+/// Rewrite the operands of \p expr and then \p expr itself. Unchanged
+/// sub-expressions remain shared.
+/// \return true if \p expr was changed
+bool word_level_preprocessort::rewrite(exprt &expr)
+{
+  // symbols bound by these may shadow symbols with substitutions
+  if(
+    expr.id() == ID_forall || expr.id() == ID_exists || expr.id() == ID_let ||
+    expr.id() == ID_lambda || expr.id() == ID_array_comprehension)
+  {
+    return false;
+  }
+
+  bool changed = false;
+
+  if(expr.has_operands())
+  {
+    const exprt::operandst &operands = std::as_const(expr).operands();
+    exprt::operandst new_operands;
+
+    for(std::size_t i = 0; i < operands.size(); ++i)
+    {
+      exprt op = operands[i];
+      if(!rewrite(op))
+        continue;
+
+      if(!changed)
+      {
+        new_operands = operands;
+        changed = true;
+      }
+
+      new_operands[i] = std::move(op);
+    }
+
+    if(changed)
+      expr.operands() = std::move(new_operands);
+  }
+
+  if(expr.id() == ID_symbol && substitute(expr))
+    changed = true;
+
+  if(reduce_width(expr))
+    changed = true;
+
+  return changed;
+}
+
+bool word_level_preprocessort::substitute(exprt &expr)
+{
+  auto entry = substitutions.find(to_symbol_expr(expr).get_identifier());
+  if(entry == substitutions.end())
+    return false;
+
+  // follow chains of symbols that were equated in the opposite order
+  while(entry->second.id() == ID_symbol)
+  {
+    const auto next =
+      substitutions.find(to_symbol_expr(entry->second).get_identifier());
+    if(next == substitutions.end())
+      break;
+    entry = next;
+  }
+
+  if(entry->second.type() != expr.type())
+    return false;
+
+  if(entry->second.is_constant())
+    ++statistics.constants;
+  else
+    ++statistics.equalities;
+
+  expr = entry->second;
+  return true;
+}
+
+bool word_level_preprocessort::reduce_width(exprt &expr)
+{
+  if(expr.id() == ID_typecast)
+    return reduce_typecast_width(expr);
+  else if(
+    expr.id() == ID_equal || expr.id() == ID_notequal || expr.id() == ID_lt ||
+    expr.id() == ID_le || expr.id() == ID_gt || expr.id() == ID_ge)
+  {
+    return reduce_relation_width(expr);
+  }
+  else
+    return false;
+}
+
+/// The low bits of the result of addition, subtraction, multiplication and
+/// bit-wise operations only depend on the low bits of the operands, so a
+/// truncation of their result is pushed into the operands.
+bool word_level_preprocessort::reduce_typecast_width(exprt &expr)
+{
+  const typet &type = expr.type();
+  const exprt &op = to_typecast_expr(expr).op();
+
+  if(!is_integer_bitvector(type) || !is_integer_bitvector(op.type()))
+    return false;
+
+  if(
+    to_bitvector_type(op.type()).get_width() <=
+    to_bitvector_type(type).get_width())
+  {
+    return false;
+  }
+
+  // (T)(S)x with x of type T and S wider than T is x
+  if(op.id() == ID_typecast && to_typecast_expr(op).op().type() == type)
+  {
+    exprt tmp = to_typecast_expr(op).op();
+    expr.swap(tmp);
+    ++statistics.width_reductions;
+    return true;
+  }
+
+  if(
+    op.id() != ID_plus && op.id() != ID_minus && op.id() != ID_mult &&
+    op.id() != ID_bitand && op.id() != ID_bitor && op.id() != ID_bitxor &&
+    op.id() != ID_bitnot && op.id() != ID_unary_minus)
+  {
+    return false;
+  }
+
+  for(const auto &operand : op.operands())
+  {
+    if(operand.type() != op.type())
+      return false;
+  }
+
+  exprt result = op;
+  result.type() = type;
+
+  for(auto &operand : result.operands())
+  {
+    exprt narrowed = typecast_exprt{operand, type};
+    reduce_typecast_width(narrowed);
+    operand.swap(narrowed);
+  }
+
+  expr.swap(result);
+  ++statistics.width_reductions;
+  return true;
+}
+
+/// Comparisons of sign- or zero-extended operands, or of one such operand
+/// and a constant that fits the narrower type, are done at the narrower width.
+bool word_level_preprocessort::reduce_relation_width(exprt &expr)
+{
+  const exprt &lhs = to_binary_expr(expr).lhs();
+  const exprt &rhs = to_binary_expr(expr).rhs();
+  const bool is_equality = expr.id() == ID_equal || expr.id() == ID_notequal;
+
+  const exprt *lhs_op = extended_operand(lhs);
+  const exprt *rhs_op = extended_operand(rhs);
+
+  exprt new_lhs, new_rhs;
+
+  if(lhs_op != nullptr && rhs_op != nullptr)
+  {
+    // sign and zero extension are injective, but only preserve the order of
+    // values in some cases
+    if(
+      lhs_op->type() != rhs_op->type() ||
+      (!is_equality && !preserves_order(*lhs_op, lhs.type())))
+    {
+      return false;
+    }
+
+    new_lhs = *lhs_op;
+    new_rhs = *rhs_op;
+  }
+  else if(lhs_op != nullptr || rhs_op != nullptr)
+  {
+    const exprt &op = lhs_op != nullptr ? *lhs_op : *rhs_op;
+    const exprt &other = lhs_op != nullptr ? rhs : lhs;
+    const typet &extended_type = lhs_op != nullptr ? lhs.type() : rhs.type();
+
+    if(!other.is_constant() || !preserves_order(op, extended_type))
+      return false;
+
+    const auto value = numeric_cast<mp_integer>(to_constant_expr(other));
+    const auto &narrow_type = to_integer_bitvector_type(op.type());
+    if(
+      !value.has_value() || *value < narrow_type.smallest() ||
+      *value > narrow_type.largest())
+    {
+      return false;
+    }
+
+    new_lhs = op;
+    new_rhs = from_integer(*value, op.type());
+    if(lhs_op == nullptr)
+      std::swap(new_lhs, new_rhs);
+  }
+  else
+    return false;
+
+  to_binary_expr(expr).lhs() = std::move(new_lhs);
+  to_binary_expr(expr).rhs() = std::move(new_rhs);
+  ++statistics.width_reductions;
+  return true;
+}
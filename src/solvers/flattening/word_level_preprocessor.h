@@ -0,0 +1,79 @@
+/*******************************************************************\
+
+Module: Word-Level Preprocessing
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Word-level simplification of constraints before bit-blasting
+
+#ifndef CPROVER_SOLVERS_FLATTENING_WORD_LEVEL_PREPROCESSOR_H
+#define CPROVER_SOLVERS_FLATTENING_WORD_LEVEL_PREPROCESSOR_H
+
+#include <util/expr.h>
+
+#include <unordered_map>
+
+class namespacet;
+class symbol_exprt;
+
+/// Rewrites the constraints given to a decision procedure before they are
+/// bit-blasted. Equalities between symbols and constants or other symbols
+/// are propagated into all later constraints, which often turns array
+/// indices, divisors and shift distances into constants and makes terms of
+/// different SSA steps identical. Arithmetic whose result is truncated, and
+/// comparisons of sign- or zero-extended operands, are done at the narrower
+/// width.
+class word_level_preprocessort
+{
+public:
+  explicit word_level_preprocessort(const namespacet &_ns) : ns(_ns)
+  {
+  }
+
+  /// Record that \p symbol equals \p value in all models, where \p value
+  /// has been preprocessed already. Only equalities with constants and
+  /// other symbols are recorded.
+  /// \return true if the equality is used for substitution
+  bool add_equality(const symbol_exprt &symbol, const exprt &value);
+
+  /// \return true if the symbol is replaced in preprocessed constraints
+  bool has_substitution(const irep_idt &identifier) const
+  {
+    return substitutions.find(identifier) != substitutions.end();
+  }
+
+  /// Rewrite \p expr using the equalities recorded so far and narrower
+  /// bit-vector widths
+  exprt operator()(const exprt &expr);
+
+  struct statisticst
+  {
+    /// occurrences of symbols replaced by constants
+    std::size_t constants = 0;
+    /// occurrences of symbols replaced by other symbols
+    std::size_t equalities = 0;
+    /// operations and comparisons done at a narrower width
+    std::size_t width_reductions = 0;
+  };
+
+  const statisticst &get_statistics() const
+  {
+    return statistics;
+  }
+
+protected:
+  const namespacet &ns;
+  std::unordered_map<irep_idt, exprt> substitutions;
+  statisticst statistics;
+
+  bool rewrite(exprt &expr);
+  bool substitute(exprt &expr);
+  bool reduce_width(exprt &expr);
+  bool reduce_typecast_width(exprt &expr);
+  bool reduce_relation_width(exprt &expr);
+};
+
+#endif // CPROVER_SOLVERS_FLATTENING_WORD_LEVEL_PREPROCESSOR_H
@@ -39,8 +39,8 @@ void cover_goalst::mark()
     }
 }
 
-/// Build clause
-void cover_goalst::constraint()
+/// Build the disjunction of the goals that remain to be covered
+exprt cover_goalst::constraint()
 {
   exprt::operandst disjuncts;
 
@@ -51,7 +51,7 @@ void cover_goalst::constraint()
       disjuncts.push_back(g.condition);
 
   // this is 'false' if there are no disjuncts
-  decision_procedure.set_to_true(disjunction(disjuncts));
+  return disjunction(disjuncts);
 }
 
 /// Try to cover all goals
@@ -67,8 +67,13 @@ operator()(message_handlert &message_handler)
     // We want (at least) one of the remaining goals, please!
     _iterations++;
 
-    constraint();
-    dec_result = decision_procedure();
+    // This is an assumption rather than a constraint, which leaves the
+    // decision procedure usable for other goals afterwards.
+    const exprt goals_disjunction = constraint();
+    if(goals_disjunction.is_false())
+      dec_result = decision_proceduret::resultt::D_UNSATISFIABLE;
+    else
+      dec_result = decision_procedure(goals_disjunction);
 
     switch(dec_result)
     {
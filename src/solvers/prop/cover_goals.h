@@ -102,7 +102,7 @@ class cover_goalst
 
 private:
   void mark();
-  void constraint();
+  exprt constraint();
 };
 
 #endif // CPROVER_SOLVERS_PROP_COVER_GOALS_H
@@ -96,6 +96,12 @@ class propt
   virtual size_t no_variables() const=0;
   virtual bvt new_variables(std::size_t width);
 
+  // clauses, for solvers that keep the formula in conjunctive normal form
+  virtual size_t no_clauses() const
+  {
+    return 0;
+  }
+
   // solving
   virtual std::string solver_text() const = 0;
   enum class resultt { P_SATISFIABLE, P_UNSATISFIABLE, P_ERROR };
@@ -122,6 +128,21 @@ class propt
     log.warning() << "CPU limit ignored (not implemented)" << messaget::eom;
   }
 
+  /// Make a running call of \ref prop_solve, and any later one, return
+  /// P_ERROR as soon as possible, until \ref clear_interrupt is called.
+  /// Unlike all other methods, this one may be called from another thread.
+  /// The solver remains usable once the interrupt has been cleared.
+  virtual void interrupt()
+  {
+  }
+  virtual void clear_interrupt()
+  {
+  }
+  virtual bool has_interrupt() const
+  {
+    return false;
+  }
+
   std::size_t get_number_of_solver_calls() const;
 
 protected:
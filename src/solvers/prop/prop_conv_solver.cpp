@@ -465,6 +465,20 @@ prop_conv_solvert::dec_solve(const exprt &assumption)
   else
     push({assumption});
 
+  if(prop.get_number_of_solver_calls() > 0)
+  {
+    log.statistics() << "Incremental solving: call "
+                     << prop.get_number_of_solver_calls() + 1 << " reuses "
+                     << variables_at_previous_call << " of "
+                     << prop.no_variables() << " variables and "
+                     << clauses_at_previous_call << " of " << prop.no_clauses()
+                     << " clauses, with " << assumption_stack.size()
+                     << " assumptions" << messaget::eom;
+  }
+
+  variables_at_previous_call = prop.no_variables();
+  clauses_at_previous_call = prop.no_clauses();
+
   auto prop_result = prop.prop_solve(assumption_stack);
 
   pop();
@@ -528,9 +542,13 @@ void prop_conv_solvert::set_to(const exprt &expr, bool value)
   }
   else
   {
-    // We have a child context. We add context_literal ==> expr to the formula.
+    // We have a child context. We add context_literal ==> expr, or
+    // context_literal ==> !expr, to the formula.
     add_constraints_to_prop(
-      or_exprt(literal_exprt(!assumption_stack.back()), expr), value);
+      or_exprt(
+        literal_exprt(!assumption_stack.back()),
+        value ? expr : not_exprt(expr)),
+      true);
   }
 }
 
@@ -107,6 +107,11 @@ class prop_conv_solvert : public conflict_providert,
 protected:
   bool post_processing_done = false;
 
+  // size of the formula at the previous solver call, which the SAT solver
+  // retains together with the clauses it has learnt
+  std::size_t variables_at_previous_call = 0;
+  std::size_t clauses_at_previous_call = 0;
+
   /// Get a _boolean_ value from the model if the formula is satisfiable.
   /// If the argument is not a boolean expression from the formula,
   /// {} is returned.
@@ -118,8 +118,11 @@ void prop_minimizet::operator()()
       {
         _iterations++;
 
+        // Solve under the assumption, which keeps the clauses that the
+        // solver has learnt, and leaves the caller's context unchanged.
         prop_conv.push({literal_exprt{c}});
         dec_result = prop_conv();
+        prop_conv.pop();
 
         switch(dec_result)
         {
@@ -145,8 +148,6 @@ void prop_minimizet::operator()()
   {
     // We don't have a satisfying assignment to work with.
     // Run solver again to get one.
-
-    prop_conv.pop();
     (void)prop_conv();
   }
 }
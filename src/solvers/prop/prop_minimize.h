@@ -27,6 +27,9 @@ class prop_minimizet
 public:
   prop_minimizet(prop_convt &_prop_conv, message_handlert &message_handler);
 
+  /// Minimize the cost. Improvements are requested via assumptions, and
+  /// objectives that have been achieved are fixed in the current context of
+  /// the decision procedure, which the caller may pop to undo them.
   void operator()();
 
   // statistics
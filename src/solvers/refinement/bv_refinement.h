@@ -90,6 +90,7 @@ class bv_refinementt:public bv_pointerst
     std::size_t id_nr;
   };
 
+  resultt refinement_loop();
   resultt prop_solve();
   approximationt &add_approximation(const exprt &expr, bvt &bv);
   bool conflicts_with(approximationt &approximation);
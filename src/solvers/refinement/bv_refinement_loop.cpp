@@ -29,6 +29,20 @@ decision_proceduret::resultt bv_refinementt::dec_solve(const exprt &assumption)
 
   log.debug() << "Solving with " << prop.solver_text() << messaget::eom;
 
+  // the assumption holds in all iterations
+  if(assumption.is_not_nil())
+    push({assumption});
+
+  const resultt result = refinement_loop();
+
+  if(assumption.is_not_nil())
+    pop();
+
+  return result;
+}
+
+decision_proceduret::resultt bv_refinementt::refinement_loop()
+{
   unsigned iteration=0;
 
   // now enter the loop
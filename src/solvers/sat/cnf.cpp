@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <algorithm>
 
 #include <util/invariant.h>
+#include <util/irep_hash.h>
 
 // #define VERBOSE
 
@@ -164,6 +165,9 @@ literalt cnft::land(const bvt &bv)
   if(bv.size()==2)
     return land(bv[0], bv[1]);
 
+  if(structural_hashing)
+    return hashed_and(bv);
+
   for(const auto &l : bv)
     if(l.is_false())
       return l;
@@ -171,28 +175,32 @@ literalt cnft::land(const bvt &bv)
   if(is_all(bv, const_literal(true)))
     return const_literal(true);
 
-  bvt new_bv=eliminate_duplicates(bv);
+  literalt literal=new_variable();
+  gate_and(eliminate_duplicates(bv), literal);
+  return literal;
+}
 
+/// Tseitin encoding of conjunction of any number of literals
+/// \par parameters: Inputs to the AND gate, one output
+void cnft::gate_and(const bvt &inputs, literalt o)
+{
   bvt lits(2);
-  literalt literal=new_variable();
-  lits[1]=neg(literal);
+  lits[1]=neg(o);
 
-  for(const auto &l : new_bv)
+  for(const auto &l : inputs)
   {
     lits[0]=pos(l);
     lcnf(lits);
   }
 
   lits.clear();
-  lits.reserve(new_bv.size()+1);
+  lits.reserve(inputs.size()+1);
 
-  for(const auto &l : new_bv)
+  for(const auto &l : inputs)
     lits.push_back(neg(l));
 
-  lits.push_back(pos(literal));
+  lits.push_back(pos(o));
   lcnf(lits);
-
-  return literal;
 }
 
 /// Tseitin encoding of disjunction between multiple literals
@@ -207,6 +215,15 @@ literalt cnft::lor(const bvt &bv)
   if(bv.size()==2)
     return lor(bv[0], bv[1]);
 
+  if(structural_hashing)
+  {
+    bvt negated;
+    negated.reserve(bv.size());
+    for(const auto &l : bv)
+      negated.push_back(!l);
+    return !hashed_and(negated);
+  }
+
   for(const auto &l : bv)
     if(l.is_true())
       return l;
@@ -269,6 +286,9 @@ literalt cnft::land(literalt a, literalt b)
   if(a==b)
     return a;
 
+  if(structural_hashing)
+    return hashed_and(a, b);
+
   literalt o=new_variable();
   gate_and(a, b, o);
   return o;
@@ -285,6 +305,9 @@ literalt cnft::lor(literalt a, literalt b)
   if(a==b)
     return a;
 
+  if(structural_hashing)
+    return !hashed_and(!a, !b);
+
   literalt o=new_variable();
   gate_or(a, b, o);
   return o;
@@ -307,6 +330,9 @@ literalt cnft::lxor(literalt a, literalt b)
   if(a==!b)
     return const_literal(true);
 
+  if(structural_hashing)
+    return hashed_xor(a, b);
+
   literalt o=new_variable();
   gate_xor(a, b, o);
   return o;
@@ -356,12 +382,23 @@ literalt cnft::lselect(literalt a, literalt b, literalt c)
 
   #ifdef COMPACT_ITE
 
-  // (a+c'+o) (a+c+o') (a'+b'+o) (a'+b+o')
+  if(structural_hashing)
+    return hashed_select(a, b, c);
 
   literalt o=new_variable();
+  gate_select(a, b, c, o);
+  return o;
 
-  bvt lits;
+  #else
+  return lor(land(a, b), land(!a, c));
+  #endif
+}
 
+/// Tseitin encoding of if-then-else
+/// \par parameters: Condition, then and else inputs, one output
+void cnft::gate_select(literalt a, literalt b, literalt c, literalt o)
+{
+  // (a+c'+o) (a+c+o') (a'+b'+o) (a'+b+o')
   lcnf(a, !c,  o);
   lcnf(a,  c, !o);
   lcnf(!a, !b,  o);
@@ -372,12 +409,6 @@ literalt cnft::lselect(literalt a, literalt b, literalt c)
   lcnf(b,  c, !o);
   lcnf(!b, !c,  o);
   #endif
-
-  return o;
-
-  #else
-  return lor(land(a, b), land(!a, c));
-  #endif
 }
 
 /// Generate a new variable and return it as a literal
@@ -497,3 +528,299 @@ bool cnft::process_clause(const bvt &bv, bvt &dest) const
 
   return false;
 }
+
+std::size_t cnft::gate_hasht::operator()(const gatet &gate) const
+{
+  std::size_t result = static_cast<std::size_t>(gate.kind);
+  result = hash_combine(result, gate.a.get());
+  result = hash_combine(result, gate.b.get());
+  result = hash_combine(result, gate.c.get());
+  return result;
+}
+
+/// Forget all gates encoded before the last call to the solver, as a
+/// simplifying solver may have eliminated their variables.
+void cnft::reset_gate_table_after_solving()
+{
+  if(gate_table_solver_calls == get_number_of_solver_calls())
+    return;
+
+  gate_table.clear();
+  and_table.clear();
+  and_gate_inputs.clear();
+  gate_table_solver_calls = get_number_of_solver_calls();
+}
+
+void cnft::record_shared_gate(std::size_t clauses)
+{
+  ++structural_hashing_statistics.hashed;
+  ++structural_hashing_statistics.variables_saved;
+  structural_hashing_statistics.clauses_saved += clauses;
+}
+
+/// AND of two non-constant literals of different variables, re-using an
+/// existing gate with the same inputs where possible
+literalt cnft::hashed_and(literalt a, literalt b)
+{
+  reset_gate_table_after_solving();
+  ++structural_hashing_statistics.gates;
+
+  if(a == !b)
+  {
+    ++structural_hashing_statistics.rewritten;
+    ++structural_hashing_statistics.variables_saved;
+    structural_hashing_statistics.clauses_saved += 3;
+    return const_literal(false);
+  }
+
+  if(const auto rewritten = rewrite_and(a, b))
+    return *rewritten;
+
+  if(b < a)
+    std::swap(a, b);
+
+  const gatet gate{gate_kindt::AND, a, b, literalt{}};
+  const auto entry = gate_table.find(gate);
+  if(entry != gate_table.end())
+  {
+    record_shared_gate(3);
+    return entry->second;
+  }
+
+  literalt o = new_variable();
+  gate_and(a, b, o);
+  gate_table.emplace(gate, o);
+  and_gate_inputs.emplace(o.var_no(), std::make_pair(a, b));
+  return o;
+}
+
+/// Two-level rewriting rules for an AND of two literals one of which is
+/// the output of another AND gate, following Brummayer and Biere, "Local
+/// Two-Level And-Inverter Graph Minimization without Blowup" (2006).
+/// \return the simplified result, or an empty optional if no rule applies
+std::optional<literalt> cnft::rewrite_and(literalt a, literalt b)
+{
+  // a literal that replaces the gate without encoding any new one
+  const auto replace = [this](literalt l) {
+    ++structural_hashing_statistics.rewritten;
+    ++structural_hashing_statistics.variables_saved;
+    structural_hashing_statistics.clauses_saved += 3;
+    return l;
+  };
+
+  for(const auto &operands : {std::make_pair(a, b), std::make_pair(b, a)})
+  {
+    const literalt x = operands.first;
+    const literalt y = operands.second;
+
+    const auto x_gate = and_gate_inputs.find(x.var_no());
+    if(x_gate == and_gate_inputs.end())
+      continue;
+
+    const literalt c = x_gate->second.first;
+    const literalt d = x_gate->second.second;
+
+    const auto y_gate = and_gate_inputs.find(y.var_no());
+    const bool y_is_gate = y_gate != and_gate_inputs.end();
+
+    if(!x.sign())
+    {
+      // x = c & d
+      if(y == !c || y == !d)
+        return replace(const_literal(false)); // contradiction
+      if(y == c || y == d)
+        return replace(x); // idempotence
+
+      if(y_is_gate && !y.sign())
+      {
+        // y = e & f
+        const literalt e = y_gate->second.first;
+        const literalt f = y_gate->second.second;
+        if(c == !e || c == !f || d == !e || d == !f)
+          return replace(const_literal(false)); // contradiction
+      }
+    }
+    else
+    {
+      // x = !(c & d)
+      if(y == !c || y == !d)
+        return replace(y); // subsumption
+
+      if(y == c || y == d)
+      {
+        // substitution
+        ++structural_hashing_statistics.rewritten;
+        return hashed_and(y, y == c ? !d : !c);
+      }
+
+      if(y_is_gate)
+      {
+        const literalt e = y_gate->second.first;
+        const literalt f = y_gate->second.second;
+
+        if(!y.sign())
+        {
+          // y = e & f implies x
+          if(e == !c || e == !d || f == !c || f == !d)
+            return replace(y); // subsumption
+        }
+        else
+        {
+          // y = !(e & f)
+          if((c == e && d == !f) || (c == f && d == !e))
+            return replace(!c); // resolution
+          if((d == e && c == !f) || (d == f && c == !e))
+            return replace(!d); // resolution
+        }
+      }
+    }
+  }
+
+  return {};
+}
+
+/// AND of at least three literals, re-using an existing gate with the same
+/// inputs where possible
+literalt cnft::hashed_and(const bvt &bv)
+{
+  bvt inputs;
+  inputs.reserve(bv.size());
+
+  for(const auto &l : bv)
+  {
+    if(l.is_false())
+      return l;
+    if(!l.is_true())
+      inputs.push_back(l);
+  }
+
+  std::sort(inputs.begin(), inputs.end());
+  inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+
+  if(inputs.size() <= 2)
+    return land(inputs);
+
+  reset_gate_table_after_solving();
+  ++structural_hashing_statistics.gates;
+
+  // a literal and its negation are adjacent after sorting
+  for(std::size_t i = 1; i < inputs.size(); ++i)
+  {
+    if(inputs[i] == !inputs[i - 1])
+    {
+      ++structural_hashing_statistics.rewritten;
+      ++structural_hashing_statistics.variables_saved;
+      structural_hashing_statistics.clauses_saved += inputs.size() + 1;
+      return const_literal(false);
+    }
+  }
+
+  const auto entry = and_table.find(inputs);
+  if(entry != and_table.end())
+  {
+    record_shared_gate(inputs.size() + 1);
+    return entry->second;
+  }
+
+  literalt o = new_variable();
+  gate_and(inputs, o);
+  and_table.emplace(std::move(inputs), o);
+  return o;
+}
+
+/// XOR of two non-constant literals of different variables, re-using an
+/// existing gate with the same inputs where possible
+literalt cnft::hashed_xor(literalt a, literalt b)
+{
+  reset_gate_table_after_solving();
+  ++structural_hashing_statistics.gates;
+
+  // negated inputs negate the output
+  const bool sign = a.sign() != b.sign();
+  a = literalt(a.var_no(), false);
+  b = literalt(b.var_no(), false);
+
+  if(b < a)
+    std::swap(a, b);
+
+  const gatet gate{gate_kindt::XOR, a, b, literalt{}};
+  const auto entry = gate_table.find(gate);
+  if(entry != gate_table.end())
+  {
+    record_shared_gate(4);
+    return entry->second ^ sign;
+  }
+
+  literalt o = new_variable();
+  gate_xor(a, b, o);
+  gate_table.emplace(gate, o);
+  return o ^ sign;
+}
+
+/// a?b:c for non-constant literals with b!=c, re-using an existing gate with
+/// the same inputs where possible
+literalt cnft::hashed_select(literalt a, literalt b, literalt c)
+{
+  if(b == !c)
+  {
+    ++structural_hashing_statistics.rewritten;
+    return lequal(a, b);
+  }
+
+  if(a == b || a == !b || a == c || a == !c)
+  {
+    ++structural_hashing_statistics.rewritten;
+    if(a == b)
+      return lor(a, c);
+    else if(a == !b)
+      return land(!a, c);
+    else if(a == c)
+      return land(a, b);
+    else
+      return lor(!a, b);
+  }
+
+  reset_gate_table_after_solving();
+  ++structural_hashing_statistics.gates;
+
+  // !a?b:c = a?c:b
+  if(a.sign())
+  {
+    a = !a;
+    std::swap(b, c);
+  }
+
+  // a?!b:!c = !(a?b:c)
+  const bool sign = b.sign();
+  if(sign)
+  {
+    b = !b;
+    c = !c;
+  }
+
+  const gatet gate{gate_kindt::SELECT, a, b, c};
+  const auto entry = gate_table.find(gate);
+  if(entry != gate_table.end())
+  {
+    record_shared_gate(4);
+    return entry->second ^ sign;
+  }
+
+  literalt o = new_variable();
+  gate_select(a, b, c, o);
+  gate_table.emplace(gate, o);
+  return o ^ sign;
+}
+
+void cnft::output_structural_hashing_statistics()
+{
+  if(!structural_hashing)
+    return;
+
+  const auto &statistics = structural_hashing_statistics;
+  log.statistics() << "Structural hashing: " << statistics.hashed << " of "
+                   << statistics.gates << " gates shared, "
+                   << statistics.rewritten << " rewritten, saving "
+                   << statistics.variables_saved << " variables and "
+                   << statistics.clauses_saved << " clauses" << messaget::eom;
+}
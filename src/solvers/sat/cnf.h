@@ -14,6 +14,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <solvers/prop/prop.h>
 
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
 class cnft:public propt
 {
 public:
@@ -41,7 +46,37 @@ class cnft:public propt
   bvt new_variables(std::size_t width) override;
   virtual size_t no_variables() const override { return _no_variables; }
   virtual void set_no_variables(size_t no) { _no_variables=no; }
-  virtual size_t no_clauses() const=0;
+  size_t no_clauses() const override = 0;
+
+  /// Enable structural hashing: AND, XOR and if-then-else gates with the
+  /// same inputs (up to commutativity and negation) share one output
+  /// literal, and two-level rewriting rules simplify AND gates whose
+  /// inputs are AND gates themselves. OR, NAND, NOR and implication are
+  /// expressed via AND so that they are shared with equivalent AND gates.
+  /// Structural hashing is off by default.
+  void set_structural_hashing(bool value)
+  {
+    structural_hashing = value;
+  }
+
+  struct structural_hashing_statisticst
+  {
+    /// non-trivial gates requested with structural hashing enabled
+    std::size_t gates = 0;
+    /// gates whose output was taken from the hash table
+    std::size_t hashed = 0;
+    /// gates simplified by rewriting rules
+    std::size_t rewritten = 0;
+    /// variables and clauses not generated because of the above
+    std::size_t variables_saved = 0;
+    std::size_t clauses_saved = 0;
+  };
+
+  const structural_hashing_statisticst &
+  get_structural_hashing_statistics() const
+  {
+    return structural_hashing_statistics;
+  }
 
 protected:
   void gate_and(literalt a, literalt b, literalt o);
@@ -51,11 +86,62 @@ class cnft:public propt
   void gate_nor(literalt a, literalt b, literalt o);
   void gate_equal(literalt a, literalt b, literalt o);
   void gate_implies(literalt a, literalt b, literalt o);
+  void gate_and(const bvt &inputs, literalt o);
+  void gate_select(literalt a, literalt b, literalt c, literalt o);
 
   static bvt eliminate_duplicates(const bvt &);
 
   size_t _no_variables;
 
+  bool structural_hashing = false;
+  structural_hashing_statisticst structural_hashing_statistics;
+
+  literalt hashed_and(literalt a, literalt b);
+  literalt hashed_and(const bvt &bv);
+  literalt hashed_xor(literalt a, literalt b);
+  literalt hashed_select(literalt a, literalt b, literalt c);
+  std::optional<literalt> rewrite_and(literalt a, literalt b);
+  void reset_gate_table_after_solving();
+  void record_shared_gate(std::size_t clauses);
+
+  /// print the structural hashing statistics, if enabled
+  void output_structural_hashing_statistics();
+
+  enum class gate_kindt
+  {
+    AND,
+    XOR,
+    SELECT
+  };
+
+  struct gatet
+  {
+    gate_kindt kind;
+    literalt a, b, c;
+
+    bool operator==(const gatet &other) const
+    {
+      return kind == other.kind && a == other.a && b == other.b &&
+             c == other.c;
+    }
+  };
+
+  struct gate_hasht
+  {
+    std::size_t operator()(const gatet &gate) const;
+  };
+
+  /// outputs of the binary and ternary gates encoded so far
+  std::unordered_map<gatet, literalt, gate_hasht> gate_table;
+  /// outputs of the AND gates with more than two inputs encoded so far
+  std::map<bvt, literalt> and_table;
+  /// inputs of the binary AND gates, by the variable of their output
+  std::unordered_map<literalt::var_not, std::pair<literalt, literalt>>
+    and_gate_inputs;
+  /// Simplifying solvers may eliminate variables when solving, so gates
+  /// are only shared with gates encoded since the last call to the solver.
+  std::size_t gate_table_solver_calls = 0;
+
   bool process_clause(const bvt &bv, bvt &dest) const;
 
   static bool is_all(const bvt &bv, literalt l)
@@ -17,6 +17,25 @@ Author: Michael Tautschnig
 
 #  include <cadical.hpp>
 
+/// Makes CaDiCaL stop solving once \ref satcheck_cadicalt::interrupt has
+/// been called
+class interrupt_terminatort : public CaDiCaL::Terminator
+{
+public:
+  explicit interrupt_terminatort(const std::atomic<bool> &_interrupted)
+    : interrupted(_interrupted)
+  {
+  }
+
+  bool terminate() override
+  {
+    return interrupted;
+  }
+
+protected:
+  const std::atomic<bool> &interrupted;
+};
+
 tvt satcheck_cadicalt::l_get(literalt a) const
 {
   if(a.is_constant())
@@ -91,6 +110,7 @@ propt::resultt satcheck_cadicalt::do_prop_solve(const bvt &assumptions)
 
   log.statistics() << (no_variables() - 1) << " variables, " << clause_counter
                    << " clauses" << messaget::eom;
+  output_structural_hashing_statistics();
 
   // if assumptions contains false, we need this to be UNSAT
   for(const auto &a : assumptions)
@@ -118,6 +138,13 @@ propt::resultt satcheck_cadicalt::do_prop_solve(const bvt &assumptions)
     log.status() << "SAT checker: instance is UNSATISFIABLE" << messaget::eom;
     break;
   default:
+    if(interrupted)
+    {
+      log.status() << "SAT checker: interrupted" << messaget::eom;
+      status = statust::INIT;
+      return resultt::P_ERROR;
+    }
+
     log.status() << "SAT checker: solving returned without solution"
                  << messaget::eom;
     throw analysis_exceptiont(
@@ -135,9 +162,13 @@ void satcheck_cadicalt::set_assignment(literalt a, bool value)
 }
 
 satcheck_cadicalt::satcheck_cadicalt(message_handlert &message_handler)
-  : cnf_solvert(message_handler), solver(new CaDiCaL::Solver())
+  : cnf_solvert(message_handler),
+    solver(new CaDiCaL::Solver()),
+    interrupted(false),
+    terminator(std::make_unique<interrupt_terminatort>(interrupted))
 {
   solver->set("quiet", 1);
+  solver->connect_terminator(terminator.get());
 }
 
 satcheck_cadicalt::~satcheck_cadicalt()
@@ -150,4 +181,14 @@ bool satcheck_cadicalt::is_in_conflict(literalt a) const
   return solver->failed(a.dimacs());
 }
 
+void satcheck_cadicalt::interrupt()
+{
+  interrupted = true;
+}
+
+void satcheck_cadicalt::clear_interrupt()
+{
+  interrupted = false;
+}
+
 #endif
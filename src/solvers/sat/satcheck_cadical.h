@@ -14,9 +14,13 @@ Author: Michael Tautschnig
 
 #include <solvers/hardness_collector.h>
 
+#include <atomic>
+#include <memory>
+
 namespace CaDiCaL // NOLINT(readability/namespace)
 {
   class Solver; // NOLINT(readability/identifiers)
+  class Terminator; // NOLINT(readability/identifiers)
 }
 
 class satcheck_cadicalt : public cnf_solvert, public hardness_collectort
@@ -41,11 +45,23 @@ class satcheck_cadicalt : public cnf_solvert, public hardness_collectort
   }
   bool is_in_conflict(literalt a) const override;
 
+  void interrupt() override;
+  void clear_interrupt() override;
+  bool has_interrupt() const override
+  {
+    return true;
+  }
+
 protected:
   resultt do_prop_solve(const bvt &assumptions) override;
 
   // NOLINTNEXTLINE(readability/identifiers)
   CaDiCaL::Solver *solver;
+
+  /// Set by \ref interrupt and polled by the solver via the terminator
+  std::atomic<bool> interrupted;
+  // NOLINTNEXTLINE(readability/identifiers)
+  std::unique_ptr<CaDiCaL::Terminator> terminator;
 };
 
 #endif // CPROVER_SOLVERS_SAT_SATCHECK_CADICAL_H
@@ -88,6 +88,18 @@ void satcheck_glucose_baset<T>::set_polarity(literalt a, bool value)
   }
 }
 
+template <typename T>
+void satcheck_glucose_baset<T>::interrupt()
+{
+  solver->interrupt();
+}
+
+template <typename T>
+void satcheck_glucose_baset<T>::clear_interrupt()
+{
+  solver->clearInterrupt();
+}
+
 std::string satcheck_glucose_no_simplifiert::solver_text() const
 {
   return "Glucose Syrup without simplifier";
@@ -170,6 +182,7 @@ propt::resultt satcheck_glucose_baset<T>::do_prop_solve(const bvt &assumptions)
   // We start counting at 1, thus there is one variable fewer.
   log.statistics() << (no_variables() - 1) << " variables, "
                    << solver->nClauses() << " clauses" << messaget::eom;
+  output_structural_hashing_statistics();
 
   try
   {
@@ -201,18 +214,29 @@ propt::resultt satcheck_glucose_baset<T>::do_prop_solve(const bvt &assumptions)
         Glucose::vec<Glucose::Lit> solver_assumptions;
         convert_assumptions(assumptions, solver_assumptions);
 
-        if(solver->solve(solver_assumptions))
+        // solveLimited permits interrupting the solver
+        const Glucose::lbool solver_result =
+          solver->solveLimited(solver_assumptions);
+
+        if(solver_result == l_True)
         {
           log.status() << "SAT checker: instance is SATISFIABLE"
                        << messaget::eom;
           status = statust::SAT;
           return resultt::P_SATISFIABLE;
         }
-        else
+        else if(solver_result == l_False)
         {
           log.status() << "SAT checker: instance is UNSATISFIABLE"
                        << messaget::eom;
         }
+        else
+        {
+          // the solver remains consistent and can be used once more
+          log.status() << "SAT checker: interrupted" << messaget::eom;
+          status = statust::INIT;
+          return resultt::P_ERROR;
+        }
       }
     }
 
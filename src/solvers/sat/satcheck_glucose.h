@@ -44,6 +44,13 @@ class satcheck_glucose_baset : public cnf_solvert, public hardness_collectort
   // extra MiniSat feature: default branching decision
   void set_polarity(literalt a, bool value);
 
+  void interrupt() override;
+  void clear_interrupt() override;
+  bool has_interrupt() const override
+  {
+    return true;
+  }
+
   bool is_in_conflict(literalt a) const override;
   bool has_assumptions() const override
   {
@@ -116,6 +116,7 @@ propt::resultt satcheck_ipasirt::do_prop_solve(const bvt &assumptions)
 
   log.statistics() << (no_variables() - 1) << " variables, " << clause_counter
                    << " clauses" << messaget::eom;
+  output_structural_hashing_statistics();
 
   // if assumptions contains false, we need this to be UNSAT
   bvt::const_iterator it =
@@ -108,6 +108,7 @@ void satcheck_minisat2_baset<T>::set_polarity(literalt a, bool value)
 template<typename T>
 void satcheck_minisat2_baset<T>::interrupt()
 {
+  interrupted = true;
   solver->interrupt();
 }
 
@@ -115,6 +116,7 @@ template<typename T>
 void satcheck_minisat2_baset<T>::clear_interrupt()
 {
   solver->clearInterrupt();
+  interrupted = false;
 }
 
 std::string satcheck_minisat_no_simplifiert::solver_text() const
@@ -210,6 +212,7 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve(const bvt &assumptions)
 
   log.statistics() << (no_variables() - 1) << " variables, "
                    << solver->nClauses() << " clauses" << messaget::eom;
+  output_structural_hashing_statistics();
 
   try
   {
@@ -271,7 +274,8 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve(const bvt &assumptions)
                     << messaget::eom;
     }
 
-    lbool solver_result = solver->solve(solver_assumptions) ? l_True : l_False;
+    // solveLimited permits interrupting the solver
+    lbool solver_result = solver->solveLimited(solver_assumptions);
 
 #endif
 
@@ -290,6 +294,14 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve(const bvt &assumptions)
       return resultt::P_UNSATISFIABLE;
     }
 
+    if(interrupted)
+    {
+      // the solver remains consistent and can be used once more
+      log.status() << "SAT checker: interrupted" << messaget::eom;
+      status = statust::INIT;
+      return resultt::P_ERROR;
+    }
+
     log.status() << "SAT checker: timed out or other error" << messaget::eom;
     status = statust::ERROR;
     return resultt::P_ERROR;
@@ -330,7 +342,8 @@ satcheck_minisat2_baset<T>::satcheck_minisat2_baset(
   message_handlert &message_handler)
   : cnf_solvert(message_handler),
     solver(std::make_unique<T>()),
-    time_limit_seconds(0)
+    time_limit_seconds(0),
+    interrupted(false)
 {
 }
 
@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <solvers/hardness_collector.h>
 
+#include <atomic>
 #include <memory>
 
 // Select one: basic solver or with simplification.
@@ -47,10 +48,15 @@ class satcheck_minisat2_baset : public cnf_solvert, public hardness_collectort
   void set_polarity(literalt a, bool value);
 
   // extra MiniSat feature: interrupt running SAT query
-  void interrupt();
+  void interrupt() override;
 
   // extra MiniSat feature: permit previously interrupted SAT query to continue
-  void clear_interrupt();
+  void clear_interrupt() override;
+
+  bool has_interrupt() const override final
+  {
+    return true;
+  }
 
   bool is_in_conflict(literalt a) const override;
   bool has_assumptions() const override final
@@ -72,6 +78,7 @@ class satcheck_minisat2_baset : public cnf_solvert, public hardness_collectort
 
   std::unique_ptr<T> solver;
   uint32_t time_limit_seconds;
+  std::atomic<bool> interrupted;
 
   void add_variables();
 };
@@ -0,0 +1,303 @@
+/*******************************************************************\
+
+Module: Portfolio of Racing SAT Solvers
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of Racing SAT Solvers
+
+#include "satcheck_portfolio.h"
+
+#include <util/invariant.h>
+#include <util/parallel_for.h>
+#include <util/threeval.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+satcheck_portfoliot::satcheck_portfoliot(message_handlert &message_handler)
+  : cnf_solvert(message_handler), interrupted(false)
+{
+}
+
+satcheck_portfoliot::~satcheck_portfoliot() = default;
+
+void satcheck_portfoliot::add_solver(
+  std::unique_ptr<cnft> solver,
+  std::unique_ptr<buffered_message_handlert> solver_message_handler)
+{
+  PRECONDITION(solver->has_interrupt());
+  PRECONDITION(no_variables() == 1 && clause_counter == 0);
+
+  solvers.emplace_back();
+  solvers.back().message_handler = std::move(solver_message_handler);
+  solvers.back().solver = std::move(solver);
+}
+
+std::string satcheck_portfoliot::solver_text() const
+{
+  std::string result = "portfolio of ";
+
+  for(auto it = solvers.begin(); it != solvers.end(); ++it)
+  {
+    if(it != solvers.begin())
+      result += ", ";
+    result += it->solver->solver_text();
+  }
+
+  return result;
+}
+
+void satcheck_portfoliot::lcnf(const bvt &bv)
+{
+  for(auto &solver : solvers)
+  {
+    solver.solver->set_no_variables(_no_variables);
+    solver.solver->lcnf(bv);
+  }
+
+  clause_counter++;
+}
+
+void satcheck_portfoliot::set_frozen(literalt a)
+{
+  for(auto &solver : solvers)
+  {
+    solver.solver->set_no_variables(_no_variables);
+    solver.solver->set_frozen(a);
+  }
+}
+
+void satcheck_portfoliot::set_time_limit_seconds(uint32_t lim)
+{
+  // Not passed on to the solvers: MiniSat implements the limit using a
+  // process-wide alarm signal, and other solvers ignore it.
+  time_limit_seconds = lim;
+}
+
+tvt satcheck_portfoliot::l_get(literalt a) const
+{
+  if(a.is_constant())
+    return tvt(a.sign());
+
+  if(winner == nullptr)
+    return tvt::unknown();
+
+  return winner->l_get(a);
+}
+
+void satcheck_portfoliot::set_assignment(literalt a, bool value)
+{
+  PRECONDITION(winner != nullptr);
+  winner->set_assignment(a, value);
+}
+
+bool satcheck_portfoliot::has_assumptions() const
+{
+  for(const auto &solver : solvers)
+  {
+    if(!solver.solver->has_assumptions())
+      return false;
+  }
+
+  return true;
+}
+
+bool satcheck_portfoliot::has_is_in_conflict() const
+{
+  for(const auto &solver : solvers)
+  {
+    if(!solver.solver->has_is_in_conflict())
+      return false;
+  }
+
+  return true;
+}
+
+bool satcheck_portfoliot::is_in_conflict(literalt a) const
+{
+  PRECONDITION(winner != nullptr);
+  return winner->is_in_conflict(a);
+}
+
+void satcheck_portfoliot::interrupt()
+{
+  interrupted = true;
+  for(auto &solver : solvers)
+    solver.solver->interrupt();
+}
+
+void satcheck_portfoliot::clear_interrupt()
+{
+  interrupted = false;
+  for(auto &solver : solvers)
+    solver.solver->clear_interrupt();
+}
+
+std::vector<std::size_t> satcheck_portfoliot::get_wins() const
+{
+  std::vector<std::size_t> result;
+  result.reserve(solvers.size());
+  for(const auto &solver : solvers)
+    result.push_back(solver.wins);
+  return result;
+}
+
+propt::resultt satcheck_portfoliot::do_prop_solve(const bvt &assumptions)
+{
+  PRECONDITION(!solvers.empty());
+  PRECONDITION(status != statust::ERROR);
+
+  log.statistics() << (no_variables() - 1) << " variables, " << clause_counter
+                   << " clauses" << messaget::eom;
+  output_structural_hashing_statistics();
+
+  for(auto &solver : solvers)
+    solver.solver->set_no_variables(_no_variables);
+
+  winner = nullptr;
+
+  const std::size_t none = solvers.size();
+  std::atomic<std::size_t> first(none);
+  std::vector<resultt> results(solvers.size(), resultt::P_ERROR);
+  std::vector<std::exception_ptr> exceptions(solvers.size());
+
+  const auto solve_start = std::chrono::steady_clock::now();
+
+  // Once the time limit has expired, the watchdog interrupts all solvers,
+  // which remain usable.
+  std::mutex race_mutex;
+  std::condition_variable race_decided;
+  bool race_over = false;
+  std::atomic<bool> timed_out(false);
+  std::thread watchdog;
+
+  if(time_limit_seconds != 0)
+  {
+    const auto deadline =
+      solve_start + std::chrono::seconds(time_limit_seconds);
+    watchdog = std::thread([&, deadline]() {
+      std::unique_lock<std::mutex> lock(race_mutex);
+      if(!race_decided.wait_until(lock, deadline, [&]() { return race_over; }))
+      {
+        timed_out = true;
+        for(auto &solver : solvers)
+          solver.solver->interrupt();
+      }
+    });
+  }
+
+  const auto stop_watchdog = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(race_mutex);
+      race_over = true;
+    }
+    race_decided.notify_one();
+    if(watchdog.joinable())
+      watchdog.join();
+  };
+
+  try
+  {
+    parallel_for(
+      solvers.size(), solvers.size(), [&](std::size_t, std::size_t index) {
+        // a solver that would only start after the race has been decided,
+        // e.g., as no further thread could be created, is not needed
+        if(first != none || interrupted || timed_out)
+          return;
+
+        try
+        {
+          results[index] = solvers[index].solver->prop_solve(assumptions);
+        }
+        catch(...)
+        {
+          // a failing solver does not win, but others may still succeed
+          exceptions[index] = std::current_exception();
+          return;
+        }
+
+        if(results[index] == resultt::P_ERROR)
+          return;
+
+        std::size_t expected = none;
+        if(first.compare_exchange_strong(expected, index))
+        {
+          for(std::size_t i = 0; i < solvers.size(); ++i)
+          {
+            if(i != index)
+              solvers[i].solver->interrupt();
+          }
+        }
+      });
+  }
+  catch(...)
+  {
+    stop_watchdog();
+    throw;
+  }
+
+  stop_watchdog();
+
+  const auto solve_stop = std::chrono::steady_clock::now();
+  const std::size_t index = first;
+
+  for(std::size_t i = 0; i < solvers.size(); ++i)
+  {
+    // report all messages when no solver succeeded
+    if(i == index || index == none)
+      solvers[i].message_handler->replay();
+    else
+      solvers[i].message_handler->clear();
+
+    if(!interrupted)
+      solvers[i].solver->clear_interrupt();
+  }
+
+  if(index == none)
+  {
+    if(interrupted)
+    {
+      log.status() << "SAT portfolio: interrupted" << messaget::eom;
+      status = statust::INIT;
+      return resultt::P_ERROR;
+    }
+
+    if(timed_out)
+    {
+      log.status() << "SAT portfolio: timed out after " << time_limit_seconds
+                   << "s" << messaget::eom;
+      status = statust::INIT;
+      return resultt::P_ERROR;
+    }
+
+    for(const auto &exception : exceptions)
+    {
+      if(exception)
+        std::rethrow_exception(exception);
+    }
+
+    log.status() << "SAT portfolio: no solver answered" << messaget::eom;
+    status = statust::ERROR;
+    return resultt::P_ERROR;
+  }
+
+  winner = solvers[index].solver.get();
+  ++solvers[index].wins;
+
+  log.status() << "SAT portfolio: " << winner->solver_text()
+               << " answered first after "
+               << std::chrono::duration<double>(solve_stop - solve_start)
+                    .count()
+               << "s" << messaget::eom;
+
+  status = results[index] == resultt::P_SATISFIABLE ? statust::SAT
+                                                    : statust::UNSAT;
+  return results[index];
+}
@@ -0,0 +1,104 @@
+/*******************************************************************\
+
+Module: Portfolio of Racing SAT Solvers
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of Racing SAT Solvers
+
+#ifndef CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
+#define CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
+
+#include "cnf.h"
+
+#include <util/buffered_message_handler.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/// A SAT solver that passes each clause on to several other SAT solvers and
+/// runs all of them on separate threads when solving. The first solver to
+/// answer wins: the others are interrupted, and the satisfying assignment or
+/// final conflict is taken from the winner. All solvers keep their state, so
+/// the portfolio can be used incrementally.
+///
+/// Only solvers that support \ref propt::interrupt can take part. Their
+/// messages are buffered, and only those of the winner are passed on.
+/// A time limit is enforced by the portfolio itself, which interrupts all
+/// solvers once it has expired, rather than by the individual solvers.
+class satcheck_portfoliot : public cnf_solvert
+{
+public:
+  explicit satcheck_portfoliot(message_handlert &message_handler);
+  ~satcheck_portfoliot() override;
+
+  /// Add a solver of type \p satcheckT to the portfolio, which must be done
+  /// before any variables or clauses are added.
+  template <typename satcheckT>
+  void add_solver()
+  {
+    auto solver_message_handler =
+      std::make_unique<buffered_message_handlert>(log.get_message_handler());
+    auto solver = std::make_unique<satcheckT>(*solver_message_handler);
+    add_solver(std::move(solver), std::move(solver_message_handler));
+  }
+
+  std::size_t number_of_solvers() const
+  {
+    return solvers.size();
+  }
+
+  std::string solver_text() const override;
+
+  void lcnf(const bvt &bv) override;
+  void set_frozen(literalt a) override;
+  void set_time_limit_seconds(uint32_t lim) override;
+
+  tvt l_get(literalt a) const override;
+  void set_assignment(literalt a, bool value) override;
+
+  bool has_assumptions() const override;
+  bool has_is_in_conflict() const override;
+  bool is_in_conflict(literalt a) const override;
+
+  void interrupt() override;
+  void clear_interrupt() override;
+  bool has_interrupt() const override
+  {
+    return true;
+  }
+
+  /// \return the number of queries won by each solver, in the order in which
+  ///   the solvers were added
+  std::vector<std::size_t> get_wins() const;
+
+protected:
+  struct solvert
+  {
+    std::unique_ptr<buffered_message_handlert> message_handler;
+    std::unique_ptr<cnft> solver;
+    std::size_t wins = 0;
+  };
+
+  std::vector<solvert> solvers;
+
+  /// The solver that answered the last query, if any
+  cnft *winner = nullptr;
+
+  std::atomic<bool> interrupted;
+
+  /// Wall-clock limit for each query, 0 meaning no limit
+  uint32_t time_limit_seconds = 0;
+
+  void add_solver(
+    std::unique_ptr<cnft> solver,
+    std::unique_ptr<buffered_message_handlert> solver_message_handler);
+
+  resultt do_prop_solve(const bvt &assumptions) override;
+};
+
+#endif // CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
@@ -0,0 +1,562 @@
+// Author: Diffblue Ltd.
+
+#include "smt_z3_api_solver_process.h"
+
+#include <util/invariant.h>
+#include <util/mp_arith.h>
+#include <util/narrow.h>
+#include <util/range.h>
+
+#include <solvers/smt2_incremental/ast/smt_commands.h>
+#include <solvers/smt2_incremental/ast/smt_responses.h>
+#include <solvers/smt2_incremental/ast/smt_sorts.h>
+#include <solvers/smt2_incremental/ast/smt_terms.h>
+#include <solvers/smt2_incremental/smt_to_smt2_string.h>
+
+#include <z3++.h>
+
+#include <functional>
+#include <stack>
+#include <unordered_map>
+
+class z3_solver_statet
+{
+public:
+  z3::context context;
+  z3::solver solver{context};
+
+  /// Functions declared with `declare-fun`, including constants.
+  std::unordered_map<irep_idt, z3::func_decl> declarations;
+
+  /// A function defined with `define-fun`. Applications of the function are
+  /// replaced by its body, with the parameters replaced by the arguments.
+  struct definitiont
+  {
+    z3::expr_vector parameters;
+    z3::expr body;
+  };
+  std::unordered_map<irep_idt, definitiont> definitions;
+
+  /// Variables bound by quantifiers and function definitions, in the scope of
+  /// the term which is being converted.
+  std::unordered_map<irep_idt, z3::expr> bound_variables;
+
+  z3::sort convert(const smt_sortt &sort);
+  z3::expr convert(const smt_termt &term);
+  z3::expr lookup(const irep_idt &identifier) const;
+  z3::expr apply(
+    const smt_identifier_termt &function,
+    const std::vector<z3::expr> &arguments);
+
+  /// Check for an error in the last call to the C API of Z3 and wrap its
+  /// result.
+  z3::expr checked(Z3_ast ast)
+  {
+    context.check_error();
+    return z3::expr{context, ast};
+  }
+};
+
+class smt_sort_to_z3_convertert : public smt_sort_const_downcast_visitort
+{
+public:
+  explicit smt_sort_to_z3_convertert(z3::context &context) : context(context)
+  {
+  }
+
+  void visit(const smt_bool_sortt &) override
+  {
+    result = context.bool_sort();
+  }
+
+  void visit(const smt_bit_vector_sortt &bit_vector) override
+  {
+    result = context.bv_sort(bit_vector.bit_width());
+  }
+
+  void visit(const smt_array_sortt &array) override
+  {
+    smt_sort_to_z3_convertert index{context}, element{context};
+    array.index_sort().accept(index);
+    array.element_sort().accept(element);
+    result = context.array_sort(*index.result, *element.result);
+  }
+
+  z3::context &context;
+  std::optional<z3::sort> result;
+};
+
+z3::sort z3_solver_statet::convert(const smt_sortt &sort)
+{
+  smt_sort_to_z3_convertert converter{context};
+  sort.accept(converter);
+  return *converter.result;
+}
+
+/// \note Like the conversion of terms to SMT-LIB text in
+///   `smt_to_smt2_string`, this uses an explicit stack of work rather than
+///   recursion, so that arbitrarily deeply nested terms can be converted.
+class smt_term_to_z3_convertert : private smt_term_const_downcast_visitort
+{
+public:
+  static z3::expr convert(z3_solver_statet &state, const smt_termt &term);
+
+private:
+  explicit smt_term_to_z3_convertert(z3_solver_statet &state) : state(state)
+  {
+  }
+
+  z3_solver_statet &state;
+  std::stack<std::function<void()>> work;
+  std::vector<z3::expr> results;
+
+  void push_term(const smt_termt &term)
+  {
+    work.push([this, &term] { term.accept(*this); });
+  }
+
+  std::vector<z3::expr> pop_results(std::size_t count)
+  {
+    PRECONDITION(results.size() >= count);
+    std::vector<z3::expr> popped{results.end() - count, results.end()};
+    results.erase(results.end() - count, results.end());
+    return popped;
+  }
+
+  void visit(const smt_bool_literal_termt &bool_literal) override
+  {
+    results.push_back(state.context.bool_val(bool_literal.value()));
+  }
+
+  void visit(const smt_identifier_termt &identifier_term) override
+  {
+    results.push_back(state.lookup(identifier_term.identifier()));
+  }
+
+  void visit(const smt_bit_vector_constant_termt &bit_vector_constant) override
+  {
+    results.push_back(state.context.bv_val(
+      integer2string(bit_vector_constant.value()).c_str(),
+      bit_vector_constant.get_sort().bit_width()));
+  }
+
+  void
+  visit(const smt_function_application_termt &function_application) override
+  {
+    const auto arguments = function_application.arguments();
+    work.push([this, &function_application, count = arguments.size()] {
+      results.push_back(state.apply(
+        function_application.function_identifier(), pop_results(count)));
+    });
+    for(const auto &argument : make_range(arguments.rbegin(), arguments.rend()))
+      push_term(argument.get());
+  }
+
+  void quantifier(
+    const std::vector<std::reference_wrapper<const smt_identifier_termt>>
+      &bound_variables,
+    const smt_termt &predicate,
+    bool is_forall)
+  {
+    z3::expr_vector variables{state.context};
+    for(const smt_identifier_termt &variable : bound_variables)
+    {
+      const z3::expr constant = state.context.constant(
+        id2string(variable.identifier()).c_str(),
+        state.convert(variable.get_sort()));
+      variables.push_back(constant);
+      state.bound_variables.insert_or_assign(variable.identifier(), constant);
+    }
+
+    work.push([this, bound_variables, variables, is_forall] {
+      for(const smt_identifier_termt &variable : bound_variables)
+        state.bound_variables.erase(variable.identifier());
+      const z3::expr body = pop_results(1).front();
+      results.push_back(
+        is_forall ? z3::forall(variables, body) : z3::exists(variables, body));
+    });
+    push_term(predicate);
+  }
+
+  void visit(const smt_forall_termt &forall) override
+  {
+    quantifier(forall.bound_variables(), forall.predicate(), true);
+  }
+
+  void visit(const smt_exists_termt &exists) override
+  {
+    quantifier(exists.bound_variables(), exists.predicate(), false);
+  }
+};
+
+z3::expr smt_term_to_z3_convertert::convert(
+  z3_solver_statet &state,
+  const smt_termt &term)
+{
+  smt_term_to_z3_convertert converter{state};
+  converter.push_term(term);
+  while(!converter.work.empty())
+  {
+    auto work_item = std::move(converter.work.top());
+    converter.work.pop();
+    work_item();
+  }
+  INVARIANT(
+    converter.results.size() == 1,
+    "Converting a term should result in a single Z3 expression.");
+  return converter.results.front();
+}
+
+z3::expr z3_solver_statet::convert(const smt_termt &term)
+{
+  return smt_term_to_z3_convertert::convert(*this, term);
+}
+
+z3::expr z3_solver_statet::lookup(const irep_idt &identifier) const
+{
+  const auto bound_variable = bound_variables.find(identifier);
+  if(bound_variable != bound_variables.end())
+    return bound_variable->second;
+
+  const auto definition = definitions.find(identifier);
+  if(definition != definitions.end() && definition->second.parameters.empty())
+    return definition->second.body;
+
+  const auto declaration = declarations.find(identifier);
+  if(declaration != declarations.end() && declaration->second.arity() == 0)
+    return declaration->second();
+
+  throw z3::exception{("unknown constant " + id2string(identifier)).c_str()};
+}
+
+using z3_unary_functiont = Z3_ast (*)(Z3_context, Z3_ast);
+using z3_binary_functiont = Z3_ast (*)(Z3_context, Z3_ast, Z3_ast);
+using z3_ternary_functiont = Z3_ast (*)(Z3_context, Z3_ast, Z3_ast, Z3_ast);
+using z3_nary_functiont = Z3_ast (*)(Z3_context, unsigned, Z3_ast const[]);
+using z3_indexed_functiont = Z3_ast (*)(Z3_context, unsigned, Z3_ast);
+
+/// The functions of the core, bit-vector and array theories, by the names of
+/// their SMT-LIB identifiers.
+static const std::unordered_map<std::string, z3_unary_functiont>
+  unary_functions{
+    {"not", Z3_mk_not},
+    {"bvnot", Z3_mk_bvnot},
+    {"bvneg", Z3_mk_bvneg}};
+
+static const std::unordered_map<std::string, z3_binary_functiont>
+  binary_functions{
+    {"=>", Z3_mk_implies},
+    {"xor", Z3_mk_xor},
+    {"=", Z3_mk_eq},
+    {"concat", Z3_mk_concat},
+    {"bvand", Z3_mk_bvand},
+    {"bvor", Z3_mk_bvor},
+    {"bvnand", Z3_mk_bvnand},
+    {"bvnor", Z3_mk_bvnor},
+    {"bvxor", Z3_mk_bvxor},
+    {"bvxnor", Z3_mk_bvxnor},
+    {"bvult", Z3_mk_bvult},
+    {"bvule", Z3_mk_bvule},
+    {"bvugt", Z3_mk_bvugt},
+    {"bvuge", Z3_mk_bvuge},
+    {"bvslt", Z3_mk_bvslt},
+    {"bvsle", Z3_mk_bvsle},
+    {"bvsgt", Z3_mk_bvsgt},
+    {"bvsge", Z3_mk_bvsge},
+    {"bvadd", Z3_mk_bvadd},
+    {"bvsub", Z3_mk_bvsub},
+    {"bvmul", Z3_mk_bvmul},
+    {"bvudiv", Z3_mk_bvudiv},
+    {"bvsdiv", Z3_mk_bvsdiv},
+    {"bvurem", Z3_mk_bvurem},
+    {"bvsrem", Z3_mk_bvsrem},
+    {"bvshl", Z3_mk_bvshl},
+    {"bvlshr", Z3_mk_bvlshr},
+    {"bvashr", Z3_mk_bvashr},
+    {"select", Z3_mk_select}};
+
+static const std::unordered_map<std::string, z3_ternary_functiont>
+  ternary_functions{{"ite", Z3_mk_ite}, {"store", Z3_mk_store}};
+
+static const std::unordered_map<std::string, z3_nary_functiont>
+  nary_functions{
+    {"and", Z3_mk_and},
+    {"or", Z3_mk_or},
+    {"distinct", Z3_mk_distinct}};
+
+static const std::unordered_map<std::string, z3_indexed_functiont>
+  indexed_functions{
+    {"repeat", Z3_mk_repeat},
+    {"zero_extend", Z3_mk_zero_ext},
+    {"sign_extend", Z3_mk_sign_ext},
+    {"rotate_left", Z3_mk_rotate_left},
+    {"rotate_right", Z3_mk_rotate_right}};
+
+static std::vector<unsigned>
+numeral_indices(const smt_identifier_termt &function)
+{
+  std::vector<unsigned> result;
+  for(const smt_indext &index : function.indices())
+  {
+    const auto numeral = index.cast<smt_numeral_indext>();
+    INVARIANT(numeral, "Indices of theory functions are numerals.");
+    result.push_back(narrow<unsigned>(numeral->value()));
+  }
+  return result;
+}
+
+z3::expr z3_solver_statet::apply(
+  const smt_identifier_termt &function,
+  const std::vector<z3::expr> &arguments)
+{
+  const irep_idt &identifier = function.identifier();
+
+  const auto definition = definitions.find(identifier);
+  if(definition != definitions.end())
+  {
+    z3::expr_vector values{context};
+    for(const z3::expr &argument : arguments)
+      values.push_back(argument);
+    z3::expr body = definition->second.body;
+    return body.substitute(definition->second.parameters, values);
+  }
+
+  const auto declaration = declarations.find(identifier);
+  if(declaration != declarations.end())
+    return declaration->second(arguments.size(), arguments.data());
+
+  const std::string name = id2string(identifier);
+  const std::vector<unsigned> indices = numeral_indices(function);
+
+  if(name == "extract")
+  {
+    PRECONDITION(indices.size() == 2 && arguments.size() == 1);
+    return checked(
+      Z3_mk_extract(context, indices[0], indices[1], arguments[0]));
+  }
+
+  if(name == "bvcomp")
+  {
+    PRECONDITION(arguments.size() == 2);
+    return z3::ite(
+      arguments[0] == arguments[1],
+      context.bv_val(1, 1),
+      context.bv_val(0, 1));
+  }
+
+  const auto indexed = indexed_functions.find(name);
+  if(indexed != indexed_functions.end())
+  {
+    PRECONDITION(indices.size() == 1 && arguments.size() == 1);
+    return checked(indexed->second(context, indices[0], arguments[0]));
+  }
+
+  const auto unary = unary_functions.find(name);
+  if(unary != unary_functions.end())
+  {
+    PRECONDITION(arguments.size() == 1);
+    return checked(unary->second(context, arguments[0]));
+  }
+
+  const auto binary = binary_functions.find(name);
+  if(binary != binary_functions.end())
+  {
+    PRECONDITION(arguments.size() == 2);
+    return checked(binary->second(context, arguments[0], arguments[1]));
+  }
+
+  const auto ternary = ternary_functions.find(name);
+  if(ternary != ternary_functions.end())
+  {
+    PRECONDITION(arguments.size() == 3);
+    return checked(
+      ternary->second(context, arguments[0], arguments[1], arguments[2]));
+  }
+
+  const auto nary = nary_functions.find(name);
+  if(nary != nary_functions.end())
+  {
+    const std::vector<Z3_ast> asts{arguments.begin(), arguments.end()};
+    return checked(nary->second(context, asts.size(), asts.data()));
+  }
+
+  throw z3::exception{("unknown function " + name).c_str()};
+}
+
+/// \return the term for a value in a Z3 model
+static smt_termt convert_value(const z3::expr &value)
+{
+  if(value.is_true())
+    return smt_bool_literal_termt{true};
+  if(value.is_false())
+    return smt_bool_literal_termt{false};
+  if(value.is_bv() && value.is_numeral())
+  {
+    return smt_bit_vector_constant_termt{
+      string2integer(Z3_get_numeral_string(value.ctx(), value)),
+      value.get_sort().bv_size()};
+  }
+  throw z3::exception{("unsupported value " + value.to_string()).c_str()};
+}
+
+class smt_command_to_z3_sendert : public smt_command_const_downcast_visitort
+{
+public:
+  smt_command_to_z3_sendert(
+    z3_solver_statet &state,
+    std::optional<smt_responset> &response)
+    : state(state), response(response)
+  {
+  }
+
+  void visit(const smt_assert_commandt &assert) override
+  {
+    state.solver.add(state.convert(assert.condition()));
+  }
+
+  void visit(const smt_check_sat_commandt &) override
+  {
+    switch(state.solver.check())
+    {
+    case z3::sat:
+      response = smt_check_sat_responset{smt_sat_responset{}};
+      return;
+    case z3::unsat:
+      response = smt_check_sat_responset{smt_unsat_responset{}};
+      return;
+    case z3::unknown:
+      response = smt_check_sat_responset{smt_unknown_responset{}};
+      return;
+    }
+    UNREACHABLE;
+  }
+
+  void visit(const smt_declare_function_commandt &declare_function) override
+  {
+    const smt_identifier_termt &identifier = declare_function.identifier();
+    z3::sort_vector domain{state.context};
+    for(const smt_sortt &sort : declare_function.parameter_sorts())
+      domain.push_back(state.convert(sort));
+    state.declarations.insert_or_assign(
+      identifier.identifier(),
+      state.context.function(
+        id2string(identifier.identifier()).c_str(),
+        domain,
+        state.convert(identifier.get_sort())));
+  }
+
+  void visit(const smt_define_function_commandt &define_function) override
+  {
+    z3::expr_vector parameters{state.context};
+    for(const smt_identifier_termt &parameter : define_function.parameters())
+    {
+      const z3::expr constant = state.context.constant(
+        id2string(parameter.identifier()).c_str(),
+        state.convert(parameter.get_sort()));
+      parameters.push_back(constant);
+      state.bound_variables.insert_or_assign(parameter.identifier(), constant);
+    }
+
+    const z3::expr body = state.convert(define_function.definition());
+
+    for(const smt_identifier_termt &parameter : define_function.parameters())
+      state.bound_variables.erase(parameter.identifier());
+
+    state.definitions.insert_or_assign(
+      define_function.identifier().identifier(),
+      z3_solver_statet::definitiont{parameters, body});
+  }
+
+  void visit(const smt_exit_commandt &) override
+  {
+  }
+
+  void visit(const smt_get_value_commandt &get_value) override
+  {
+    const z3::expr value = state.solver.get_model().eval(
+      state.convert(get_value.descriptor()), true);
+    response = smt_get_value_responset{
+      {{get_value.descriptor(), convert_value(value)}}};
+  }
+
+  void visit(const smt_pop_commandt &pop) override
+  {
+    state.solver.pop(pop.levels());
+  }
+
+  void visit(const smt_push_commandt &push) override
+  {
+    for(std::size_t level = 0; level < push.levels(); ++level)
+      state.solver.push();
+  }
+
+  void visit(const smt_set_logic_commandt &) override
+  {
+    // Z3 chooses its tactics based on the assertions.
+  }
+
+  void visit(const smt_set_option_commandt &) override
+  {
+    // The only option is `produce-models`, and models are always available
+    // through the API.
+  }
+
+private:
+  z3_solver_statet &state;
+  std::optional<smt_responset> &response;
+};
+
+smt_z3_api_solver_processt::smt_z3_api_solver_processt(
+  message_handlert &message_handler,
+  std::unique_ptr<std::ostream> out_stream)
+  : state(std::make_unique<z3_solver_statet>()),
+    desc{std::string{"Z3 "} + Z3_get_full_version() + " API"},
+    out_stream(std::move(out_stream)),
+    log{message_handler}
+{
+}
+
+smt_z3_api_solver_processt::~smt_z3_api_solver_processt() = default;
+
+const std::string &smt_z3_api_solver_processt::description()
+{
+  return desc;
+}
+
+void smt_z3_api_solver_processt::send(const smt_commandt &smt_command)
+{
+  if(out_stream != nullptr)
+  {
+    // flushed, as for the piped solver process
+    *out_stream << smt_to_smt2_string(smt_command) << std::endl;
+  }
+
+  // the error is reported in response to the next command which expects a
+  // response, as it would be by a solver process
+  if(response && response->cast<smt_error_responset>())
+    return;
+
+  try
+  {
+    smt_command.accept(smt_command_to_z3_sendert{*state, response});
+  }
+  catch(const z3::exception &e)
+  {
+    log.debug() << "Z3 API error - " << e.msg() << messaget::eom;
+    response = smt_error_responset{e.msg()};
+  }
+}
+
+smt_responset smt_z3_api_solver_processt::receive_response(
+  const std::unordered_map<irep_idt, smt_identifier_termt> &identifier_table)
+{
+  if(!response)
+    return smt_success_responset{};
+
+  if(response->cast<smt_error_responset>())
+    return *response;
+
+  smt_responset result = std::move(*response);
+  response.reset();
+  return result;
+}
@@ -0,0 +1,58 @@
+// Author: Diffblue Ltd.
+
+/// \file
+/// Incremental SMT solving through the API of Z3, linked into the process.
+
+#ifndef CPROVER_SOLVERS_SMT2_INCREMENTAL_SMT_Z3_API_SOLVER_PROCESS_H
+#define CPROVER_SOLVERS_SMT2_INCREMENTAL_SMT_Z3_API_SOLVER_PROCESS_H
+
+#include <util/message.h>
+
+#include <solvers/smt2_incremental/smt_solver_process.h>
+
+#include <memory>
+#include <optional>
+
+/// The Z3 context and solver, and the functions declared and defined in it.
+class z3_solver_statet;
+
+/// Sends commands to an instance of Z3 in the same process. The terms of
+/// the commands are built directly through the Z3 API and the responses are
+/// read from the Z3 model, which avoids printing commands as SMT-LIB text
+/// and parsing the responses of the solver.
+class smt_z3_api_solver_processt : public smt_base_solver_processt
+{
+public:
+  /// \param message_handler:
+  ///   The messaging system to be used for logging purposes.
+  /// \param out_stream:
+  ///   Pointer to the stream to print the SMT formula. `nullptr` if no output.
+  smt_z3_api_solver_processt(
+    message_handlert &message_handler,
+    std::unique_ptr<std::ostream> out_stream);
+
+  const std::string &description() override;
+
+  void send(const smt_commandt &smt_command) override;
+
+  /// \note Commands other than `check-sat` and `get-value` are answered with
+  ///   a success response. After an error, all responses are that error.
+  smt_responset receive_response(
+    const std::unordered_map<irep_idt, smt_identifier_termt> &identifier_table)
+    override;
+
+  ~smt_z3_api_solver_processt() override;
+
+protected:
+  std::unique_ptr<z3_solver_statet> state;
+  /// Description of the solver, including the version of Z3.
+  std::string desc;
+  /// Pointer to the stream to print the SMT formula. `nullptr` if no output.
+  std::unique_ptr<std::ostream> out_stream;
+  /// The response to the last command, if it has one.
+  std::optional<smt_responset> response;
+  /// For debug printing.
+  messaget log;
+};
+
+#endif // CPROVER_SOLVERS_SMT2_INCREMENTAL_SMT_Z3_API_SOLVER_PROCESS_H
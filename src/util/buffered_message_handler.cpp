@@ -0,0 +1,76 @@
+/*******************************************************************\
+
+Module: Buffered Message Handler
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Buffered Message Handler
+
+#include "buffered_message_handler.h"
+
+#include "json.h"
+#include "structured_data.h"
+#include "xml.h"
+
+buffered_message_handlert::buffered_message_handlert(
+  message_handlert &_target)
+  : target(_target)
+{
+  verbosity = target.get_verbosity();
+}
+
+void buffered_message_handlert::print(
+  unsigned level,
+  const std::string &message)
+{
+  message_handlert::print(level, message);
+  messages.push_back(
+    [level, message](message_handlert &dest) { dest.print(level, message); });
+}
+
+void buffered_message_handlert::print(unsigned level, const xmlt &xml)
+{
+  messages.push_back(
+    [level, xml](message_handlert &dest) { dest.print(level, xml); });
+}
+
+void buffered_message_handlert::print(unsigned level, const jsont &json)
+{
+  messages.push_back(
+    [level, json](message_handlert &dest) { dest.print(level, json); });
+}
+
+void buffered_message_handlert::print(
+  unsigned level,
+  const structured_datat &data)
+{
+  messages.push_back(
+    [level, data](message_handlert &dest) { dest.print(level, data); });
+}
+
+void buffered_message_handlert::print(
+  unsigned level,
+  const std::string &message,
+  const source_locationt &location)
+{
+  message_handlert::print(level, message);
+  messages.push_back([level, message, location](message_handlert &dest) {
+    dest.print(level, message, location);
+  });
+}
+
+void buffered_message_handlert::flush(unsigned level)
+{
+  messages.push_back([level](message_handlert &dest) { dest.flush(level); });
+}
+
+void buffered_message_handlert::replay()
+{
+  for(const auto &message : messages)
+    message(target);
+
+  messages.clear();
+}
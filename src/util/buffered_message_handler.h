@@ -0,0 +1,65 @@
+/*******************************************************************\
+
+Module: Buffered Message Handler
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Buffered Message Handler
+
+#ifndef CPROVER_UTIL_BUFFERED_MESSAGE_HANDLER_H
+#define CPROVER_UTIL_BUFFERED_MESSAGE_HANDLER_H
+
+#include "message.h"
+
+#include <functional>
+#include <vector>
+
+/// Records all messages such that they can be passed on to another message
+/// handler later. This permits, e.g., a worker thread to produce messages
+/// that are output in a deterministic order once the work is done.
+class buffered_message_handlert : public message_handlert
+{
+public:
+  /// \param _target: the message handler that \ref replay passes messages
+  ///   to; its verbosity and terminal commands are used while recording
+  explicit buffered_message_handlert(message_handlert &_target);
+
+  void print(unsigned level, const std::string &message) override;
+
+  void print(unsigned level, const xmlt &xml) override;
+
+  void print(unsigned level, const jsont &json) override;
+
+  void print(unsigned level, const structured_datat &data) override;
+
+  void print(
+    unsigned level,
+    const std::string &message,
+    const source_locationt &location) override;
+
+  void flush(unsigned level) override;
+
+  std::string command(unsigned c) const override
+  {
+    return target.command(c);
+  }
+
+  /// Passes all messages recorded so far on to the target message handler,
+  /// in the order in which they were recorded, and discards them.
+  void replay();
+
+  /// Discards all messages recorded so far.
+  void clear()
+  {
+    messages.clear();
+  }
+
+protected:
+  message_handlert &target;
+  std::vector<std::function<void(message_handlert &)>> messages;
+};
+
+#endif // CPROVER_UTIL_BUFFERED_MESSAGE_HANDLER_H
@@ -0,0 +1,469 @@
+/*******************************************************************\
+
+Module: Chunked Vector
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Chunked Vector
+
+#ifndef CPROVER_UTIL_CHUNKED_VECTOR_H
+#define CPROVER_UTIL_CHUNKED_VECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+#include "invariant.h"
+
+/// A sequence container that stores its elements in chunks of contiguous
+/// memory. Appending never moves elements, hence references to elements
+/// remain valid until the element is removed.
+///
+/// The first chunk is small and each further chunk is twice the size of the
+/// previous one until chunks reach their maximum size, such that short
+/// sequences (and their copies) use little memory.
+///
+/// Iterators are index-based handles: they remain valid when elements are
+/// appended and when the container is moved, and support random access in
+/// constant time. Like any index, an iterator equal to \ref end refers to the
+/// next element to be appended once the container grows.
+///
+/// \tparam T: element type
+/// \tparam first_chunk_bits: the first chunk holds 2^first_chunk_bits elements
+/// \tparam max_chunk_bits: no chunk holds more than 2^max_chunk_bits elements
+template <
+  typename T,
+  std::size_t first_chunk_bits = 4,
+  std::size_t max_chunk_bits = 10>
+class chunked_vectort
+{
+  static_assert(
+    first_chunk_bits <= max_chunk_bits,
+    "the first chunk must not exceed the maximum chunk size");
+
+public:
+  static constexpr std::size_t first_chunk_size = std::size_t(1)
+                                                  << first_chunk_bits;
+  static constexpr std::size_t max_chunk_size = std::size_t(1)
+                                                << max_chunk_bits;
+
+  typedef T value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+
+protected:
+  /// Chunks 0 to growing_chunks - 1 double in size, all further chunks hold
+  /// max_chunk_size elements.
+  static constexpr std::size_t growing_chunks =
+    max_chunk_bits - first_chunk_bits + 1;
+  /// The number of elements in the growing chunks
+  static constexpr std::size_t growing_elements =
+    first_chunk_size * ((std::size_t(1) << growing_chunks) - 1);
+
+  static std::size_t chunk_size(std::size_t chunk_nr)
+  {
+    return chunk_nr < growing_chunks ? first_chunk_size << chunk_nr
+                                     : max_chunk_size;
+  }
+
+  /// \return the number of elements in chunks 0 to chunk_nr - 1
+  static std::size_t capacity(std::size_t chunk_nr)
+  {
+    return chunk_nr <= growing_chunks
+             ? first_chunk_size * ((std::size_t(1) << chunk_nr) - 1)
+             : growing_elements + (chunk_nr - growing_chunks) * max_chunk_size;
+  }
+
+  /// The chunks live in a separate object such that iterators, which point
+  /// to it, are not invalidated by moving the container.
+  struct storaget
+  {
+    std::vector<T *> chunks;
+    std::size_t size = 0;
+
+    T &at(std::size_t index) const
+    {
+      if(index >= growing_elements)
+      {
+        index -= growing_elements;
+        return chunks[growing_chunks + (index >> max_chunk_bits)]
+                     [index & (max_chunk_size - 1)];
+      }
+
+      // chunk c starts at first_chunk_size * (2^c - 1), hence c is the
+      // position of the most significant bit of index / first_chunk_size + 1
+      const unsigned x =
+        static_cast<unsigned>((index >> first_chunk_bits) + 1);
+#if defined(__GNUC__)
+      const std::size_t chunk_nr = sizeof(unsigned) * 8 - 1 - __builtin_clz(x);
+#elif defined(_MSC_VER)
+      unsigned long chunk_nr;
+      _BitScanReverse(&chunk_nr, x);
+#else
+      std::size_t chunk_nr = 0;
+      for(unsigned y = x >> 1; y != 0; y >>= 1)
+        ++chunk_nr;
+#endif
+      return chunks[chunk_nr][index - capacity(chunk_nr)];
+    }
+  };
+
+  /// Only null in a container that has been moved from
+  std::unique_ptr<storaget> storage;
+
+  template <bool is_const>
+  class iterator_templatet
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<is_const, const T *, T *>::type pointer;
+    typedef typename std::conditional<is_const, const T &, T &>::type
+      reference;
+    typedef
+      typename std::conditional<is_const, const storaget *, storaget *>::type
+        storage_pointert;
+
+    iterator_templatet() = default;
+
+    iterator_templatet(storage_pointert _storage, std::size_t _index)
+      : storage(_storage), index_(_index)
+    {
+    }
+
+    /// Conversion from non-const to const iterators
+    template <
+      bool other_is_const,
+      typename = typename std::enable_if<is_const && !other_is_const>::type>
+    // NOLINTNEXTLINE(runtime/explicit)
+    iterator_templatet(const iterator_templatet<other_is_const> &other)
+      : storage(other.storage), index_(other.index_)
+    {
+    }
+
+    /// \return the position of the element in the container
+    std::size_t index() const
+    {
+      return index_;
+    }
+
+    reference operator*() const
+    {
+      PRECONDITION(storage != nullptr && index_ < storage->size);
+      return storage->at(index_);
+    }
+
+    pointer operator->() const
+    {
+      return &**this;
+    }
+
+    reference operator[](difference_type n) const
+    {
+      return *(*this + n);
+    }
+
+    iterator_templatet &operator++()
+    {
+      ++index_;
+      return *this;
+    }
+
+    iterator_templatet operator++(int)
+    {
+      iterator_templatet tmp = *this;
+      ++index_;
+      return tmp;
+    }
+
+    iterator_templatet &operator--()
+    {
+      --index_;
+      return *this;
+    }
+
+    iterator_templatet operator--(int)
+    {
+      iterator_templatet tmp = *this;
+      --index_;
+      return tmp;
+    }
+
+    iterator_templatet &operator+=(difference_type n)
+    {
+      index_ += n;
+      return *this;
+    }
+
+    iterator_templatet &operator-=(difference_type n)
+    {
+      index_ -= n;
+      return *this;
+    }
+
+    iterator_templatet operator+(difference_type n) const
+    {
+      return iterator_templatet(storage, index_ + n);
+    }
+
+    friend iterator_templatet
+    operator+(difference_type n, const iterator_templatet &it)
+    {
+      return it + n;
+    }
+
+    iterator_templatet operator-(difference_type n) const
+    {
+      return iterator_templatet(storage, index_ - n);
+    }
+
+    template <bool other_is_const>
+    difference_type
+    operator-(const iterator_templatet<other_is_const> &other) const
+    {
+      return static_cast<difference_type>(index_) -
+             static_cast<difference_type>(other.index_);
+    }
+
+    template <bool other_is_const>
+    bool operator==(const iterator_templatet<other_is_const> &other) const
+    {
+      return index_ == other.index_ && storage == other.storage;
+    }
+
+    template <bool other_is_const>
+    bool operator!=(const iterator_templatet<other_is_const> &other) const
+    {
+      return !(*this == other);
+    }
+
+    template <bool other_is_const>
+    bool operator<(const iterator_templatet<other_is_const> &other) const
+    {
+      return index_ < other.index_;
+    }
+
+    template <bool other_is_const>
+    bool operator>(const iterator_templatet<other_is_const> &other) const
+    {
+      return other < *this;
+    }
+
+    template <bool other_is_const>
+    bool operator<=(const iterator_templatet<other_is_const> &other) const
+    {
+      return !(other < *this);
+    }
+
+    template <bool other_is_const>
+    bool operator>=(const iterator_templatet<other_is_const> &other) const
+    {
+      return !(*this < other);
+    }
+
+  protected:
+    storage_pointert storage = nullptr;
+    std::size_t index_ = 0;
+
+    friend class iterator_templatet<!is_const>;
+  };
+
+public:
+  typedef iterator_templatet<false> iterator;
+  typedef iterator_templatet<true> const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  chunked_vectort() : storage(new storaget())
+  {
+  }
+
+  chunked_vectort(const chunked_vectort &other) : chunked_vectort()
+  {
+    for(const auto &element : other)
+      push_back(element);
+  }
+
+  /// Leaves \p other without storage, which is allocated again when an
+  /// element is appended to it
+  chunked_vectort(chunked_vectort &&other) noexcept
+    : storage(std::move(other.storage))
+  {
+  }
+
+  chunked_vectort &operator=(const chunked_vectort &other)
+  {
+    if(this != &other)
+    {
+      chunked_vectort tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  chunked_vectort &operator=(chunked_vectort &&other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
+  ~chunked_vectort()
+  {
+    clear();
+  }
+
+  void swap(chunked_vectort &other) noexcept
+  {
+    storage.swap(other.storage);
+  }
+
+  std::size_t size() const
+  {
+    return storage ? storage->size : 0;
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  T &operator[](std::size_t index)
+  {
+    PRECONDITION(index < size());
+    return storage->at(index);
+  }
+
+  const T &operator[](std::size_t index) const
+  {
+    PRECONDITION(index < size());
+    return storage->at(index);
+  }
+
+  T &front()
+  {
+    return (*this)[0];
+  }
+
+  const T &front() const
+  {
+    return (*this)[0];
+  }
+
+  T &back()
+  {
+    return (*this)[size() - 1];
+  }
+
+  const T &back() const
+  {
+    return (*this)[size() - 1];
+  }
+
+  template <typename... argst>
+  T &emplace_back(argst &&...args)
+  {
+    if(!storage)
+      storage.reset(new storaget());
+
+    const std::size_t index = storage->size;
+    const std::size_t chunk_nr = storage->chunks.size();
+    if(index == capacity(chunk_nr))
+    {
+      storage->chunks.push_back(
+        std::allocator<T>().allocate(chunk_size(chunk_nr)));
+    }
+
+    T *element = &storage->at(index);
+    new(element) T(std::forward<argst>(args)...);
+    ++storage->size;
+    return *element;
+  }
+
+  void push_back(const T &element)
+  {
+    emplace_back(element);
+  }
+
+  void push_back(T &&element)
+  {
+    emplace_back(std::move(element));
+  }
+
+  /// Destroys all elements and releases the memory of all chunks
+  void clear()
+  {
+    if(!storage)
+      return;
+    for(std::size_t i = 0; i < storage->size; ++i)
+      storage->at(i).~T();
+    for(std::size_t i = 0; i < storage->chunks.size(); ++i)
+      std::allocator<T>().deallocate(storage->chunks[i], chunk_size(i));
+    storage->chunks.clear();
+    storage->size = 0;
+  }
+
+  iterator begin()
+  {
+    return iterator(storage.get(), 0);
+  }
+
+  iterator end()
+  {
+    return iterator(storage.get(), size());
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(storage.get(), 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(storage.get(), size());
+  }
+
+  const_iterator cbegin() const
+  {
+    return begin();
+  }
+
+  const_iterator cend() const
+  {
+    return end();
+  }
+
+  reverse_iterator rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  reverse_iterator rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+};
+
+#endif // CPROVER_UTIL_CHUNKED_VECTOR_H
@@ -14,12 +14,22 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "string2int.h"
 #include "irep_hash.h"
 
+#if IREP_ATOMIC_REF_COUNT
+#  include <mutex>
+#endif
+
 irept nil_rep_storage;
 
 const irept &get_nil_irep()
 {
+#if IREP_ATOMIC_REF_COUNT
+  // may be called from several threads
+  static std::once_flag initialized;
+  std::call_once(initialized, [] { nil_rep_storage.id(ID_nil); });
+#else
   if(nil_rep_storage.id().empty()) // initialized?
     nil_rep_storage.id(ID_nil);
+#endif
   return nil_rep_storage;
 }
 
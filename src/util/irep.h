@@ -27,6 +27,26 @@ Author: Daniel Kroening, kroening@kroening.com
 #  define NAMED_SUB_IS_FORWARD_LIST 1
 #endif
 
+// Use atomic reference counts so that ireps can be shared between threads;
+// off by default as atomic operations are more costly.
+#ifndef IREP_ATOMIC_REF_COUNT
+#  define IREP_ATOMIC_REF_COUNT 0
+#endif
+
+#if IREP_ATOMIC_REF_COUNT
+#  include <atomic>
+#endif
+
+// Allocate tree nodes from a slab pool instead of individually on the heap;
+// off by default, see \ref node_poolt.
+#ifndef IREP_NODE_POOL
+#  define IREP_NODE_POOL 0
+#endif
+
+#if IREP_NODE_POOL
+#  include "node_pool.h"
+#endif
+
 #if NAMED_SUB_IS_FORWARD_LIST
 #  include "forward_list_as_map.h"
 #else
@@ -64,9 +84,95 @@ struct ref_count_ift
 template <>
 struct ref_count_ift<true>
 {
+#if IREP_ATOMIC_REF_COUNT
+  std::atomic<unsigned> ref_count{1};
+#else
   unsigned ref_count = 1;
+#endif
+
+  ref_count_ift() = default;
+
+  // A copy is a new node, which starts with a single reference.
+  ref_count_ift(const ref_count_ift &)
+  {
+  }
+
+  ref_count_ift &operator=(const ref_count_ift &)
+  {
+    return *this;
+  }
+
+  void increment_ref_count()
+  {
+#if IREP_ATOMIC_REF_COUNT
+    ref_count.fetch_add(1, std::memory_order_relaxed);
+#else
+    ++ref_count;
+#endif
+  }
+
+  /// \return true if the last reference has been removed
+  bool decrement_ref_count()
+  {
+#if IREP_ATOMIC_REF_COUNT
+    // acquire-release such that the thread that deletes the node sees all
+    // accesses by other threads that held a reference
+    return ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+#else
+    return --ref_count == 0;
+#endif
+  }
+
+  unsigned get_ref_count() const
+  {
+#if IREP_ATOMIC_REF_COUNT
+    return ref_count.load(std::memory_order_acquire);
+#else
+    return ref_count;
+#endif
+  }
 };
 
+#if HASH_CODE && IREP_ATOMIC_REF_COUNT
+/// The cached hash code of a node that may be shared between threads.
+/// Concurrent readers may compute and store the hash code at the same time,
+/// which is benign as they all store the same value, but must be atomic.
+class irep_hash_codet
+{
+public:
+  // NOLINTNEXTLINE(runtime/explicit)
+  irep_hash_codet(std::size_t hash_code = 0) : hash_code(hash_code)
+  {
+  }
+
+  irep_hash_codet(const irep_hash_codet &other)
+    : hash_code(static_cast<std::size_t>(other))
+  {
+  }
+
+  irep_hash_codet &operator=(const irep_hash_codet &other)
+  {
+    return *this = static_cast<std::size_t>(other);
+  }
+
+  irep_hash_codet &operator=(std::size_t new_hash_code)
+  {
+    hash_code.store(new_hash_code, std::memory_order_relaxed);
+    return *this;
+  }
+
+  operator std::size_t() const
+  {
+    return hash_code.load(std::memory_order_relaxed);
+  }
+
+protected:
+  std::atomic<std::size_t> hash_code;
+};
+#elif HASH_CODE
+typedef std::size_t irep_hash_codet;
+#endif
+
 /// A node with data in a tree, it contains:
 ///
 /// * \ref irept::dt::data : A \ref dstringt and thus an integer which is a
@@ -81,10 +187,14 @@ struct ref_count_ift<true>
 ///   ordered but unnamed children.
 ///
 /// * \c ref_count : if sharing is activated, this is used to count the number
-///   of references to a node.
+///   of references to a node. With IREP_ATOMIC_REF_COUNT this count is atomic,
+///   which permits sharing nodes between threads, as long as each thread only
+///   modifies the ireps it owns (copy-on-write takes care of shared nodes).
 ///
 /// * \c hash_code : if HASH_CODE is activated, this is used to cache the
 ///   result of the hash function.
+///
+/// With IREP_NODE_POOL, nodes are allocated from a \ref node_poolt.
 template <typename treet, typename named_subtreest, bool sharing = true>
 class tree_nodet : public ref_count_ift<sharing>
 {
@@ -106,7 +216,7 @@ class tree_nodet : public ref_count_ift<sharing>
   subt sub;
 
 #if HASH_CODE
-  mutable std::size_t hash_code = 0;
+  mutable irep_hash_codet hash_code = 0;
 #endif
 
   void clear()
@@ -141,6 +251,29 @@ class tree_nodet : public ref_count_ift<sharing>
       sub(std::move(_sub))
   {
   }
+
+#if IREP_NODE_POOL
+  /// The pool that all nodes of this type are allocated from
+  static node_poolt &node_pool()
+  {
+    // Never destroyed: ireps with static storage duration may release their
+    // nodes after all other static objects have been destroyed.
+    static node_poolt *pool =
+      new node_poolt(sizeof(tree_nodet), IREP_ATOMIC_REF_COUNT);
+    return *pool;
+  }
+
+  static void *operator new(std::size_t size)
+  {
+    PRECONDITION(size == sizeof(tree_nodet));
+    return node_pool().allocate();
+  }
+
+  static void operator delete(void *node)
+  {
+    node_pool().deallocate(node);
+  }
+#endif
 };
 
 /// Base class for tree-like data structures with sharing
@@ -174,10 +307,10 @@ class sharing_treet
   {
     if(data!=&empty_d)
     {
-      PRECONDITION(data->ref_count != 0);
-      data->ref_count++;
+      PRECONDITION(data->get_ref_count() != 0);
+      data->increment_ref_count();
 #ifdef IREP_DEBUG
-      std::cout << "COPY " << data << " " << data->ref_count << '\n';
+      std::cout << "COPY " << data << " " << data->get_ref_count() << '\n';
 #endif
     }
   }
@@ -203,7 +336,7 @@ class sharing_treet
     // Consider self-assignment, which may destroy 'irep'
     dt *irep_data=irep.data;
     if(irep_data!=&empty_d)
-      irep_data->ref_count++;
+      irep_data->increment_ref_count();
 
     remove_ref(data); // this may kill 'irep'
     data=irep_data;
@@ -521,20 +654,20 @@ void sharing_treet<derivedt, named_subtreest>::detach()
     std::cout << "ALLOCATED " << data << '\n';
 #endif
   }
-  else if(data->ref_count > 1)
+  else if(data->get_ref_count() > 1)
   {
     dt *old_data(data);
+    // the copy starts with a single reference
     data = new dt(*old_data);
 
 #ifdef IREP_DEBUG
     std::cout << "ALLOCATED " << data << '\n';
 #endif
 
-    data->ref_count = 1;
     remove_ref(old_data);
   }
 
-  POSTCONDITION(data->ref_count == 1);
+  POSTCONDITION(data->get_ref_count() == 1);
 
 #ifdef IREP_DEBUG
   std::cout << "DETACH2: " << data << '\n';
@@ -551,14 +684,13 @@ void sharing_treet<derivedt, named_subtreest>::remove_ref(dt *old_data)
     nonrecursive_destructor(old_data);
 #else
 
-  PRECONDITION(old_data->ref_count != 0);
+  PRECONDITION(old_data->get_ref_count() != 0);
 
 #ifdef IREP_DEBUG
-  std::cout << "R: " << old_data << " " << old_data->ref_count << '\n';
+  std::cout << "R: " << old_data << " " << old_data->get_ref_count() << '\n';
 #endif
 
-  old_data->ref_count--;
-  if(old_data->ref_count == 0)
+  if(old_data->decrement_ref_count())
   {
 #ifdef IREP_DEBUG
     std::cout << "D: " << pretty() << '\n';
@@ -592,10 +724,10 @@ void sharing_treet<derivedt, named_subtreest>::nonrecursive_destructor(
     if(d == &empty_d)
       continue;
 
-    INVARIANT(d->ref_count != 0, "All contents of the stack must be in use");
-    d->ref_count--;
+    INVARIANT(
+      d->get_ref_count() != 0, "All contents of the stack must be in use");
 
-    if(d->ref_count == 0)
+    if(d->decrement_ref_count())
     {
       stack.reserve(
         stack.size() + std::distance(d->named_sub.begin(), d->named_sub.end()) +
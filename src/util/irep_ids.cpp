@@ -45,7 +45,7 @@ enum class idt:unsigned
 string_containert::string_containert()
 {
   // pre-allocate empty string -- this gets index 0
-  get("");
+  operator[]("");
 
   // allocate strings
   for(unsigned i=0; irep_ids_table[i]!=nullptr; i++)
@@ -212,6 +212,12 @@ void irep_serializationt::write_string_ref(
   std::ostream &out,
   const irep_idt &s)
 {
+  if(string_table != nullptr)
+  {
+    write_gb_word(out, string_table->number(s));
+    return;
+  }
+
   size_t id = s.get_no();
   if(id>=ireps_container.string_map.size())
     ireps_container.string_map.resize(id+1, false);
@@ -233,6 +239,9 @@ irep_idt irep_serializationt::read_string_ref(std::istream &in)
 {
   std::size_t id=read_gb_word(in);
 
+  if(string_table != nullptr)
+    return (*string_table)[id];
+
   if(id>=ireps_container.string_rev_map.size())
     ireps_container.string_rev_map.resize(1+id*2,
       std::pair<bool, irep_idt>(false, irep_idt()));
@@ -246,3 +255,32 @@ irep_idt irep_serializationt::read_string_ref(std::istream &in)
 
   return ireps_container.string_rev_map[id].second;
 }
+
+std::size_t irep_string_tablet::number(const irep_idt &s)
+{
+  const auto entry = numbers.emplace(s, strings.size());
+  if(entry.second)
+    strings.push_back(s);
+  return entry.first->second;
+}
+
+void irep_string_tablet::push_back(std::string_view s)
+{
+  views.push_back(s);
+  strings.emplace_back();
+}
+
+irep_idt irep_string_tablet::operator[](std::size_t n)
+{
+  if(n >= views.size())
+    throw deserialization_exceptiont("string number out of range");
+
+  // the empty string is the only one that is never interned here
+  if(strings[n].empty() && !views[n].empty())
+  {
+    strings[n] =
+      irep_idt::make_from_table_index(get_string_container()[views[n]]);
+  }
+
+  return strings[n];
+}
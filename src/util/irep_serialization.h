@@ -14,9 +14,11 @@ Date: May 2007
 #ifndef CPROVER_UTIL_IREP_SERIALIZATION_H
 #define CPROVER_UTIL_IREP_SERIALIZATION_H
 
-#include <map>
 #include <iosfwd>
+#include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "irep_hash_container.h"
@@ -25,6 +27,36 @@ Date: May 2007
 void write_gb_word(std::ostream &, std::size_t);
 void write_gb_string(std::ostream &, const std::string &);
 
+/// The strings of ireps that \ref irep_serializationt writes to and reads
+/// from a table of their own, rather than inline with the first irep that
+/// uses them. This makes it possible to read ireps without reading all the
+/// ireps that were written before them.
+class irep_string_tablet
+{
+public:
+  /// Number of \p s in the table, which is added if it is not there yet
+  std::size_t number(const irep_idt &s);
+
+  /// The strings in the order of their numbers
+  const std::vector<irep_idt> &get_strings() const
+  {
+    return strings;
+  }
+
+  /// Make \p s the next string of the table. The characters of \p s are
+  /// only copied when the string is used and not interned yet, hence they
+  /// need to remain valid while the table is used.
+  void push_back(std::string_view s);
+
+  /// The string with number \p n
+  irep_idt operator[](std::size_t n);
+
+private:
+  std::unordered_map<irep_idt, std::size_t> numbers;
+  std::vector<irep_idt> strings;
+  std::vector<std::string_view> views;
+};
+
 class irep_serializationt
 {
 public:
@@ -61,6 +93,13 @@ class irep_serializationt
     clear();
   };
 
+  /// Write strings to and read strings from \p st rather than inline
+  irep_serializationt(ireps_containert &ic, irep_string_tablet &st)
+    : irep_serializationt(ic)
+  {
+    string_table = &st;
+  }
+
   const irept &reference_convert(std::istream &);
   void reference_convert(const irept &irep, std::ostream &);
 
@@ -74,6 +113,7 @@ class irep_serializationt
 
 private:
   ireps_containert &ireps_container;
+  irep_string_tablet *string_table = nullptr;
   std::vector<char> read_buffer;
 
   void write_irep(std::ostream &, const irept &irep);
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "string_constant.h"
 
 #include <algorithm>
+#include <atomic>
 
 static exprt bv_to_expr(
   const exprt &bitvector_expr,
@@ -478,11 +479,12 @@ static exprt unpack_array_vector_no_known_bounds(
 
   // TODO we either need a symbol table here or make array comprehensions
   // introduce a scope
-  static std::size_t array_comprehension_index_counter = 0;
-  ++array_comprehension_index_counter;
+  static std::atomic<std::size_t> array_comprehension_index_counter{0};
+  const std::size_t array_comprehension_index_number =
+    ++array_comprehension_index_counter;
   symbol_exprt array_comprehension_index{
     "$array_comprehension_index_a_v" +
-      std::to_string(array_comprehension_index_counter),
+      std::to_string(array_comprehension_index_number),
     index_type};
 
   index_exprt element{
@@ -1145,11 +1147,12 @@ static exprt lower_byte_extract_array_vector(
 
   // TODO we either need a symbol table here or make array comprehensions
   // introduce a scope
-  static std::size_t array_comprehension_index_counter = 0;
-  ++array_comprehension_index_counter;
+  static std::atomic<std::size_t> array_comprehension_index_counter{0};
+  const std::size_t array_comprehension_index_number =
+    ++array_comprehension_index_counter;
   symbol_exprt array_comprehension_index{
     "$array_comprehension_index_a" +
-      std::to_string(array_comprehension_index_counter),
+      std::to_string(array_comprehension_index_number),
     array_type.index_type()};
 
   plus_exprt new_offset{
@@ -1495,11 +1498,12 @@ static exprt lower_byte_update_byte_array_vector_non_const(
 {
   // TODO we either need a symbol table here or make array comprehensions
   // introduce a scope
-  static std::size_t array_comprehension_index_counter = 0;
-  ++array_comprehension_index_counter;
+  static std::atomic<std::size_t> array_comprehension_index_counter{0};
+  const std::size_t array_comprehension_index_number =
+    ++array_comprehension_index_counter;
   symbol_exprt array_comprehension_index{
     "$array_comprehension_index_u_a_v" +
-      std::to_string(array_comprehension_index_counter),
+      std::to_string(array_comprehension_index_number),
     to_array_type(src.type()).index_type()};
 
   binary_predicate_exprt lower_bound{
@@ -1648,11 +1652,12 @@ static exprt lower_byte_update_array_vector_unbounded(
 
   // TODO we either need a symbol table here or make array comprehensions
   // introduce a scope
-  static std::size_t array_comprehension_index_counter = 0;
-  ++array_comprehension_index_counter;
+  static std::atomic<std::size_t> array_comprehension_index_counter{0};
+  const std::size_t array_comprehension_index_number =
+    ++array_comprehension_index_counter;
   symbol_exprt array_comprehension_index{
     "$array_comprehension_index_u_a_v_u" +
-      std::to_string(array_comprehension_index_counter),
+      std::to_string(array_comprehension_index_number),
     to_array_type(src.type()).index_type()};
 
   // all arithmetic uses offset/index types
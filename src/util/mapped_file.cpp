@@ -0,0 +1,85 @@
+/*******************************************************************\
+
+Module: Read-only memory-mapped files
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Read-only memory-mapped files
+
+#include "mapped_file.h"
+
+#include "exception_utils.h"
+#include "unicode.h"
+
+#ifdef _WIN32
+#  include <fstream>
+#  include <iterator>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+mapped_filet::mapped_filet(const std::string &filename)
+{
+  std::ifstream in(widen_if_needed(filename), std::ios::binary);
+  if(!in)
+    throw system_exceptiont("failed to open '" + filename + "'");
+
+  buffer.assign(
+    std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  data = buffer.data();
+  size = buffer.size();
+}
+
+mapped_filet::~mapped_filet()
+{
+}
+
+#else
+
+mapped_filet::mapped_filet(const std::string &filename)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    throw system_exceptiont("failed to open '" + filename + "'");
+
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0)
+  {
+    close(fd);
+    throw system_exceptiont(
+      "failed to determine the size of '" + filename + "'");
+  }
+
+  size = static_cast<std::size_t>(file_stat.st_size);
+
+  // mapping zero bytes fails
+  if(size != 0)
+  {
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(mapping == MAP_FAILED)
+    {
+      close(fd);
+      throw system_exceptiont("failed to map '" + filename + "' into memory");
+    }
+    data = static_cast<const char *>(mapping);
+  }
+
+  // the mapping remains valid after closing the file
+  close(fd);
+}
+
+mapped_filet::~mapped_filet()
+{
+  if(size != 0)
+    munmap(const_cast<char *>(data), size);
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*******************************************************************\
+
+Module: Read-only memory-mapped files
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Read-only memory-mapped files
+
+#ifndef CPROVER_UTIL_MAPPED_FILE_H
+#define CPROVER_UTIL_MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+
+/// The contents of a file, which are mapped into memory such that only the
+/// parts that are accessed are read from disk. On systems without mmap the
+/// file is read into memory as a whole.
+class mapped_filet
+{
+public:
+  /// \throws system_exceptiont if \p filename cannot be opened or mapped
+  explicit mapped_filet(const std::string &filename);
+  ~mapped_filet();
+
+  mapped_filet(const mapped_filet &) = delete;
+  mapped_filet &operator=(const mapped_filet &) = delete;
+
+  /// The contents of the file, which remain valid while this object exists
+  std::string_view contents() const
+  {
+    return {data, size};
+  }
+
+private:
+  const char *data = nullptr;
+  std::size_t size = 0;
+
+  /// The contents of the file where it could not be mapped
+  std::string buffer;
+};
+
+#endif // CPROVER_UTIL_MAPPED_FILE_H
@@ -145,7 +145,11 @@ const irept &merge_irept::merged(const irept &irep)
 {
   auto entry = irep_store.insert(irep);
   if(!entry.second)
+  {
+    if(&entry.first->read() != &irep.read())
+      ++merged_count;
     return *entry.first;
+  }
 
   const irept::subt &src_sub=irep.get_sub();
   irept::subt *dest_sub_ptr = nullptr;
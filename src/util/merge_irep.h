@@ -107,9 +107,23 @@ class merge_irept
 public:
   void operator()(irept &);
 
+  /// \return the number of distinct ireps held by the store
+  std::size_t size() const
+  {
+    return irep_store.size();
+  }
+
+  /// \return the number of ireps that were replaced by an identical one
+  ///   already held by the store
+  std::size_t number_of_merged() const
+  {
+    return merged_count;
+  }
+
 protected:
   typedef std::unordered_set<irept, irep_hash> irep_storet;
   irep_storet irep_store;
+  std::size_t merged_count = 0;
 
   const irept &merged(const irept &irep);
 };
@@ -0,0 +1,178 @@
+/*******************************************************************\
+
+Module: Pool Allocator for Fixed-Size Nodes
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Pool Allocator for Fixed-Size Nodes
+
+#include "node_pool.h"
+
+#include "invariant.h"
+
+#include <algorithm>
+#include <new>
+#include <ostream>
+
+/// Rounds \p size up to a multiple of the fundamental alignment
+static std::size_t align_size(std::size_t size)
+{
+  const std::size_t alignment = alignof(std::max_align_t);
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+node_poolt::node_poolt(std::size_t _node_size, bool _thread_safe)
+  : node_size(align_size(std::max(_node_size, sizeof(free_nodet)))),
+    thread_safe(_thread_safe)
+{
+  PRECONDITION(align_size(sizeof(slabt)) + node_size <= slab_size);
+}
+
+node_poolt::~node_poolt()
+{
+  while(slabs != nullptr)
+  {
+    slabt *next = slabs->next;
+    ::operator delete(slabs, std::align_val_t(slab_size));
+    slabs = next;
+  }
+}
+
+void node_poolt::new_slab()
+{
+  void *memory = ::operator new(slab_size, std::align_val_t(slab_size));
+  slabt *slab = static_cast<slabt *>(memory);
+  slab->next = slabs;
+  slab->live_nodes = 0;
+  slabs = slab;
+
+  bump = static_cast<char *>(memory) + align_size(sizeof(slabt));
+  bump_end = static_cast<char *>(memory) + slab_size;
+
+  ++statistics.slabs;
+}
+
+void *node_poolt::allocate_unlocked()
+{
+  void *node;
+
+  if(free_list != nullptr)
+  {
+    node = free_list;
+    free_list = free_list->next;
+  }
+  else
+  {
+    if(bump == nullptr || bump + node_size > bump_end)
+      new_slab();
+
+    node = bump;
+    bump += node_size;
+  }
+
+  ++slab_of(node)->live_nodes;
+
+  ++statistics.allocations;
+  if(++statistics.live_nodes > statistics.peak_live_nodes)
+    statistics.peak_live_nodes = statistics.live_nodes;
+
+  return node;
+}
+
+void node_poolt::deallocate_unlocked(void *node)
+{
+  PRECONDITION(slab_of(node)->live_nodes != 0);
+  --slab_of(node)->live_nodes;
+
+  free_nodet *free_node = static_cast<free_nodet *>(node);
+  free_node->next = free_list;
+  free_list = free_node;
+
+  ++statistics.deallocations;
+  --statistics.live_nodes;
+}
+
+void *node_poolt::allocate()
+{
+  if(!thread_safe)
+    return allocate_unlocked();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return allocate_unlocked();
+}
+
+void node_poolt::deallocate(void *node)
+{
+  if(!thread_safe)
+    return deallocate_unlocked(node);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  deallocate_unlocked(node);
+}
+
+std::size_t node_poolt::release_free_slabs()
+{
+  std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+  if(thread_safe)
+    lock.lock();
+
+  // drop the free nodes that belong to slabs about to be released
+  free_nodet **free_it = &free_list;
+  while(*free_it != nullptr)
+  {
+    if(slab_of(*free_it)->live_nodes == 0)
+      *free_it = (*free_it)->next;
+    else
+      free_it = &(*free_it)->next;
+  }
+
+  std::size_t released = 0;
+  slabt **slab_it = &slabs;
+  while(*slab_it != nullptr)
+  {
+    slabt *slab = *slab_it;
+    if(slab->live_nodes != 0)
+    {
+      slab_it = &slab->next;
+      continue;
+    }
+
+    if(bump != nullptr && slab_of(bump - 1) == slab)
+      bump = bump_end = nullptr;
+
+    *slab_it = slab->next;
+    ::operator delete(slab, std::align_val_t(slab_size));
+    ++released;
+  }
+
+  statistics.slabs -= released;
+  statistics.released_slabs += released;
+
+  return released;
+}
+
+node_pool_statisticst node_poolt::compute_statistics() const
+{
+  std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+  if(thread_safe)
+    lock.lock();
+
+  node_pool_statisticst result = statistics;
+  result.memory_usage = memory_sizet::from_bytes(statistics.slabs * slab_size);
+  return result;
+}
+
+void node_pool_statisticst::dump_on_stream(std::ostream &out) const
+{
+  out << "Node pool statistics:"
+      << "\n  allocations:     " << allocations
+      << "\n  deallocations:   " << deallocations
+      << "\n  live nodes:      " << live_nodes
+      << "\n  peak live nodes: " << peak_live_nodes
+      << "\n  slabs:           " << slabs
+      << "\n  released slabs:  " << released_slabs
+      << "\n  memory usage:    " << memory_usage.to_string();
+}
@@ -0,0 +1,110 @@
+/*******************************************************************\
+
+Module: Pool Allocator for Fixed-Size Nodes
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Pool Allocator for Fixed-Size Nodes
+
+#ifndef CPROVER_UTIL_NODE_POOL_H
+#define CPROVER_UTIL_NODE_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+
+#include "memory_units.h"
+
+/// Allocation counters of a \ref node_poolt
+struct node_pool_statisticst
+{
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t live_nodes = 0;
+  std::size_t peak_live_nodes = 0;
+  std::size_t slabs = 0;
+  std::size_t released_slabs = 0;
+  memory_sizet memory_usage;
+
+  void dump_on_stream(std::ostream &out) const;
+};
+
+/// Allocates nodes of a fixed size from slabs of contiguous memory.
+/// Allocation takes a node from a free list or carves it off the most recent
+/// slab; deallocation returns the node to the free list, hence neither calls
+/// into the general-purpose allocator in the common case.
+///
+/// Slabs are aligned to their size so that the slab owning a node can be
+/// found from the node's address, which permits tracking the number of live
+/// nodes per slab. Once a phase that allocated many short-lived nodes has
+/// ended, \ref release_free_slabs returns all slabs without live nodes to the
+/// system in bulk. Nodes that are still referenced keep their slab alive.
+class node_poolt
+{
+public:
+  /// \param node_size: size in bytes of the nodes to be allocated
+  /// \param thread_safe: protect the pool with a mutex so that nodes can be
+  ///   allocated and deallocated from several threads
+  explicit node_poolt(std::size_t node_size, bool thread_safe = false);
+  ~node_poolt();
+
+  node_poolt(const node_poolt &) = delete;
+  node_poolt &operator=(const node_poolt &) = delete;
+
+  /// \return uninitialized memory for one node
+  void *allocate();
+
+  /// Return a node obtained from \ref allocate to the pool
+  void deallocate(void *node);
+
+  /// Return all slabs that do not contain any live node to the system.
+  /// The cost is linear in the number of slabs and free nodes.
+  /// \return the number of slabs released
+  std::size_t release_free_slabs();
+
+  node_pool_statisticst compute_statistics() const;
+
+  /// Size of a slab, which is also its alignment
+  static constexpr std::size_t slab_size = std::size_t(1) << 16;
+
+protected:
+  struct slabt
+  {
+    slabt *next;
+    std::size_t live_nodes;
+  };
+
+  struct free_nodet
+  {
+    free_nodet *next;
+  };
+
+  const std::size_t node_size;
+  const bool thread_safe;
+  mutable std::mutex mutex;
+
+  slabt *slabs = nullptr;
+  free_nodet *free_list = nullptr;
+
+  // unused part of the most recently allocated slab
+  char *bump = nullptr;
+  char *bump_end = nullptr;
+
+  node_pool_statisticst statistics;
+
+  static slabt *slab_of(void *node)
+  {
+    return reinterpret_cast<slabt *>(
+      reinterpret_cast<std::uintptr_t>(node) & ~(slab_size - 1));
+  }
+
+  void *allocate_unlocked();
+  void deallocate_unlocked(void *node);
+  void new_slab();
+};
+
+#endif // CPROVER_UTIL_NODE_POOL_H
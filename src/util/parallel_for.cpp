@@ -0,0 +1,86 @@
+/*******************************************************************\
+
+Module: Parallel Loops
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Parallel Loops
+
+#include "parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+std::size_t effective_number_of_threads(std::size_t number_of_threads)
+{
+  if(number_of_threads == 0)
+    number_of_threads = std::thread::hardware_concurrency();
+
+  return std::max(number_of_threads, std::size_t(1));
+}
+
+void parallel_for(
+  std::size_t number_of_threads,
+  std::size_t size,
+  const std::function<void(std::size_t thread, std::size_t index)> &body)
+{
+  number_of_threads =
+    std::min(effective_number_of_threads(number_of_threads), size);
+
+  if(number_of_threads <= 1)
+  {
+    for(std::size_t index = 0; index < size; ++index)
+      body(0, index);
+    return;
+  }
+
+  std::atomic<std::size_t> next_index{0};
+  std::vector<std::exception_ptr> exceptions(number_of_threads);
+
+  auto worker = [&](std::size_t thread) {
+    try
+    {
+      for(std::size_t index = next_index++; index < size; index = next_index++)
+        body(thread, index);
+    }
+    catch(...)
+    {
+      exceptions[thread] = std::current_exception();
+      next_index = size;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads - 1);
+
+  for(std::size_t thread = 1; thread < number_of_threads; ++thread)
+  {
+    try
+    {
+      threads.emplace_back(worker, thread);
+    }
+    catch(const std::system_error &)
+    {
+      // continue with the threads started so far
+      break;
+    }
+  }
+
+  worker(0);
+
+  for(auto &thread : threads)
+    thread.join();
+
+  for(const auto &exception : exceptions)
+  {
+    if(exception)
+      std::rethrow_exception(exception);
+  }
+}
@@ -0,0 +1,40 @@
+/*******************************************************************\
+
+Module: Parallel Loops
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Parallel Loops
+
+#ifndef CPROVER_UTIL_PARALLEL_FOR_H
+#define CPROVER_UTIL_PARALLEL_FOR_H
+
+#include <cstddef>
+#include <functional>
+
+/// \param number_of_threads: requested number of threads, 0 meaning one per
+///   hardware thread
+/// \return the number of threads to use, which is at least one
+std::size_t effective_number_of_threads(std::size_t number_of_threads);
+
+/// Calls \p body for each index in [0, \p size) using up to
+/// \p number_of_threads threads, the calling thread being one of them.
+/// Indices are handed out one at a time in ascending order, hence the order in
+/// which \p body is called for different indices is unspecified.
+/// Once \p body has thrown an exception no further indices are handed out;
+/// after all threads have finished, the exception is rethrown.
+/// \param number_of_threads: maximum number of threads, 0 meaning one per
+///   hardware thread
+/// \param size: number of indices
+/// \param body: called with the number of the thread (below the number of
+///   threads) and the index; calls from the same thread never overlap, which
+///   permits keeping state per thread
+void parallel_for(
+  std::size_t number_of_threads,
+  std::size_t size,
+  const std::function<void(std::size_t thread, std::size_t index)> &body);
+
+#endif // CPROVER_UTIL_PARALLEL_FOR_H
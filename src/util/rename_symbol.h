@@ -57,6 +57,12 @@ class rename_symbolt
     return rename(dest);
   }
 
+  /// \return true if, and only if, no symbol is renamed
+  bool empty() const
+  {
+    return expr_map.empty() && type_map.empty();
+  }
+
   rename_symbolt();
   virtual ~rename_symbolt();
 
@@ -0,0 +1,55 @@
+/*******************************************************************\
+
+Module: SHA-256 Message Digest
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// SHA-256 Message Digest
+
+#ifndef CPROVER_UTIL_SHA256_H
+#define CPROVER_UTIL_SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/// Computes the SHA-256 digest (FIPS 180-4) of a sequence of bytes, which
+/// unlike \ref hash_string is suitable where a collision must not go
+/// unnoticed, e.g., to identify the contents of a cache entry.
+class sha256t
+{
+public:
+  typedef std::array<std::uint8_t, 32> digestt;
+
+  sha256t();
+
+  /// Append \p size bytes starting at \p data to the message
+  void update(const void *data, std::size_t size);
+
+  void update(std::string_view data)
+  {
+    update(data.data(), data.size());
+  }
+
+  /// \return the digest of the message appended so far; further bytes may
+  ///   be appended afterwards
+  digestt digest() const;
+
+  /// \return \p digest as a string of 64 lower-case hexadecimal digits
+  static std::string to_hex(const digestt &digest);
+
+protected:
+  std::array<std::uint32_t, 8> state;
+  std::array<std::uint8_t, 64> block;
+  /// Number of bytes appended so far
+  std::uint64_t length;
+
+  void compress();
+};
+
+#endif // CPROVER_UTIL_SHA256_H
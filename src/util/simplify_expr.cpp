@@ -38,30 +38,6 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "simplify_expr_class.h"
 
-// #define USE_CACHE
-
-#ifdef USE_CACHE
-struct simplify_expr_cachet
-{
-public:
-  #if 1
-  typedef std::unordered_map<
-    exprt, exprt, irep_full_hash, irep_full_eq> containert;
-  #else
-  typedef std::unordered_map<exprt, exprt, irep_hash> containert;
-  #endif
-
-  containert container_normal;
-
-  containert &container()
-  {
-    return container_normal;
-  }
-};
-
-simplify_expr_cachet simplify_expr_cache;
-#endif
-
 simplify_exprt::resultt<> simplify_exprt::simplify_abs(const abs_exprt &expr)
 {
   if(expr.op().is_constant())
@@ -3137,24 +3113,22 @@ simplify_exprt::resultt<> simplify_exprt::simplify_node(const exprt &node)
 
 simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
 {
-  // look up in cache
-
-  #ifdef USE_CACHE
-  std::pair<simplify_expr_cachet::containert::iterator, bool>
-    cache_result=simplify_expr_cache.container().
-      insert(std::pair<exprt, exprt>(expr, exprt()));
-
-  if(!cache_result.second) // found!
+#ifdef SHARING
+  // Only nodes that are shared can be encountered again, hence only those are
+  // looked up in and stored in the cache.
+  const void *cache_key = nullptr;
+  if(expr.read().get_ref_count() > 1)
   {
-    const exprt &new_expr=cache_result.first->second;
-
-    if(new_expr.id().empty())
-      return true; // no change
-
-    expr=new_expr;
-    return false;
+    cache_key = &expr.read();
+    auto cache_it = cache.find(cache_key);
+    if(cache_it != cache.end())
+    {
+      ++cache_statistics.hits;
+      return cache_it->second.result;
+    }
+    ++cache_statistics.misses;
   }
-  #endif
+#endif
 
   // We work on a copy to prevent unnecessary destruction of sharing.
   auto simplify_node_preorder_result = simplify_node_preorder(expr);
@@ -3188,7 +3162,7 @@ simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
 
   if(!simplify_node_result.has_changed())
   {
-    return unchanged(expr);
+    simplify_node_result = unchanged(expr);
   }
   else
   {
@@ -3198,14 +3172,18 @@ simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
         as_const(simplify_node_result.expr).type() == expr.type(),
       simplify_node_result.expr.pretty(),
       expr.pretty());
+  }
 
-#ifdef USE_CACHE
-    // save in cache
-    cache_result.first->second = simplify_node_result.expr;
+#ifdef SHARING
+  if(cache_key != nullptr)
+  {
+    if(cache.size() >= max_cache_size)
+      cache.clear();
+    cache.emplace(cache_key, cache_entryt{expr, simplify_node_result});
+  }
 #endif
 
-    return simplify_node_result;
-  }
+  return simplify_node_result;
 }
 
 /// \return returns true if expression unchanged; returns false if changed
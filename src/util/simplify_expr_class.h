@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #endif
 
 #include <set>
+#include <unordered_map>
 
 #include "expr.h"
 #include "mp_arith.h"
@@ -275,8 +276,43 @@ class simplify_exprt
 
   virtual bool simplify(exprt &expr);
 
+  /// Hit and miss counts of the cache of simplification results
+  struct cache_statisticst
+  {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+  };
+
+  const cache_statisticst &get_cache_statistics() const
+  {
+    return cache_statistics;
+  }
+
+  /// Discard all cached simplification results, which is required when the
+  /// symbols in the namespace change. The statistics are kept.
+  void clear_cache()
+  {
+    cache.clear();
+  }
+
 protected:
   const namespacet &ns;
+
+  /// Results of \ref simplify_rec for expressions whose irep node is shared,
+  /// i.e., that may be encountered again while this instance is alive. The
+  /// cache is keyed on the address of the node; each entry holds a reference
+  /// to the node, so that the address cannot be reused for another node while
+  /// the entry exists. Once \ref max_cache_size entries have been stored, the
+  /// cache is cleared.
+  struct cache_entryt
+  {
+    exprt original;
+    resultt<> result;
+  };
+  std::unordered_map<const void *, cache_entryt> cache;
+  static constexpr std::size_t max_cache_size = 1 << 16;
+  cache_statisticst cache_statistics;
+
 #ifdef DEBUG_ON_DEMAND
   bool debug_on;
 #endif
@@ -0,0 +1,173 @@
+/*******************************************************************\
+
+Module: util
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+#ifndef CPROVER_UTIL_SORTED_VECTOR_AS_MAP_H
+#define CPROVER_UTIL_SORTED_VECTOR_AS_MAP_H
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "narrow.h"
+
+/// Implementation of map-like interface using a vector that is sorted by key.
+/// Lookups are binary searches over contiguous memory, and iterating over
+/// all elements in order (e.g., to merge two maps) does not chase pointers.
+/// Inserting or erasing an element in the middle is linear in the size of
+/// the map, so this is best suited to small maps, or to maps that are built
+/// in order of their keys, see \ref emplace_hint.
+template <typename keyt, typename mappedt>
+//  requires DefaultConstructible<mappedt>
+class sorted_vector_as_mapt : public std::vector<std::pair<keyt, mappedt>>
+{
+public:
+  using implementationt = typename std::vector<std::pair<keyt, mappedt>>;
+  using const_iterator = typename implementationt::const_iterator;
+  using iterator = typename implementationt::iterator;
+  using key_type = keyt;
+  using mapped_type = mappedt;
+  using value_type = std::pair<keyt, mappedt>;
+
+  sorted_vector_as_mapt() : implementationt()
+  {
+  }
+
+  sorted_vector_as_mapt(std::initializer_list<value_type> list)
+    : implementationt(std::move(list))
+  {
+    std::sort(this->begin(), this->end(), order_elements);
+  }
+
+  using implementationt::erase;
+
+  std::size_t erase(const keyt &key)
+  {
+    const iterator it = lower_bound(key);
+
+    if(it == this->end() || it->first != key)
+      return 0;
+
+    this->erase(it);
+    return 1;
+  }
+
+  const_iterator find(const keyt &key) const
+  {
+    const const_iterator it = lower_bound(key);
+
+    if(it == this->end() || it->first != key)
+      return this->end();
+
+    return it;
+  }
+
+  iterator find(const keyt &key)
+  {
+    const iterator it = lower_bound(key);
+
+    if(it == this->end() || it->first != key)
+      return this->end();
+
+    return it;
+  }
+
+  std::size_t count(const keyt &key) const
+  {
+    return find(key) == this->end() ? 0 : 1;
+  }
+
+  mappedt &operator[](const keyt &key)
+  {
+    return insert(value_type{key, mappedt()}).first->second;
+  }
+
+  /// Insert \p value unless an element with the same key exists
+  /// \return the element with the key of \p value, and whether it was
+  ///   inserted
+  std::pair<iterator, bool> insert(value_type value)
+  {
+    const iterator it = lower_bound(value.first);
+
+    if(it != this->end() && it->first == value.first)
+      return {it, false};
+
+    return {implementationt::insert(it, std::move(value)), true};
+  }
+
+  /// Insert the elements of the range from \p first to \p last, which must
+  /// be sorted by key, whose keys do not exist yet, in a single pass over the
+  /// range and the map
+  template <typename iteratort>
+  void insert(iteratort first, iteratort last)
+  {
+    implementationt result;
+    result.reserve(
+      this->size() + narrow<std::size_t>(std::distance(first, last)));
+
+    auto it = this->begin();
+    while(it != this->end() && first != last)
+    {
+      if(it->first < first->first)
+        result.push_back(std::move(*it++));
+      else if(first->first < it->first)
+        result.push_back(*first++);
+      else
+      {
+        result.push_back(std::move(*it++));
+        ++first;
+      }
+    }
+
+    std::move(it, this->end(), std::back_inserter(result));
+    std::copy(first, last, std::back_inserter(result));
+    this->swap(result);
+  }
+
+  /// Insert an element with key \p key unless one exists, which takes
+  /// constant amortized time when \p hint is the end of the map and \p key is
+  /// larger than all keys in the map
+  template <typename... argumentst>
+  iterator
+  emplace_hint(const_iterator hint, const keyt &key, argumentst &&...arguments)
+  {
+    if(
+      hint == this->end() && (this->empty() || this->back().first < key))
+    {
+      this->emplace_back(key, mappedt(std::forward<argumentst>(arguments)...));
+      return std::prev(this->end());
+    }
+
+    return insert(
+             value_type{key, mappedt(std::forward<argumentst>(arguments)...)})
+      .first;
+  }
+
+private:
+  static bool order(const value_type &a, const keyt &b)
+  {
+    return a.first < b;
+  }
+
+  static bool order_elements(const value_type &a, const value_type &b)
+  {
+    return a.first < b.first;
+  }
+
+  const_iterator lower_bound(const keyt &key) const
+  {
+    return std::lower_bound(this->begin(), this->end(), key, order);
+  }
+
+  iterator lower_bound(const keyt &key)
+  {
+    return std::lower_bound(this->begin(), this->end(), key, order);
+  }
+};
+
+#endif // CPROVER_UTIL_SORTED_VECTOR_AS_MAP_H
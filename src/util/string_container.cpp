@@ -11,11 +11,14 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "string_container.h"
 
+#include "invariant.h"
+
 #include <cstring>
 #include <iostream>
 #include <numeric>
 
-string_ptrt::string_ptrt(const char *_s):s(_s), len(strlen(_s))
+string_ptrt::string_ptrt(const char *_s)
+  : s(_s), len(strlen(_s)), hash(hash_string(_s))
 {
 }
 
@@ -31,50 +34,76 @@ string_containert::~string_containert()
 {
 }
 
-unsigned string_containert::get(const char *s)
+unsigned string_containert::get(const string_ptrt &string_ptr)
 {
-  string_ptrt string_ptr(s);
+  // mix in some higher bits, the low bits of hash_string are weak
+  shardt &shard =
+    shards[(string_ptr.hash ^ (string_ptr.hash >> 16)) % number_of_shards];
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  hash_tablet::iterator it = shard.hash_table.find(string_ptr);
 
-  if(it!=hash_table.end())
+  if(it!=shard.hash_table.end())
     return it->second;
 
-  size_t r=hash_table.size();
+  const unsigned r = next_no.fetch_add(1, std::memory_order_relaxed);
 
   // these are stable
-  string_list.push_back(std::string(s));
-  string_ptrt result(string_list.back());
+  shard.string_list.emplace_back(string_ptr.s, string_ptr.len);
+  string_ptrt result(shard.string_list.back());
 
-  hash_table[result]=r;
+  shard.hash_table.emplace(result, r);
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  // publish before r can become known to any other thread
+  string_vector.set(r, &shard.string_list.back());
 
   return r;
 }
 
-unsigned string_containert::get(const std::string &s)
+string_containert::string_vectort::~string_vectort()
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it=hash_table.find(string_ptr);
-
-  if(it!=hash_table.end())
-    return it->second;
-
-  size_t r=hash_table.size();
+  for(auto &segment : segments)
+    delete[] segment.load(std::memory_order_relaxed);
+}
 
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
+void string_containert::string_vectort::set(size_t no, const std::string *s)
+{
+  const std::size_t segment_nr = segment_of(no);
+  PRECONDITION(segment_nr < max_segments);
+
+  const std::string **segment =
+    segments[segment_nr].load(std::memory_order_acquire);
+
+  if(segment == nullptr)
+  {
+    const std::string **fresh =
+      new const std::string *[segment_size(segment_nr)]();
+
+    // another thread may have allocated this segment in the meantime
+    if(segments[segment_nr].compare_exchange_strong(
+         segment, fresh, std::memory_order_acq_rel))
+    {
+      segment = fresh;
+    }
+    else
+      delete[] fresh;
+  }
+
+  segment[no - segment_start(segment_nr)] = s;
+}
 
-  hash_table[result]=r;
+std::size_t string_containert::string_vectort::capacity() const
+{
+  std::size_t result = 0;
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  for(std::size_t segment_nr = 0; segment_nr < max_segments; ++segment_nr)
+  {
+    if(segments[segment_nr].load(std::memory_order_acquire) != nullptr)
+      result += segment_size(segment_nr);
+  }
 
-  return r;
+  return result;
 }
 
 void string_container_statisticst::dump_on_stream(std::ostream &out) const
@@ -92,20 +121,32 @@ void string_container_statisticst::dump_on_stream(std::ostream &out) const
 
 string_container_statisticst string_containert::compute_statistics() const
 {
+  std::size_t string_count = 0, strings_memory = 0, map_memory = 0,
+              list_memory = 0;
+
+  for(auto &shard : shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    string_count += shard.string_list.size();
+    strings_memory += std::accumulate(
+      begin(shard.string_list),
+      end(shard.string_list),
+      std::size_t(0),
+      [](std::size_t sz, const std::string &s) { return sz + s.capacity(); });
+    map_memory += sizeof(shard.hash_table) +
+                  shard.hash_table.size() * sizeof(hash_tablet::value_type);
+    list_memory += sizeof(shard.string_list) +
+                   2 * sizeof(void *) * shard.string_list.size();
+  }
+
   string_container_statisticst result;
-  result.string_count = string_vector.size();
+  result.string_count = string_count;
   result.vector_memory_usage = memory_sizet::from_bytes(
     sizeof(string_vector) +
-    sizeof(string_vectort::value_type) * string_vector.capacity());
-  result.strings_memory_usage = memory_sizet::from_bytes(std::accumulate(
-    begin(string_vector),
-    end(string_vector),
-    std::size_t(0),
-    [](std::size_t sz, const std::string *s) { return sz + s->capacity(); }));
-  result.map_memory_usage = memory_sizet::from_bytes(
-    sizeof(hash_table) + hash_table.size() * sizeof(hash_tablet::value_type));
-
-  result.list_memory_usage = memory_sizet::from_bytes(
-    sizeof(string_list) + 2 * sizeof(void *) * string_list.size());
+    sizeof(const std::string *) * string_vector.capacity());
+  result.strings_memory_usage = memory_sizet::from_bytes(strings_memory);
+  result.map_memory_usage = memory_sizet::from_bytes(map_memory);
+  result.list_memory_usage = memory_sizet::from_bytes(list_memory);
   return result;
 }
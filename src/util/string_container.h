@@ -12,9 +12,15 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_STRING_CONTAINER_H
 #define CPROVER_UTIL_STRING_CONTAINER_H
 
+#include <array>
+#include <atomic>
 #include <list>
+#include <mutex>
 #include <unordered_map>
-#include <vector>
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
 
 #include "memory_units.h"
 #include "string_hash.h"
@@ -23,6 +29,7 @@ struct string_ptrt
 {
   const char *s;
   size_t len;
+  size_t hash;
 
   const char *c_str() const
   {
@@ -31,7 +38,14 @@ struct string_ptrt
 
   explicit string_ptrt(const char *_s);
 
-  explicit string_ptrt(const std::string &_s):s(_s.c_str()), len(_s.size())
+  explicit string_ptrt(const std::string &_s)
+    : s(_s.c_str()), len(_s.size()), hash(hash_string(_s))
+  {
+  }
+
+  /// As \p _s need not be null-terminated, \ref c_str must not be used
+  explicit string_ptrt(std::string_view _s)
+    : s(_s.data()), len(_s.size()), hash(hash_string(_s))
   {
   }
 
@@ -42,7 +56,7 @@ struct string_ptrt
 class string_ptr_hash
 {
 public:
-  size_t operator()(const string_ptrt s) const { return hash_string(s.s); }
+  size_t operator()(const string_ptrt s) const { return s.hash; }
 };
 
 /// Has estimated statistics about string container
@@ -60,17 +74,30 @@ struct string_container_statisticst
   void dump_on_stream(std::ostream &out) const;
 };
 
+/// Interns strings, i.e., assigns a unique number to each distinct string.
+/// Inserting strings is thread-safe: the strings are distributed over
+/// shards by hash value, each of which is protected by its own mutex.
+/// Numbers are never reused and the strings are never moved, hence looking up
+/// the string for a number (\ref get_string, \ref c_str) does not take any
+/// lock and can run concurrently with insertions.
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
+  }
+
+  /// Number of the string \p s, which is only copied if there is no such
+  /// string in the container yet
+  unsigned operator[](std::string_view s)
+  {
+    return get(string_ptrt(s));
   }
 
   // constructor and destructor
@@ -95,15 +122,87 @@ class string_containert
   // the 'unsigned' ought to be size_t
   typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
     hash_tablet;
-  hash_tablet hash_table;
-
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
 
   typedef std::list<std::string> string_listt;
-  string_listt string_list;
 
-  typedef std::vector<std::string *> string_vectort;
+  struct shardt
+  {
+    std::mutex mutex;
+    hash_tablet hash_table;
+    // these are stable
+    string_listt string_list;
+  };
+
+  static constexpr std::size_t number_of_shards = 64;
+  mutable std::array<shardt, number_of_shards> shards;
+
+  /// The number given to the next string that is inserted
+  std::atomic<unsigned> next_no{0};
+
+  unsigned get(const string_ptrt &string_ptr);
+
+  /// Append-only map from numbers to strings. The storage is a sequence of
+  /// segments, where segment k holds `first_segment_size * 2^k` entries.
+  /// Segments are never moved or freed before destruction, which makes
+  /// lookups lock-free.
+  class string_vectort
+  {
+  public:
+    string_vectort() = default;
+    string_vectort(const string_vectort &) = delete;
+    string_vectort &operator=(const string_vectort &) = delete;
+    ~string_vectort();
+
+    const std::string *operator[](size_t no) const
+    {
+      const std::size_t segment_nr = segment_of(no);
+      return segments[segment_nr].load(std::memory_order_acquire)
+        [no - segment_start(segment_nr)];
+    }
+
+    /// Make entry \p no point to \p s. Must be called at most once per
+    /// number, and before the number is made known to other threads.
+    void set(size_t no, const std::string *s);
+
+    /// Number of allocated entries
+    std::size_t capacity() const;
+
+  protected:
+    static constexpr std::size_t first_segment_size = 1024;
+    // enough segments for all 'unsigned' string numbers
+    static constexpr std::size_t max_segments = 32;
+
+    std::array<std::atomic<const std::string **>, max_segments> segments{};
+
+    static std::size_t segment_start(std::size_t segment_nr)
+    {
+      return first_segment_size * ((std::size_t(1) << segment_nr) - 1);
+    }
+
+    static std::size_t segment_size(std::size_t segment_nr)
+    {
+      return first_segment_size << segment_nr;
+    }
+
+    static std::size_t segment_of(size_t no)
+    {
+      // the position of the most significant bit
+      const unsigned x = static_cast<unsigned>(no / first_segment_size + 1);
+#if defined(__GNUC__)
+      return sizeof(unsigned) * 8 - 1 - __builtin_clz(x);
+#elif defined(_MSC_VER)
+      unsigned long index;
+      _BitScanReverse(&index, x);
+      return index;
+#else
+      std::size_t index = 0;
+      for(unsigned y = x >> 1; y != 0; y >>= 1)
+        ++index;
+      return index;
+#endif
+    }
+  };
+
   string_vectort string_vector;
 };
 
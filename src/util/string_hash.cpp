@@ -12,6 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "string_hash.h"
 
 size_t hash_string(const std::string &s)
+{
+  return hash_string(std::string_view{s});
+}
+
+size_t hash_string(std::string_view s)
 {
   size_t h=0;
   size_t size=s.size();
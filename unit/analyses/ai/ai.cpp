@@ -12,14 +12,21 @@ Author: Diffblue Ltd.
 #include <util/arith_tools.h>
 #include <util/c_types.h>
 #include <util/config.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
 
 #include <analyses/ai.h>
+#include <analyses/variable-sensitivity/variable_sensitivity_domain.h>
+#include <analyses/variable-sensitivity/variable_sensitivity_object_factory.h>
 #include <ansi-c/ansi_c_language.h>
 #include <ansi-c/goto-conversion/goto_convert_functions.h>
 #include <langapi/mode.h>
 #include <testing-utils/message.h>
 #include <testing-utils/use_catch.h>
 
+#include <map>
+#include <sstream>
+
 /// A very simple analysis that counts executed instructions along a particular
 /// path, taking the max at merge points and saturating at 100 instructions.
 /// It should indicate that instructions not within a loop have a certain path
@@ -265,4 +272,182 @@ SCENARIO(
       REQUIRE(*example_analysis[h_instructions.begin()].path_length < 100);
     }
   }
+
+  WHEN("The functions of the target program are analysed on their own")
+  {
+    using history_factoryt =
+      ai_history_factory_default_constructort<ahistoricalt>;
+    using domain_factoryt =
+      ai_domain_factory_default_constructort<instruction_counter_domaint>;
+
+    auto analyse = [&goto_model](
+                     std::size_t number_of_threads,
+                     message_handlert &message_handler) {
+      auto analysis = std::make_unique<ai_function_localt>(
+        std::make_unique<history_factoryt>(),
+        std::make_unique<domain_factoryt>(),
+        std::make_unique<location_sensitive_storaget>(),
+        message_handler,
+        number_of_threads);
+      (*analysis)(goto_model);
+      return analysis;
+    };
+
+    auto path_length = [](const ai_baset &analysis, ai_baset::locationt l) {
+      return static_cast<const instruction_counter_domaint &>(
+               *analysis.abstract_state_before(l))
+        .path_length;
+    };
+
+    const auto sequential = analyse(1, null_message_handler);
+    std::ostringstream parallel_output;
+    stream_message_handlert parallel_message_handler{parallel_output};
+    const auto parallel = analyse(2, parallel_message_handler);
+
+    THEN("The functions are analysed in parallel if the build supports it")
+    {
+#if IREP_ATOMIC_REF_COUNT
+      REQUIRE(
+        parallel_output.str().find(" functions using 2 threads") !=
+        std::string::npos);
+#else
+      REQUIRE(
+        parallel_output.str().find("using a single thread") !=
+        std::string::npos);
+      WARN(
+        "analysing in parallel is not tested as this build lacks "
+        "IREP_ATOMIC_REF_COUNT");
+#endif
+    }
+
+    THEN("Each function is analysed from its entry")
+    {
+      const auto &g_instructions =
+        goto_model.goto_functions.function_map.at("g").body.instructions;
+      REQUIRE(g_instructions.begin()->is_assign());
+      REQUIRE(path_length(*sequential, g_instructions.begin()) == 0);
+    }
+
+    THEN("The results do not depend on the number of threads")
+    {
+      for(const auto &gf_entry : goto_model.goto_functions.function_map)
+      {
+        forall_goto_program_instructions(i_it, gf_entry.second.body)
+        {
+          REQUIRE(path_length(*sequential, i_it).has_value());
+          REQUIRE(
+            path_length(*sequential, i_it) == path_length(*parallel, i_it));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "Function-local analysis with the variable-sensitivity domain",
+  "[core][analyses][ai][variable-sensitivity]")
+{
+  // Make a program like:
+
+  // __CPROVER_start() { f(); g(); }
+  //
+  // f() { int *fp = malloc(4); int *fq = malloc(4); }
+  //
+  // g() { int *gp = malloc(4); }
+
+  register_language(new_ansi_c_language);
+  config.ansi_c.set_LP64();
+
+  goto_modelt goto_model;
+
+  const typet int_pointer = pointer_type(signed_int_type());
+
+  auto make_allocating_function = [&goto_model, &int_pointer](
+                                    const irep_idt &name,
+                                    const std::vector<irep_idt> &pointers) {
+    source_locationt source_location;
+    source_location.set_function(name);
+
+    code_blockt body;
+    for(const auto &pointer : pointers)
+    {
+      symbolt pointer_symbol{pointer, int_pointer, ID_C};
+      goto_model.symbol_table.add(pointer_symbol);
+
+      side_effect_exprt allocate{
+        ID_allocate,
+        {from_integer(4, size_type()), false_exprt{}},
+        int_pointer,
+        source_location};
+      body.add(code_assignt{pointer_symbol.symbol_expr(), allocate});
+    }
+
+    symbolt function{name, code_typet{{}, empty_typet{}}, ID_C};
+    function.value = body;
+    goto_model.symbol_table.add(function);
+    return function.symbol_expr();
+  };
+
+  const symbol_exprt f = make_allocating_function("f", {"fp", "fq"});
+  const symbol_exprt g = make_allocating_function("g", {"gp"});
+
+  symbolt start{
+    goto_functionst::entry_point(), code_typet{{}, empty_typet{}}, ID_C};
+  start.base_name = goto_functionst::entry_point();
+  start.value = code_blockt{{make_void_call(f), make_void_call(g)}};
+  goto_model.symbol_table.add(start);
+
+  goto_convert(goto_model, null_message_handler);
+
+  const namespacet ns{goto_model.symbol_table};
+
+  auto analyse = [&goto_model](std::size_t number_of_threads) {
+    const vsd_configt configuration = vsd_configt::constant_domain();
+    auto analysis = std::make_unique<ai_function_localt>(
+      std::make_unique<ai_history_factory_default_constructort<ahistoricalt>>(),
+      std::make_unique<variable_sensitivity_domain_factoryt>(
+        variable_sensitivity_object_factoryt::configured_with(configuration),
+        configuration),
+      std::make_unique<location_sensitive_storaget>(),
+      null_message_handler,
+      number_of_threads);
+    (*analysis)(goto_model);
+    return analysis;
+  };
+
+  // the state at the end of each function
+  auto final_states = [&goto_model, &ns](const ai_baset &analysis) {
+    std::map<irep_idt, std::string> result;
+    for(const auto &gf_entry : goto_model.goto_functions.function_map)
+    {
+      std::ostringstream out;
+      analysis
+        .abstract_state_before(
+          std::prev(gf_entry.second.body.instructions.end()))
+        ->output(out, analysis, ns);
+      result[gf_entry.first] = out.str();
+    }
+    return result;
+  };
+
+  WHEN("The functions are analysed on their own")
+  {
+    const auto sequential = final_states(*analyse(1));
+    const auto parallel = final_states(*analyse(2));
+
+    THEN("Heap allocations are named after the function and their order")
+    {
+      REQUIRE(
+        sequential.at("f").find("heap-allocation-f-0") != std::string::npos);
+      REQUIRE(
+        sequential.at("f").find("heap-allocation-f-1") != std::string::npos);
+      REQUIRE(
+        sequential.at("g").find("heap-allocation-g-0") != std::string::npos);
+    }
+
+    THEN("The results do not depend on the number of threads")
+    {
+      REQUIRE(sequential == parallel);
+    }
+  }
 }
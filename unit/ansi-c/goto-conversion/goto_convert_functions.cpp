@@ -0,0 +1,134 @@
+/*******************************************************************\
+
+Module: Unit tests for goto_convert_functionst
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <ansi-c/goto-conversion/goto_convert_functions.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <sstream>
+
+static symbolt make_function(const irep_idt &name, const codet &body)
+{
+  symbolt function{name, code_typet{{}, empty_typet{}}, ID_C};
+  function.base_name = name;
+  function.value = body;
+  return function;
+}
+
+/// Adds functions f0, f1, ... that each compute g() + g(), which requires
+/// temporaries, and jump into the scope of a declaration, which requires a
+/// flag named after the label. The flags of all functions clash.
+static void add_functions(symbol_tablet &symbol_table, std::size_t count)
+{
+  const typet int_type = signed_int_type();
+  const code_typet g_type{{}, int_type};
+
+  symbolt g{"g", g_type, ID_C};
+  g.base_name = "g";
+  g.value = code_blockt{{code_frontend_returnt{from_integer(1, int_type)}}};
+  symbol_table.add(g);
+
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    const std::string name = "f" + std::to_string(i);
+
+    symbolt x{name + "::x", int_type, ID_C};
+    x.base_name = "x";
+    x.is_lvalue = true;
+    x.is_file_local = true;
+    symbol_table.add(x);
+
+    const side_effect_expr_function_callt call{
+      g.symbol_expr(), {}, int_type, source_locationt{}};
+
+    code_blockt body;
+    body.add(code_gotot{"label"});
+    body.add(code_frontend_declt{x.symbol_expr()});
+    body.add(code_labelt{"label", code_skipt{}});
+    body.add(code_frontend_assignt{x.symbol_expr(), plus_exprt{call, call}});
+    symbol_table.add(make_function(name, body));
+  }
+}
+
+TEST_CASE(
+  "Parallel goto conversion matches sequential conversion",
+  "[core][ansi-c][goto_convert_functions]")
+{
+  const std::size_t count = 32;
+
+  symbol_tablet sequential_symbol_table;
+  add_functions(sequential_symbol_table, count);
+  goto_functionst sequential_functions;
+  goto_convert(
+    sequential_symbol_table, sequential_functions, null_message_handler);
+
+  symbol_tablet parallel_symbol_table;
+  add_functions(parallel_symbol_table, count);
+  goto_functionst parallel_functions;
+  std::ostringstream parallel_output;
+  stream_message_handlert parallel_message_handler{parallel_output};
+  goto_convert(
+    parallel_symbol_table, parallel_functions, parallel_message_handler, 4);
+
+#if IREP_ATOMIC_REF_COUNT
+  REQUIRE(
+    parallel_output.str().find(" functions in parallel") !=
+    std::string::npos);
+#else
+  REQUIRE(
+    parallel_output.str().find("converting sequentially") !=
+    std::string::npos);
+  WARN(
+    "converting in parallel is not tested as this build lacks "
+    "IREP_ATOMIC_REF_COUNT");
+#endif
+
+  REQUIRE(
+    parallel_symbol_table.symbols.size() ==
+    sequential_symbol_table.symbols.size());
+  for(const auto &symbol_pair : sequential_symbol_table.symbols)
+  {
+    const symbolt *symbol = parallel_symbol_table.lookup(symbol_pair.first);
+    REQUIRE(symbol != nullptr);
+    REQUIRE(*symbol == symbol_pair.second);
+  }
+
+  REQUIRE(
+    parallel_functions.function_map.size() ==
+    sequential_functions.function_map.size());
+  for(const auto &function_pair : sequential_functions.function_map)
+  {
+    const auto &parallel_function =
+      parallel_functions.function_map.at(function_pair.first);
+    REQUIRE(parallel_function.body.equals(function_pair.second.body));
+    REQUIRE(
+      parallel_function.parameter_identifiers ==
+      function_pair.second.parameter_identifiers);
+  }
+}
+
+TEST_CASE(
+  "Parallel goto conversion reports conversion errors",
+  "[core][ansi-c][goto_convert_functions]")
+{
+  symbol_tablet symbol_table;
+  add_functions(symbol_table, 8);
+  symbol_table.add(make_function("broken", code_gotot{"no_such_label"}));
+
+  goto_functionst functions;
+  REQUIRE_THROWS_AS(
+    goto_convert(symbol_table, functions, null_message_handler, 4),
+    incorrect_goto_program_exceptiont);
+}
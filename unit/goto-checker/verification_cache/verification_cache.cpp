@@ -0,0 +1,168 @@
+/*******************************************************************\
+
+Module: Unit tests for the verification cache
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/options.h>
+#include <util/std_code.h>
+#include <util/tempfile.h>
+
+#include <goto-checker/verification_cache.h>
+#include <goto-programs/goto_model.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+static void add_function(
+  goto_modelt &goto_model,
+  const irep_idt &name,
+  goto_programt body)
+{
+  symbolt symbol{name, code_typet{{}, empty_typet{}}, ID_C};
+  goto_model.symbol_table.add(symbol);
+
+  body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.function_map[name].body.swap(body);
+}
+
+/// A program whose entry point calls `f`, which assigns to and asserts on a
+/// global variable, and a function `g` that is not called
+static goto_modelt
+make_goto_model(const mp_integer &value_in_f, const mp_integer &value_in_g)
+{
+  goto_modelt goto_model;
+
+  const signedbv_typet int_type{32};
+  symbolt global{"x", int_type, ID_C};
+  global.is_static_lifetime = true;
+  goto_model.symbol_table.add(global);
+  const symbol_exprt x = global.symbol_expr();
+
+  goto_programt f;
+  f.add(goto_programt::make_assignment(x, from_integer(value_in_f, int_type)));
+  f.add(goto_programt::make_assertion(
+    equal_exprt{x, from_integer(value_in_f, int_type)}));
+  add_function(goto_model, "f", std::move(f));
+
+  goto_programt g;
+  g.add(goto_programt::make_assignment(x, from_integer(value_in_g, int_type)));
+  add_function(goto_model, "g", std::move(g));
+
+  goto_programt start;
+  start.add(goto_programt::make_function_call(
+    code_function_callt{symbol_exprt{"f", code_typet{{}, empty_typet{}}}}));
+  add_function(goto_model, goto_functionst::entry_point(), std::move(start));
+
+  return goto_model;
+}
+
+TEST_CASE(
+  "Program fingerprints cover what the entry point refers to",
+  "[core][goto-checker][verification_cache]")
+{
+  optionst options;
+  options.set_option("unwind", 1);
+  const std::string fingerprint =
+    program_fingerprint(make_goto_model(1, 2), options);
+
+  REQUIRE(!fingerprint.empty());
+  REQUIRE(program_fingerprint(make_goto_model(1, 2), options) == fingerprint);
+
+  SECTION("Changes to functions that are not called are ignored")
+  {
+    REQUIRE(program_fingerprint(make_goto_model(1, 3), options) == fingerprint);
+  }
+
+  SECTION("Changes to functions that are called are not ignored")
+  {
+    REQUIRE(program_fingerprint(make_goto_model(3, 2), options) != fingerprint);
+  }
+
+  SECTION("Changes to source locations are ignored")
+  {
+    goto_modelt goto_model = make_goto_model(1, 2);
+    source_locationt source_location;
+    source_location.set_line(42);
+    goto_model.goto_functions.function_map.at("f")
+      .body.instructions.front()
+      .source_location_nonconst() = source_location;
+    REQUIRE(program_fingerprint(goto_model, options) == fingerprint);
+  }
+
+  SECTION("Changes to global variables are not ignored")
+  {
+    goto_modelt goto_model = make_goto_model(1, 2);
+    goto_model.symbol_table.get_writeable_ref("x").type = signedbv_typet{64};
+    REQUIRE(program_fingerprint(goto_model, options) != fingerprint);
+  }
+
+  SECTION("Changes to options are not ignored")
+  {
+    options.set_option("unwind", 2);
+    REQUIRE(program_fingerprint(make_goto_model(1, 2), options) != fingerprint);
+  }
+
+  SECTION("The cache file is not part of the options")
+  {
+    options.set_option("verification-cache", "cache.txt");
+    REQUIRE(program_fingerprint(make_goto_model(1, 2), options) == fingerprint);
+  }
+}
+
+TEST_CASE(
+  "Properties that passed are taken from the verification cache",
+  "[core][goto-checker][verification_cache]")
+{
+  temporary_filet cache_file("cbmc_unit_verification_cache", ".txt");
+  optionst options;
+  const goto_modelt goto_model = make_goto_model(1, 2);
+  const auto assertion =
+    goto_model.goto_functions.function_map.at("f").body.instructions.begin();
+
+  const auto make_properties = [&assertion]() {
+    propertiest properties;
+    properties.emplace(
+      "f.assertion.1",
+      property_infot{assertion, "passes", property_statust::NOT_CHECKED});
+    properties.emplace(
+      "f.assertion.2",
+      property_infot{assertion, "fails", property_statust::NOT_CHECKED});
+    return properties;
+  };
+
+  {
+    verification_cachet cache{
+      cache_file(), options, goto_model, null_message_handler};
+    propertiest properties = make_properties();
+    REQUIRE(cache.apply(properties) == 0);
+
+    properties.at("f.assertion.1").status = property_statust::PASS;
+    properties.at("f.assertion.2").status = property_statust::FAIL;
+    cache.update(properties);
+  }
+
+  SECTION("The same program")
+  {
+    verification_cachet cache{
+      cache_file(), options, goto_model, null_message_handler};
+    propertiest properties = make_properties();
+    REQUIRE(cache.apply(properties) == 1);
+    REQUIRE(properties.at("f.assertion.1").status == property_statust::PASS);
+    REQUIRE(
+      properties.at("f.assertion.2").status == property_statust::NOT_CHECKED);
+  }
+
+  SECTION("A changed program")
+  {
+    verification_cachet cache{
+      cache_file(), options, make_goto_model(3, 2), null_message_handler};
+    propertiest properties = make_properties();
+    REQUIRE(cache.apply(properties) == 0);
+    REQUIRE(
+      properties.at("f.assertion.1").status == property_statust::NOT_CHECKED);
+  }
+}
@@ -0,0 +1,155 @@
+/*******************************************************************\
+
+Module: Unit tests for the full slicer
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_code.h>
+
+#include <goto-instrument/full_slicer.h>
+#include <goto-programs/goto_model.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+static void add_function(
+  goto_modelt &goto_model,
+  const irep_idt &name,
+  goto_programt body)
+{
+  symbolt symbol{name, code_typet{{}, empty_typet{}}, ID_C};
+  goto_model.symbol_table.add(symbol);
+
+  body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.function_map[name].body.swap(body);
+}
+
+static symbol_exprt
+add_global(goto_modelt &goto_model, const irep_idt &name, const typet &type)
+{
+  symbolt symbol{name, type, ID_C};
+  symbol.is_static_lifetime = true;
+  symbol.is_lvalue = true;
+  goto_model.symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+static bool has_instruction(
+  const goto_modelt &goto_model,
+  const irep_idt &function,
+  const std::function<bool(const goto_programt::instructiont &)> &predicate)
+{
+  const auto &instructions =
+    goto_model.goto_functions.function_map.at(function).body.instructions;
+  return std::any_of(instructions.begin(), instructions.end(), predicate);
+}
+
+static bool assigns(
+  const goto_modelt &goto_model,
+  const irep_idt &function,
+  const symbol_exprt &symbol)
+{
+  return has_instruction(
+    goto_model,
+    function,
+    [&symbol](const goto_programt::instructiont &instruction) {
+      return instruction.is_assign() && instruction.assign_lhs() == symbol;
+    });
+}
+
+TEST_CASE(
+  "The full slicer retains the dependencies of assertions",
+  "[core][goto-instrument][full_slicer]")
+{
+  // int x, y, z;
+  // void f() { __CPROVER_assume(y == 1); }
+  // void g() { z = 1; }
+  // void __CPROVER__start() {
+  //   x = 1; y = 1; z = 2;
+  //   if(y == 2) x = 2;
+  //   f(); g();
+  //   assert(x == 1);
+  // }
+  goto_modelt goto_model;
+  const signedbv_typet int_type{32};
+  const symbol_exprt x = add_global(goto_model, "x", int_type);
+  const symbol_exprt y = add_global(goto_model, "y", int_type);
+  const symbol_exprt z = add_global(goto_model, "z", int_type);
+  const code_typet void_function_type{{}, empty_typet{}};
+
+  goto_programt f;
+  f.add(goto_programt::make_assumption(
+    equal_exprt{y, from_integer(1, int_type)}));
+  add_function(goto_model, "f", std::move(f));
+
+  goto_programt g;
+  g.add(goto_programt::make_assignment(z, from_integer(1, int_type)));
+  add_function(goto_model, "g", std::move(g));
+
+  goto_programt start;
+  start.add(goto_programt::make_assignment(x, from_integer(1, int_type)));
+  start.add(goto_programt::make_assignment(y, from_integer(1, int_type)));
+  start.add(goto_programt::make_assignment(z, from_integer(2, int_type)));
+  goto_programt::targett branch = start.add(goto_programt::make_incomplete_goto(
+    not_exprt{equal_exprt{y, from_integer(2, int_type)}}));
+  start.add(goto_programt::make_assignment(x, from_integer(2, int_type)));
+  branch->complete_goto(start.add(goto_programt::make_skip()));
+  start.add(goto_programt::make_function_call(
+    code_function_callt{symbol_exprt{"f", void_function_type}}));
+  start.add(goto_programt::make_function_call(
+    code_function_callt{symbol_exprt{"g", void_function_type}}));
+  start.add(
+    goto_programt::make_assertion(equal_exprt{x, from_integer(1, int_type)}));
+  add_function(goto_model, goto_functionst::entry_point(), std::move(start));
+
+  goto_model.goto_functions.update();
+  // the control dependencies of f, g and __CPROVER__start can be computed
+  // sequentially or in parallel, with the same result
+  const std::size_t number_of_threads = GENERATE(1, 3);
+  full_slicer(goto_model, null_message_handler, number_of_threads);
+
+  const irep_idt entry_point = goto_functionst::entry_point();
+
+  SECTION("Data dependencies are retained")
+  {
+    REQUIRE(assigns(goto_model, entry_point, x));
+  }
+
+  SECTION("Control dependencies are retained")
+  {
+    REQUIRE(
+      has_instruction(goto_model, entry_point, [](const auto &instruction) {
+        return instruction.is_goto() && !instruction.condition().is_true();
+      }));
+    // the condition reads y
+    REQUIRE(assigns(goto_model, entry_point, y));
+  }
+
+  SECTION("Assumptions in called functions are retained")
+  {
+    REQUIRE(has_instruction(goto_model, "f", [](const auto &instruction) {
+      return instruction.is_assume();
+    }));
+    REQUIRE(
+      has_instruction(goto_model, entry_point, [](const auto &instruction) {
+        return instruction.is_function_call() &&
+               to_symbol_expr(instruction.call_function()).get_identifier() ==
+                 "f";
+      }));
+  }
+
+  SECTION("Unrelated instructions are removed")
+  {
+    REQUIRE(!assigns(goto_model, entry_point, z));
+    REQUIRE(!assigns(goto_model, "g", z));
+    REQUIRE(
+      !has_instruction(goto_model, entry_point, [](const auto &instruction) {
+        return instruction.is_function_call() &&
+               to_symbol_expr(instruction.call_function()).get_identifier() ==
+                 "g";
+      }));
+  }
+}
@@ -0,0 +1,167 @@
+/*******************************************************************\
+
+Module: Unit tests for reading goto binaries on demand
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+#include <util/tempfile.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/lazy_goto_binary.h>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <fstream>
+
+static const code_typet void_function_type{{}, empty_typet{}};
+
+static void add_function(
+  goto_modelt &goto_model,
+  const irep_idt &name,
+  goto_programt body)
+{
+  symbolt symbol{name, void_function_type, ID_C};
+  symbol.set_compiled();
+  goto_model.symbol_table.add(symbol);
+
+  body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.function_map[name].body.swap(body);
+}
+
+/// The entry point calls `f`, which loops and takes the address of `h`, and
+/// `g` is not referred to at all
+static goto_modelt make_goto_model()
+{
+  goto_modelt goto_model;
+
+  const signedbv_typet int_type{32};
+  symbolt global{"x", int_type, ID_C};
+  global.is_static_lifetime = true;
+  goto_model.symbol_table.add(global);
+  const symbol_exprt x = global.symbol_expr();
+
+  const pointer_typet function_pointer_type{void_function_type, 64};
+  symbolt function_pointer{"p", function_pointer_type, ID_C};
+  function_pointer.is_static_lifetime = true;
+  goto_model.symbol_table.add(function_pointer);
+
+  goto_programt f;
+  const auto loop_head =
+    f.add(goto_programt::make_assignment(x, from_integer(1, int_type)));
+  f.add(goto_programt::make_assignment(
+    function_pointer.symbol_expr(),
+    address_of_exprt{symbol_exprt{"h", void_function_type}}));
+  f.add(goto_programt::make_goto(loop_head, true_exprt{}));
+  add_function(goto_model, "f", std::move(f));
+
+  goto_programt g;
+  g.add(goto_programt::make_assignment(x, from_integer(2, int_type)));
+  add_function(goto_model, "g", std::move(g));
+
+  goto_programt h;
+  h.add(goto_programt::make_assignment(x, from_integer(3, int_type)));
+  add_function(goto_model, "h", std::move(h));
+
+  goto_programt start;
+  start.add(goto_programt::make_function_call(
+    code_function_callt{symbol_exprt{"f", void_function_type}}));
+  add_function(goto_model, goto_functionst::entry_point(), std::move(start));
+
+  goto_model.goto_functions.update();
+
+  return goto_model;
+}
+
+static void require_loop_in_f(const goto_functionst &goto_functions)
+{
+  const goto_programt &f = goto_functions.function_map.at("f").body;
+  REQUIRE(f.instructions.size() == 4);
+  const auto backwards_goto = std::next(f.instructions.begin(), 2);
+  REQUIRE(backwards_goto->is_goto());
+  REQUIRE(backwards_goto->get_target() == f.instructions.begin());
+}
+
+TEST_CASE(
+  "Goto binaries are read back as they were written",
+  "[core][goto-programs][lazy_goto_binary]")
+{
+  const goto_modelt goto_model = make_goto_model();
+  temporary_filet file("cbmc_unit_lazy_goto_binary", ".gb");
+
+  const int version =
+    GENERATE(GOTO_BINARY_VERSION, GOTO_BINARY_VERSION_WITHOUT_INDEX);
+  {
+    std::ofstream out(file(), std::ios::binary);
+    REQUIRE(!write_goto_binary(out, goto_model, version));
+  }
+
+  const auto result = read_goto_binary(file(), null_message_handler);
+  REQUIRE(result.has_value());
+  REQUIRE(
+    result->symbol_table.symbols.size() ==
+    goto_model.symbol_table.symbols.size());
+  REQUIRE(result->symbol_table.lookup_ref("x").is_static_lifetime);
+  for(const auto &function : goto_model.goto_functions.function_map)
+  {
+    REQUIRE(
+      result->goto_functions.function_map.at(function.first)
+        .body.instructions.size() == function.second.body.instructions.size());
+  }
+  require_loop_in_f(result->goto_functions);
+}
+
+TEST_CASE(
+  "Only reachable functions are read from indexed goto binaries",
+  "[core][goto-programs][lazy_goto_binary]")
+{
+  const goto_modelt goto_model = make_goto_model();
+  temporary_filet file("cbmc_unit_lazy_goto_binary", ".gb");
+
+  SECTION("Goto binaries with an index")
+  {
+    {
+      std::ofstream out(file(), std::ios::binary);
+      REQUIRE(!write_goto_binary(out, goto_model));
+    }
+
+    const auto goto_binary = lazy_goto_binaryt::open(file());
+    REQUIRE(goto_binary != nullptr);
+    REQUIRE(goto_binary->number_of_functions() == 4);
+
+    symbol_tablet symbol_table;
+    goto_functionst goto_functions;
+    goto_binary->read_symbol_table(symbol_table, goto_functions);
+    REQUIRE(symbol_table.has_symbol("g"));
+    REQUIRE(goto_functions.function_map.count("g") == 1);
+    REQUIRE(!goto_functions.function_map.at("g").body_available());
+
+    // the entry point, `f` and `h`, whose address is taken by `f`
+    REQUIRE(goto_binary->read_reachable_functions(goto_functions) == 3);
+    REQUIRE(goto_functions.function_map.at("h").body_available());
+    REQUIRE(!goto_functions.function_map.at("g").body_available());
+    require_loop_in_f(goto_functions);
+
+    // functions are only read once
+    REQUIRE(goto_binary->read_reachable_functions(goto_functions) == 0);
+  }
+
+  SECTION("Goto binaries without an index")
+  {
+    {
+      std::ofstream out(file(), std::ios::binary);
+      REQUIRE(
+        !write_goto_binary(out, goto_model, GOTO_BINARY_VERSION_WITHOUT_INDEX));
+    }
+
+    REQUIRE(lazy_goto_binaryt::open(file()) == nullptr);
+  }
+}
@@ -0,0 +1,109 @@
+/*******************************************************************\
+
+Module: Unit tests for read_objects_and_link
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_code.h>
+#include <util/tempfile.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+/// A goto model with a function `f<index>` that assigns to a file-local
+/// variable `local`, which all of the goto models have
+static goto_modelt make_goto_model(std::size_t index)
+{
+  goto_modelt goto_model;
+
+  const signedbv_typet int_type{32};
+  symbolt local{"local", int_type, ID_C};
+  local.is_static_lifetime = true;
+  local.is_file_local = true;
+  goto_model.symbol_table.add(local);
+
+  const irep_idt name = "f" + std::to_string(index);
+  symbolt function{name, code_typet{{}, empty_typet{}}, ID_C};
+  function.set_compiled();
+  goto_model.symbol_table.add(function);
+
+  goto_programt body;
+  body.add(goto_programt::make_assignment(
+    local.symbol_expr(), from_integer(index, int_type)));
+  body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.function_map[name].body.swap(body);
+
+  return goto_model;
+}
+
+/// The variable that the function \p name assigns to
+static irep_idt assigned_variable(const goto_modelt &goto_model, irep_idt name)
+{
+  const auto &instruction =
+    goto_model.goto_functions.function_map.at(name).body.instructions.front();
+  return to_symbol_expr(instruction.assign_lhs()).get_identifier();
+}
+
+TEST_CASE(
+  "Goto binaries are linked in order independently of the number of threads",
+  "[core][goto-programs][read_objects_and_link]")
+{
+  const std::size_t number_of_files = 5;
+  std::vector<std::unique_ptr<temporary_filet>> files;
+  std::list<std::string> file_names;
+  for(std::size_t index = 0; index < number_of_files; ++index)
+  {
+    files.push_back(std::make_unique<temporary_filet>(
+      "cbmc_unit_read_objects_and_link", ".gb"));
+    std::ofstream out((*files.back())(), std::ios::binary);
+    REQUIRE(!write_goto_binary(out, make_goto_model(index)));
+    file_names.push_back((*files.back())());
+  }
+
+  const std::size_t number_of_threads = GENERATE(1, 2, 3);
+  goto_modelt goto_model;
+  std::ostringstream output;
+  stream_message_handlert message_handler{output};
+  REQUIRE(!read_objects_and_link(
+    file_names, goto_model, message_handler, number_of_threads));
+
+#if IREP_ATOMIC_REF_COUNT
+  REQUIRE(
+    output.str().find(
+      " goto binaries using " + std::to_string(number_of_threads) +
+      " threads") != std::string::npos);
+#else
+  if(number_of_threads > 1)
+  {
+    REQUIRE(output.str().find("reading sequentially") != std::string::npos);
+    WARN(
+      "reading in parallel is not tested as this build lacks "
+      "IREP_ATOMIC_REF_COUNT");
+  }
+#endif
+
+  REQUIRE(goto_model.goto_functions.function_map.size() == number_of_files);
+
+  // the file-local variable of the first file keeps its name, the others are
+  // renamed in the order of the files
+  REQUIRE(assigned_variable(goto_model, "f0") == "local");
+  for(std::size_t index = 1; index < number_of_files; ++index)
+  {
+    const irep_idt renamed = "local$link" + std::to_string(index);
+    REQUIRE(goto_model.symbol_table.has_symbol(renamed));
+    REQUIRE(
+      assigned_variable(goto_model, "f" + std::to_string(index)) == renamed);
+  }
+}
@@ -0,0 +1,142 @@
+/*******************************************************************\
+
+Module: Unit tests for path_priority_queuet
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <util/magic.h>
+
+#include <goto-symex/path_storage.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+SCENARIO(
+  "Paths are resumed in the order of their scores",
+  "[core][goto-symex][path_storage][path_priority_queue]")
+{
+  goto_programt program;
+  const auto first = program.add(goto_programt::make_skip());
+  const auto second = program.add(goto_programt::make_skip());
+  const auto third = program.add(goto_programt::make_skip());
+
+  symex_targett::sourcet source{"fun", first};
+  guard_managert manager;
+  std::size_t fresh_name_count = 1;
+  auto fresh_name = [&fresh_name_count](const irep_idt &) {
+    return fresh_name_count++;
+  };
+  goto_symex_statet state{
+    source,
+    DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE,
+    true,
+    manager,
+    fresh_name};
+  symex_target_equationt equation{null_message_handler};
+
+  // Pushes a copy of `state` resuming at `location` after `branches`
+  auto push = [&](
+                path_storaget &storage,
+                goto_programt::const_targett location,
+                std::vector<bool> branches) {
+    state.saved_target = location;
+    state.saved_branches = std::move(branches);
+    storage.push(path_storaget::patht{equation, state});
+  };
+
+  GIVEN("A queue that only takes coverage and loop unwindings into account")
+  {
+    path_priority_queuet queue{{1.0, 1.0, 0.0, 0.0}, 0};
+
+    WHEN("Two paths with equal scores are pushed")
+    {
+      push(queue, first, {false});
+      push(queue, second, {true});
+
+      THEN("The path pushed last is resumed first")
+      {
+        REQUIRE(queue.size() == 2);
+        REQUIRE(queue.peek().state.saved_branches == std::vector<bool>{true});
+        queue.pop();
+        REQUIRE(queue.peek().state.saved_branches == std::vector<bool>{false});
+        queue.pop();
+        REQUIRE(queue.empty());
+      }
+
+      THEN("Paths resuming at locations already resumed at come last")
+      {
+        queue.peek();
+        queue.pop();
+        push(queue, second, {true, false});
+
+        REQUIRE(queue.peek().state.saved_branches == std::vector<bool>{false});
+        queue.pop();
+        REQUIRE(
+          queue.peek().state.saved_branches == std::vector<bool>{true, false});
+        queue.pop();
+        REQUIRE(queue.empty());
+      }
+    }
+
+    WHEN("A path deep in a loop is pushed after another path")
+    {
+      push(queue, first, {false});
+      state.call_stack().top().loop_iterations["loop"].count = 2;
+      push(queue, second, {true});
+
+      THEN("The other path is resumed first")
+      {
+        REQUIRE(queue.peek().state.saved_branches == std::vector<bool>{false});
+        queue.pop();
+        REQUIRE(queue.peek().state.saved_branches == std::vector<bool>{true});
+        queue.pop();
+        REQUIRE(queue.empty());
+      }
+    }
+  }
+
+  GIVEN("A queue that keeps at most one path in memory")
+  {
+    path_priority_queuet queue{{1.0, 1.0, 0.0, 0.0}, 1};
+
+    std::vector<std::vector<bool>> recreated;
+    queue.recreate_path = [&](const std::vector<bool> &branches) {
+      recreated.push_back(branches);
+      state.saved_branches = branches;
+      return std::make_unique<path_storaget::patht>(equation, state);
+    };
+
+    push(queue, first, {false});
+    push(queue, second, {true});
+    push(queue, third, {true, true});
+
+    THEN("The other paths are reduced to their branches")
+    {
+      REQUIRE(queue.size() == 3);
+      REQUIRE(queue.number_of_spilled_paths() == 2);
+    }
+
+    THEN("Paths are re-created when they are resumed, in the same order")
+    {
+      REQUIRE(
+        queue.peek().state.saved_branches == std::vector<bool>{true, true});
+      queue.pop();
+      REQUIRE(recreated.empty());
+
+      REQUIRE(queue.peek().state.saved_branches == std::vector<bool>{true});
+      queue.pop();
+      REQUIRE(queue.peek().state.saved_branches == std::vector<bool>{false});
+      queue.pop();
+      REQUIRE(queue.empty());
+
+      REQUIRE(recreated == std::vector<std::vector<bool>>{{true}, {false}});
+    }
+
+    THEN("Clearing the queue also drops the paths that are not in memory")
+    {
+      queue.clear();
+      REQUIRE(queue.empty());
+    }
+  }
+}
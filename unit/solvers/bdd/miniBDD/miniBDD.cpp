@@ -327,6 +327,43 @@ SCENARIO("miniBDD", "[core][solver][miniBDD]")
     REQUIRE(oss.str() == dot_string);
   }
 
+  GIVEN("A bdd for x&y that is no longer referenced")
+  {
+    mini_bdd_mgrt mgr;
+
+    mini_bddt x_bdd = mgr.Var("x");
+    mini_bddt y_bdd = mgr.Var("y");
+    const std::size_t number_of_nodes = mgr.number_of_nodes();
+
+    unsigned node_number;
+    {
+      mini_bddt and_bdd = x_bdd & y_bdd;
+      node_number = and_bdd.node_number();
+      REQUIRE(mgr.number_of_nodes() == number_of_nodes + 1);
+    }
+    REQUIRE(mgr.number_of_nodes() == number_of_nodes);
+
+    THEN("Its node is re-used when the bdd is built again")
+    {
+      mini_bddt and_bdd = y_bdd & x_bdd;
+      REQUIRE(and_bdd.node_number() == node_number);
+      REQUIRE(mgr.number_of_nodes() == number_of_nodes + 1);
+      REQUIRE(mgr.collect_garbage() == 0);
+    }
+
+    THEN("Its node is freed when collecting garbage")
+    {
+      REQUIRE(mgr.collect_garbage() == 1);
+      REQUIRE(mgr.number_of_nodes() == number_of_nodes);
+
+      mini_bddt and_bdd = x_bdd & y_bdd;
+      REQUIRE(and_bdd.var() == x_bdd.var());
+      REQUIRE(and_bdd.low().is_false());
+      REQUIRE(and_bdd.high().node_number() == y_bdd.node_number());
+      REQUIRE(mgr.number_of_nodes() == number_of_nodes + 1);
+    }
+  }
+
   GIVEN("A bdd for (a&b)|!a")
   {
     symbol_exprt a("a", bool_typet());
@@ -48,3 +48,97 @@ SCENARIO("boolbvt", "[core][solvers][flattening][boolbvt]")
     }
   }
 }
+
+SCENARIO(
+  "boolbvt with word-level preprocessing",
+  "[core][solvers][flattening][boolbvt][word_level_preprocessor]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  GIVEN("Definitions of symbols, only some of which are used")
+  {
+    satcheckt satcheck(message_handler);
+    symbol_tablet symbol_table;
+    namespacet ns(symbol_table);
+    boolbvt boolbv(ns, satcheck, message_handler);
+    boolbv.word_level_preprocessing = true;
+
+    unsignedbv_typet u32(32);
+    symbol_exprt x("x", u32), y("y", u32), z("z", u32), unused("unused", u32);
+    boolbv << equal_exprt(x, from_integer(10, u32));
+    boolbv << equal_exprt(y, plus_exprt(x, z));
+    boolbv << equal_exprt(unused, mult_exprt(y, y));
+    boolbv << binary_relation_exprt(y, ID_gt, from_integer(20, u32));
+
+    THEN("the values of all symbols satisfy the definitions")
+    {
+      REQUIRE(boolbv() == decision_proceduret::resultt::D_SATISFIABLE);
+
+      const auto x_value = numeric_cast<mp_integer>(boolbv.get(x));
+      const auto y_value = numeric_cast<mp_integer>(boolbv.get(y));
+      const auto z_value = numeric_cast<mp_integer>(boolbv.get(z));
+      const auto unused_value = numeric_cast<mp_integer>(boolbv.get(unused));
+      REQUIRE(x_value == 10);
+      REQUIRE(y_value.has_value());
+      REQUIRE(z_value.has_value());
+      REQUIRE(*y_value == (*x_value + *z_value) % power(2, 32));
+      REQUIRE(*y_value > 20);
+      REQUIRE(unused_value == (*y_value * *y_value) % power(2, 32));
+    }
+    THEN("is unsatisfiable under an inconsistent assumption")
+    {
+      auto assumption = equal_exprt(y, from_integer(20, u32));
+      REQUIRE(
+        boolbv(assumption) == decision_proceduret::resultt::D_UNSATISFIABLE);
+    }
+  }
+}
+
+SCENARIO(
+  "boolbvt with lazy arithmetic",
+  "[core][solvers][flattening][boolbvt][lazy_arithmetic]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  satcheckt satcheck(message_handler);
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  boolbvt boolbv(ns, satcheck, message_handler);
+  boolbv.lazy_arithmetic = true;
+
+  signedbv_typet s8(8);
+  symbol_exprt x("x", s8), y("y", s8);
+
+  GIVEN("A formula that requires the semantics of multiplication")
+  {
+    boolbv << equal_exprt(mult_exprt(x, y), from_integer(35, s8));
+    boolbv << binary_relation_exprt(x, ID_gt, from_integer(1, s8));
+    boolbv << binary_relation_exprt(y, ID_gt, x);
+
+    THEN("the satisfying assignment respects the semantics")
+    {
+      REQUIRE(boolbv() == decision_proceduret::resultt::D_SATISFIABLE);
+      const auto x_value = numeric_cast<mp_integer>(boolbv.get(x));
+      const auto y_value = numeric_cast<mp_integer>(boolbv.get(y));
+      REQUIRE(x_value.has_value());
+      REQUIRE(y_value.has_value());
+      REQUIRE(*x_value > 1);
+      REQUIRE(*y_value > *x_value);
+      REQUIRE((*x_value * *y_value) % 256 == 35);
+    }
+  }
+
+  GIVEN("Properties of division that only hold for the full circuit")
+  {
+    boolbv << binary_relation_exprt(y, ID_gt, from_integer(0, s8));
+    boolbv << notequal_exprt(
+      plus_exprt(mult_exprt(div_exprt(x, y), y), mod_exprt(x, y)), x);
+
+    THEN("the formula is unsatisfiable")
+    {
+      REQUIRE(boolbv() == decision_proceduret::resultt::D_UNSATISFIABLE);
+    }
+  }
+}
@@ -0,0 +1,120 @@
+/*******************************************************************\
+
+Module: Unit tests for word_level_preprocessort
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for word_level_preprocessort
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/mathematical_expr.h>
+#include <util/namespace.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <solvers/flattening/word_level_preprocessor.h>
+#include <testing-utils/use_catch.h>
+
+TEST_CASE(
+  "Word-level preprocessing propagates equalities",
+  "[core][solvers][flattening][word_level_preprocessor]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns{symbol_table};
+  word_level_preprocessort preprocessor{ns};
+
+  const unsignedbv_typet u32{32};
+  const symbol_exprt x{"x", u32};
+  const symbol_exprt y{"y", u32};
+  const symbol_exprt z{"z", u32};
+
+  REQUIRE(preprocessor.add_equality(x, from_integer(10, u32)));
+  REQUIRE(preprocessor.add_equality(y, z));
+  REQUIRE_FALSE(preprocessor.add_equality(z, plus_exprt{x, y}));
+  REQUIRE_FALSE(preprocessor.add_equality(x, from_integer(11, u32)));
+
+  REQUIRE(preprocessor.has_substitution("x"));
+  REQUIRE_FALSE(preprocessor.has_substitution("z"));
+
+  SECTION("Symbols are replaced by constants and other symbols")
+  {
+    REQUIRE(
+      preprocessor(plus_exprt{x, y}) == plus_exprt{from_integer(10, u32), z});
+    REQUIRE(preprocessor(equal_exprt{x, from_integer(10, u32)}).is_true());
+    REQUIRE(preprocessor.get_statistics().constants == 2);
+    REQUIRE(preprocessor.get_statistics().equalities == 1);
+  }
+
+  SECTION("Bound symbols are not replaced")
+  {
+    const forall_exprt forall{x, equal_exprt{x, y}};
+    REQUIRE(preprocessor(forall) == forall);
+  }
+
+  SECTION("Chains of equalities are followed")
+  {
+    const symbol_exprt w{"w", u32};
+    REQUIRE(preprocessor.add_equality(z, w));
+    REQUIRE(preprocessor(y) == w);
+  }
+}
+
+TEST_CASE(
+  "Word-level preprocessing reduces widths",
+  "[core][solvers][flattening][word_level_preprocessor]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns{symbol_table};
+  word_level_preprocessort preprocessor{ns};
+
+  const unsignedbv_typet u8{8};
+  const unsignedbv_typet u32{32};
+  const signedbv_typet s8{8};
+  const signedbv_typet s32{32};
+  const symbol_exprt a{"a", u8};
+  const symbol_exprt b{"b", u8};
+  const symbol_exprt c{"c", s8};
+
+  SECTION("Truncated arithmetic is done at the narrower width")
+  {
+    const typecast_exprt truncated{
+      mult_exprt{typecast_exprt{a, u32}, typecast_exprt{b, u32}}, u8};
+    REQUIRE(preprocessor(truncated) == mult_exprt{a, b});
+    REQUIRE(preprocessor.get_statistics().width_reductions == 3);
+  }
+
+  SECTION("Comparisons of extended operands are done at the narrower width")
+  {
+    REQUIRE(
+      preprocessor(binary_relation_exprt{
+        typecast_exprt{a, u32}, ID_lt, typecast_exprt{b, u32}}) ==
+      simplify_expr(binary_relation_exprt{a, ID_lt, b}, ns));
+    REQUIRE(
+      preprocessor(equal_exprt{typecast_exprt{c, s32}, from_integer(-3, s32)}) ==
+      equal_exprt{c, from_integer(-3, s8)});
+  }
+
+  SECTION("Comparisons that depend on the extension are kept")
+  {
+    // sign extension does not preserve unsigned order
+    const binary_relation_exprt signed_operands{
+      typecast_exprt{c, u32}, ID_lt, typecast_exprt{c, u32}};
+    REQUIRE(preprocessor(signed_operands) == signed_operands);
+
+    // the constant does not fit into the narrower type
+    const equal_exprt out_of_range{
+      typecast_exprt{a, u32}, from_integer(256, u32)};
+    REQUIRE(preprocessor(out_of_range) == out_of_range);
+
+    // operands of different types
+    const binary_relation_exprt mixed{
+      typecast_exprt{a, s32}, ID_le, typecast_exprt{c, s32}};
+    REQUIRE(preprocessor(mixed) == mixed);
+    REQUIRE(preprocessor.get_statistics().width_reductions == 0);
+  }
+}
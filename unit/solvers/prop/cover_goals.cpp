@@ -0,0 +1,102 @@
+/*******************************************************************\
+
+Module: Unit tests for cover_goalst and prop_minimizet
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for cover_goalst and prop_minimizet
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/namespace.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <solvers/flattening/boolbv.h>
+#include <solvers/prop/cover_goals.h>
+#include <solvers/prop/literal_expr.h>
+#include <solvers/prop/prop_minimize.h>
+#include <solvers/sat/satcheck.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+SCENARIO(
+  "Covering goals leaves the decision procedure reusable",
+  "[core][solvers][prop][cover_goals]")
+{
+  satcheckt satcheck{null_message_handler};
+  symbol_tablet symbol_table;
+  namespacet ns{symbol_table};
+  boolbvt boolbv{ns, satcheck, null_message_handler};
+
+  const unsignedbv_typet u8{8};
+  const symbol_exprt x{"x", u8};
+  boolbv.set_to_true(binary_relation_exprt{x, ID_lt, from_integer(3, u8)});
+
+  GIVEN("Goals of which some can be covered")
+  {
+    cover_goalst cover_goals{boolbv};
+    for(int i = 1; i <= 3; ++i)
+      cover_goals.add(equal_exprt{x, from_integer(i, u8)});
+
+    THEN("the coverable goals are covered")
+    {
+      REQUIRE(
+        cover_goals(null_message_handler) ==
+        decision_proceduret::resultt::D_UNSATISFIABLE);
+      REQUIRE(cover_goals.number_covered() == 2);
+      REQUIRE(cover_goals.iterations() == 3);
+      REQUIRE(
+        cover_goals.goals.back().status ==
+        cover_goalst::goalt::statust::UNKNOWN);
+
+      // the goals have only been assumed
+      REQUIRE(
+        boolbv(equal_exprt{x, from_integer(0, u8)}) ==
+        decision_proceduret::resultt::D_SATISFIABLE);
+    }
+  }
+}
+
+SCENARIO(
+  "Minimization only constrains the current context",
+  "[core][solvers][prop][prop_minimize]")
+{
+  satcheckt satcheck{null_message_handler};
+  symbol_tablet symbol_table;
+  namespacet ns{symbol_table};
+  boolbvt boolbv{ns, satcheck, null_message_handler};
+
+  const unsignedbv_typet u8{8};
+  const symbol_exprt x{"x", u8};
+  boolbv.set_to_true(binary_relation_exprt{x, ID_ge, from_integer(5, u8)});
+
+  GIVEN("The bits of a bit-vector as objectives")
+  {
+    const bvt &bv = boolbv.convert_bv(x);
+    REQUIRE(boolbv() == decision_proceduret::resultt::D_SATISFIABLE);
+
+    boolbv.push();
+    prop_minimizet prop_minimize{boolbv, null_message_handler};
+    for(std::size_t i = 0; i < bv.size(); ++i)
+      prop_minimize.objective(bv[i], 1 << i);
+    prop_minimize();
+
+    THEN("the value is minimal")
+    {
+      REQUIRE(boolbv.get(x) == from_integer(5, u8));
+    }
+
+    boolbv.pop();
+
+    THEN("other values are possible after popping the context")
+    {
+      REQUIRE(
+        boolbv(equal_exprt{x, from_integer(200, u8)}) ==
+        decision_proceduret::resultt::D_SATISFIABLE);
+    }
+  }
+}
@@ -0,0 +1,224 @@
+/*******************************************************************\
+
+Module: Unit tests for satcheck_portfoliot
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for satcheck_portfoliot
+
+#ifdef HAVE_MINISAT2
+
+#  include <util/cout_message.h>
+#  include <util/threeval.h>
+
+#  include <solvers/prop/literal.h>
+#  include <solvers/sat/satcheck_minisat2.h>
+#  include <solvers/sat/satcheck_portfolio.h>
+#  include <testing-utils/use_catch.h>
+
+#  include <atomic>
+#  include <chrono>
+#  include <thread>
+
+/// A solver that never answers, but waits until it is interrupted
+class waiting_solvert : public cnf_solvert
+{
+public:
+  explicit waiting_solvert(message_handlert &message_handler)
+    : cnf_solvert(message_handler), interrupted(false)
+  {
+  }
+
+  std::string solver_text() const override
+  {
+    return "waiting solver";
+  }
+
+  void lcnf(const bvt &) override
+  {
+    ++clause_counter;
+  }
+
+  tvt l_get(literalt) const override
+  {
+    return tvt::unknown();
+  }
+
+  void set_assignment(literalt, bool) override
+  {
+  }
+
+  bool is_in_conflict(literalt) const override
+  {
+    return false;
+  }
+
+  bool has_assumptions() const override
+  {
+    return true;
+  }
+
+  void interrupt() override
+  {
+    interrupted = true;
+    ++number_of_interrupts;
+  }
+
+  void clear_interrupt() override
+  {
+    interrupted = false;
+  }
+
+  bool has_interrupt() const override
+  {
+    return true;
+  }
+
+  void set_time_limit_seconds(uint32_t lim) override
+  {
+    time_limit_seconds = lim;
+  }
+
+  static std::atomic<std::size_t> number_of_interrupts;
+  static std::atomic<uint32_t> time_limit_seconds;
+
+protected:
+  std::atomic<bool> interrupted;
+
+  resultt do_prop_solve(const bvt &) override
+  {
+    while(!interrupted)
+      std::this_thread::yield();
+    return resultt::P_ERROR;
+  }
+};
+
+std::atomic<std::size_t> waiting_solvert::number_of_interrupts(0);
+std::atomic<uint32_t> waiting_solvert::time_limit_seconds(0);
+
+SCENARIO("satcheck_portfolio", "[core][solvers][sat][satcheck_portfolio]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  satcheck_portfoliot portfolio(message_handler);
+  portfolio.add_solver<waiting_solvert>();
+  portfolio.add_solver<satcheck_minisat_no_simplifiert>();
+  REQUIRE(portfolio.number_of_solvers() == 2);
+
+  GIVEN("A time limit")
+  {
+    portfolio.set_time_limit_seconds(42);
+
+    THEN("The limit is not passed on to the solvers")
+    {
+      REQUIRE(waiting_solvert::time_limit_seconds == 0);
+    }
+
+    THEN("A solver that answers in time wins, also incrementally")
+    {
+      literalt a = portfolio.new_variable();
+      REQUIRE(portfolio.prop_solve(bvt{a}) == propt::resultt::P_SATISFIABLE);
+      REQUIRE(
+        portfolio.prop_solve(bvt{!a}) == propt::resultt::P_SATISFIABLE);
+      REQUIRE(portfolio.l_get(a).is_false());
+    }
+  }
+
+  GIVEN("A satisfiable formula a && !b")
+  {
+    literalt a = portfolio.new_variable();
+    literalt b = portfolio.new_variable();
+    portfolio.l_set_to_true(portfolio.land(a, !b));
+
+    THEN("The solver that answers wins and the other one is interrupted")
+    {
+      const std::size_t interrupts_before =
+        waiting_solvert::number_of_interrupts;
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(portfolio.l_get(a).is_true());
+      REQUIRE(portfolio.l_get(b).is_false());
+      REQUIRE(waiting_solvert::number_of_interrupts == interrupts_before + 1);
+      REQUIRE(portfolio.get_wins() == std::vector<std::size_t>{0, 1});
+    }
+
+    THEN("The portfolio can be used incrementally")
+    {
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(
+        portfolio.prop_solve(bvt{b}) == propt::resultt::P_UNSATISFIABLE);
+      REQUIRE(portfolio.is_in_conflict(b));
+
+      literalt c = portfolio.new_variable();
+      portfolio.l_set_to_true(portfolio.lor(b, c));
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(portfolio.l_get(c).is_true());
+      REQUIRE(portfolio.get_wins() == std::vector<std::size_t>{0, 3});
+    }
+
+    THEN("An interrupted portfolio does not answer until cleared")
+    {
+      portfolio.interrupt();
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_ERROR);
+      portfolio.clear_interrupt();
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+    }
+  }
+
+  GIVEN("An unsatisfiable formula f && !f")
+  {
+    literalt f = portfolio.new_variable();
+    portfolio.l_set_to_true(portfolio.land(f, !f));
+
+    THEN("is indeed unsatisfiable")
+    {
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+    }
+  }
+}
+
+SCENARIO(
+  "satcheck_portfolio_time_limit",
+  "[core][solvers][sat][satcheck_portfolio]")
+{
+  console_message_handlert message_handler;
+  message_handler.set_verbosity(0);
+
+  satcheck_portfoliot portfolio(message_handler);
+  portfolio.add_solver<waiting_solvert>();
+  portfolio.add_solver<waiting_solvert>();
+
+  GIVEN("Solvers that never answer and a time limit of one second")
+  {
+    portfolio.set_time_limit_seconds(1);
+    literalt a = portfolio.new_variable();
+    portfolio.l_set_to_true(a);
+
+    THEN("All solvers are interrupted once the limit has expired")
+    {
+      const std::size_t interrupts_before =
+        waiting_solvert::number_of_interrupts;
+      const auto start = std::chrono::steady_clock::now();
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_ERROR);
+      REQUIRE(
+        std::chrono::steady_clock::now() - start >= std::chrono::seconds(1));
+      REQUIRE(waiting_solvert::number_of_interrupts == interrupts_before + 2);
+      REQUIRE(portfolio.get_wins() == std::vector<std::size_t>{0, 0});
+    }
+
+    THEN("The portfolio can be used again after timing out")
+    {
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_ERROR);
+      const auto start = std::chrono::steady_clock::now();
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_ERROR);
+      // the solvers were not left interrupted, hence waited for the limit
+      REQUIRE(
+        std::chrono::steady_clock::now() - start >= std::chrono::seconds(1));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,169 @@
+/*******************************************************************\
+
+Module: Unit tests for structural hashing in cnft
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for structural hashing in cnft
+
+#include <solvers/sat/dimacs_cnf.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <algorithm>
+#include <functional>
+
+static bool value(literalt l, std::size_t assignment)
+{
+  if(l.is_constant())
+    return l.is_true();
+  return ((assignment >> l.var_no()) & 1) != l.sign();
+}
+
+/// Check that, for every assignment to the inputs, the clauses can be
+/// satisfied and force \p output to the value of \p expected.
+static bool encodes(
+  cnf_clause_listt &cnf,
+  const bvt &inputs,
+  literalt output,
+  const std::function<bool(std::size_t)> &expected)
+{
+  const std::size_t variables = cnf.no_variables();
+  REQUIRE(variables < 20);
+
+  std::vector<bool> satisfiable(std::size_t{1} << inputs.size(), false);
+
+  for(std::size_t assignment = 0; assignment < (std::size_t{1} << variables);
+      assignment += 2)
+  {
+    bool satisfied = true;
+    for(const auto &clause : cnf.get_clauses())
+    {
+      bool clause_satisfied = false;
+      for(const auto &l : clause)
+        clause_satisfied |= value(l, assignment);
+      satisfied &= clause_satisfied;
+    }
+
+    if(!satisfied)
+      continue;
+
+    std::size_t input_values = 0;
+    for(std::size_t i = 0; i < inputs.size(); ++i)
+      input_values |= std::size_t{value(inputs[i], assignment)} << i;
+
+    if(value(output, assignment) != expected(input_values))
+      return false;
+    satisfiable[input_values] = true;
+  }
+
+  return std::find(satisfiable.begin(), satisfiable.end(), false) ==
+         satisfiable.end();
+}
+
+TEST_CASE(
+  "Structural hashing shares equivalent gates",
+  "[core][solvers][sat][structural_hashing]")
+{
+  dimacs_cnft cnf{null_message_handler};
+  cnf.set_structural_hashing(true);
+  const literalt a = cnf.new_variable();
+  const literalt b = cnf.new_variable();
+  const literalt c = cnf.new_variable();
+
+  SECTION("AND and OR")
+  {
+    const literalt a_and_b = cnf.land(a, b);
+    const std::size_t clauses = cnf.no_clauses();
+    REQUIRE(cnf.land(b, a) == a_and_b);
+    REQUIRE(cnf.lnand(a, b) == !a_and_b);
+    REQUIRE(cnf.lor(!a, !b) == !a_and_b);
+    REQUIRE(cnf.limplies(a, !b) == !a_and_b);
+    REQUIRE(cnf.no_clauses() == clauses);
+    REQUIRE(cnf.get_structural_hashing_statistics().hashed == 4);
+    REQUIRE(cnf.get_structural_hashing_statistics().clauses_saved == 12);
+  }
+
+  SECTION("AND of more than two inputs")
+  {
+    const literalt conjunction = cnf.land(bvt{a, b, c});
+    REQUIRE(cnf.land(bvt{c, a, b, a}) == conjunction);
+    REQUIRE(cnf.land(bvt{c, const_literal(true), b, a}) == conjunction);
+    REQUIRE(cnf.lor(bvt{!a, !b, !c}) == !conjunction);
+    REQUIRE(cnf.land(bvt{c, a, !c}).is_false());
+  }
+
+  SECTION("XOR")
+  {
+    const literalt a_xor_b = cnf.lxor(a, b);
+    REQUIRE(cnf.lxor(b, a) == a_xor_b);
+    REQUIRE(cnf.lxor(!a, b) == !a_xor_b);
+    REQUIRE(cnf.lxor(!a, !b) == a_xor_b);
+    REQUIRE(cnf.lequal(a, b) == !a_xor_b);
+  }
+
+  SECTION("If-then-else")
+  {
+    const literalt select = cnf.lselect(a, b, c);
+    REQUIRE(cnf.lselect(!a, c, b) == select);
+    REQUIRE(cnf.lselect(a, !b, !c) == !select);
+    REQUIRE(encodes(cnf, {a, b, c}, select, [](std::size_t v) {
+      return (v & 1) ? (v & 2) : (v & 4);
+    }));
+  }
+
+  SECTION("Gates encoded before solving are not shared")
+  {
+    const literalt a_and_b = cnf.land(a, b);
+    cnf.prop_solve();
+    REQUIRE(cnf.land(a, b) != a_and_b);
+  }
+}
+
+TEST_CASE(
+  "Structural hashing rewrites AND gates",
+  "[core][solvers][sat][structural_hashing]")
+{
+  dimacs_cnft cnf{null_message_handler};
+  cnf.set_structural_hashing(true);
+  const literalt a = cnf.new_variable();
+  const literalt b = cnf.new_variable();
+  const literalt c = cnf.new_variable();
+  const literalt a_and_b = cnf.land(a, b);
+
+  // contradiction
+  REQUIRE(cnf.land(a, !a).is_false());
+  REQUIRE(cnf.land(a_and_b, !b).is_false());
+  REQUIRE(cnf.land(a_and_b, cnf.land(!a, c)).is_false());
+  // idempotence
+  REQUIRE(cnf.land(a_and_b, a) == a_and_b);
+  // subsumption
+  REQUIRE(cnf.land(!a_and_b, !a) == !a);
+  // resolution
+  REQUIRE(cnf.land(!a_and_b, !cnf.land(a, !b)) == !a);
+
+  // substitution
+  const literalt substituted = cnf.land(!a_and_b, a);
+  REQUIRE(substituted == cnf.land(a, !b));
+  REQUIRE(encodes(cnf, {a, b}, substituted, [](std::size_t v) {
+    return v == 1;
+  }));
+
+  REQUIRE(cnf.get_structural_hashing_statistics().rewritten == 7);
+}
+
+TEST_CASE(
+  "Structural hashing is disabled by default",
+  "[core][solvers][sat][structural_hashing]")
+{
+  dimacs_cnft cnf{null_message_handler};
+  const literalt a = cnf.new_variable();
+  const literalt b = cnf.new_variable();
+
+  const literalt a_and_b = cnf.land(a, b);
+  REQUIRE(cnf.land(b, a) != a_and_b);
+  REQUIRE(cnf.get_structural_hashing_statistics().gates == 0);
+}
@@ -0,0 +1,160 @@
+// Author: Diffblue Ltd.
+
+#ifdef HAVE_Z3_API
+
+#  include <util/arith_tools.h>
+#  include <util/bitvector_types.h>
+#  include <util/config.h>
+#  include <util/namespace.h>
+#  include <util/symbol_table.h>
+
+#  include <solvers/smt2_incremental/ast/smt_commands.h>
+#  include <solvers/smt2_incremental/ast/smt_responses.h>
+#  include <solvers/smt2_incremental/ast/smt_sorts.h>
+#  include <solvers/smt2_incremental/ast/smt_terms.h>
+#  include <solvers/smt2_incremental/smt2_incremental_decision_procedure.h>
+#  include <solvers/smt2_incremental/smt_z3_api_solver_process.h>
+#  include <solvers/smt2_incremental/theories/smt_array_theory.h>
+#  include <solvers/smt2_incremental/theories/smt_bit_vector_theory.h>
+#  include <solvers/smt2_incremental/theories/smt_core_theory.h>
+#  include <testing-utils/message.h>
+#  include <testing-utils/use_catch.h>
+
+static smt_responset get_value(
+  smt_base_solver_processt &solver_process,
+  const smt_termt &descriptor)
+{
+  solver_process.send(smt_get_value_commandt{descriptor});
+  return solver_process.receive_response({});
+}
+
+TEST_CASE(
+  "smt_z3_api_solver_processt solves commands without SMT-LIB text",
+  "[core][smt2_incremental]")
+{
+  smt_z3_api_solver_processt solver_process{null_message_handler, nullptr};
+  const smt_check_sat_responset sat{smt_sat_responset{}};
+  const smt_check_sat_responset unsat{smt_unsat_responset{}};
+
+  const smt_bit_vector_sortt bv8{8};
+  const smt_identifier_termt x{"x", bv8};
+  solver_process.send(
+    smt_set_option_commandt{smt_option_produce_modelst{true}});
+  solver_process.send(smt_set_logic_commandt{smt_logic_allt{}});
+  solver_process.send(smt_declare_function_commandt{x, {}});
+  REQUIRE(solver_process.receive_response({}) == smt_success_responset{});
+
+  SECTION("Bit-vector arithmetic and values")
+  {
+    solver_process.send(smt_assert_commandt{smt_core_theoryt::equal(
+      smt_bit_vector_theoryt::add(x, smt_bit_vector_constant_termt{3, bv8}),
+      smt_bit_vector_constant_termt{10, bv8})});
+    solver_process.send(smt_check_sat_commandt{});
+    REQUIRE(solver_process.receive_response({}) == sat);
+    REQUIRE(
+      get_value(solver_process, x) ==
+      smt_get_value_responset{
+        {{x, smt_bit_vector_constant_termt{7, bv8}}}});
+    REQUIRE(
+      get_value(
+        solver_process,
+        smt_bit_vector_theoryt::extract(7, 7)(
+          smt_bit_vector_theoryt::negate(x))) ==
+      smt_get_value_responset{
+        {{smt_bit_vector_theoryt::extract(7, 7)(
+            smt_bit_vector_theoryt::negate(x)),
+          smt_bit_vector_constant_termt{1, 1}}}});
+  }
+
+  SECTION("Functions and contexts")
+  {
+    const smt_identifier_termt parameter{"p", bv8};
+    const smt_define_function_commandt twice{
+      "twice", {parameter}, smt_bit_vector_theoryt::add(parameter, parameter)};
+    const smt_declare_function_commandt f{
+      smt_identifier_termt{"f", smt_bool_sortt{}}, {bv8}};
+    const smt_function_application_termt::factoryt<smt_command_functiont>
+      apply_twice{twice}, apply_f{f};
+    solver_process.send(twice);
+    solver_process.send(f);
+    solver_process.send(smt_assert_commandt{apply_f(std::vector<smt_termt>{
+      apply_twice(std::vector<smt_termt>{x})})});
+
+    solver_process.send(smt_push_commandt{1});
+    solver_process.send(smt_assert_commandt{smt_core_theoryt::make_not(
+      apply_f(std::vector<smt_termt>{smt_bit_vector_theoryt::multiply(
+        x, smt_bit_vector_constant_termt{2, bv8})}))});
+    solver_process.send(smt_check_sat_commandt{});
+    REQUIRE(solver_process.receive_response({}) == unsat);
+
+    solver_process.send(smt_pop_commandt{1});
+    solver_process.send(smt_check_sat_commandt{});
+    REQUIRE(solver_process.receive_response({}) == sat);
+  }
+
+  SECTION("Quantifiers and arrays")
+  {
+    const smt_identifier_termt array{"a", smt_array_sortt{bv8, bv8}};
+    const smt_identifier_termt index{"i", bv8};
+    solver_process.send(smt_declare_function_commandt{array, {}});
+    solver_process.send(smt_assert_commandt{smt_forall_termt{
+      {index},
+      smt_core_theoryt::equal(
+        smt_array_theoryt::select(array, index),
+        smt_bit_vector_theoryt::subtract(index, x))}});
+    solver_process.send(smt_assert_commandt{smt_core_theoryt::equal(
+      smt_array_theoryt::select(array, smt_bit_vector_constant_termt{5, bv8}),
+      smt_bit_vector_constant_termt{2, bv8})});
+    solver_process.send(smt_check_sat_commandt{});
+    REQUIRE(solver_process.receive_response({}) == sat);
+    REQUIRE(
+      get_value(solver_process, x) ==
+      smt_get_value_responset{
+        {{x, smt_bit_vector_constant_termt{3, bv8}}}});
+  }
+
+  SECTION("Errors are reported in response to later commands")
+  {
+    solver_process.send(smt_assert_commandt{
+      smt_identifier_termt{"undeclared", smt_bool_sortt{}}});
+    solver_process.send(smt_check_sat_commandt{});
+    const smt_responset response = solver_process.receive_response({});
+    REQUIRE(response.cast<smt_error_responset>());
+    solver_process.send(smt_check_sat_commandt{});
+    REQUIRE(solver_process.receive_response({}) == response);
+  }
+}
+
+TEST_CASE(
+  "smt2_incremental_decision_proceduret with the Z3 API",
+  "[core][smt2_incremental]")
+{
+  // object bit width encodings depend on the global configuration
+  config.ansi_c.mode = configt::ansi_ct::flavourt::GCC;
+  config.ansi_c.set_arch_spec_i386();
+
+  symbol_tablet symbol_table;
+  namespacet ns{symbol_table};
+  smt2_incremental_decision_proceduret procedure{
+    ns,
+    std::make_unique<smt_z3_api_solver_processt>(null_message_handler, nullptr),
+    null_message_handler};
+
+  const unsignedbv_typet u32{32};
+  const symbol_exprt x{"x", u32};
+  const symbol_exprt y{"y", u32};
+  procedure.set_to_true(
+    equal_exprt{mult_exprt{x, from_integer(3, u32)}, from_integer(21, u32)});
+  procedure.set_to_true(equal_exprt{y, plus_exprt{x, from_integer(1, u32)}});
+  procedure.set_to_true(
+    binary_relation_exprt{x, ID_lt, from_integer(100, u32)});
+
+  REQUIRE(procedure() == decision_proceduret::resultt::D_SATISFIABLE);
+  REQUIRE(procedure.get(x) == from_integer(7, u32));
+  REQUIRE(procedure.get(y) == from_integer(8, u32));
+
+  procedure.set_to_false(equal_exprt{y, from_integer(8, u32)});
+  REQUIRE(procedure() == decision_proceduret::resultt::D_UNSATISFIABLE);
+}
+
+#endif // HAVE_Z3_API
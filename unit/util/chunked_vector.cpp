@@ -0,0 +1,132 @@
+/*******************************************************************\
+
+Module: Unit tests for chunked_vectort
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/chunked_vector.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("Appending to a chunked vector", "[core][util][chunked_vector]")
+{
+  chunked_vectort<std::string, 1, 2> vector;
+  REQUIRE(vector.empty());
+  REQUIRE(vector.begin() == vector.end());
+
+  vector.push_back("0");
+  const std::string &first = vector.front();
+  const auto first_it = vector.begin();
+  const auto end_it = vector.end();
+
+  for(std::size_t i = 1; i < 10; ++i)
+    REQUIRE(vector.emplace_back(std::to_string(i)) == std::to_string(i));
+
+  REQUIRE(vector.size() == 10);
+  REQUIRE(vector.back() == "9");
+
+  // neither references nor iterators are invalidated by appending
+  REQUIRE(&first == &vector.front());
+  REQUIRE(first_it == vector.begin());
+  REQUIRE(*first_it == "0");
+  // an iterator is an index, hence the former end now is the second element
+  REQUIRE(*end_it == "1");
+
+  REQUIRE(std::distance(vector.begin(), vector.end()) == 10);
+  std::size_t index = 0;
+  for(auto it = vector.begin(); it != vector.end(); ++it, ++index)
+  {
+    REQUIRE(it.index() == index);
+    REQUIRE(*it == std::to_string(index));
+    REQUIRE(vector[index] == std::to_string(index));
+  }
+
+  REQUIRE(*vector.rbegin() == "9");
+  REQUIRE(*std::prev(vector.rend()) == "0");
+  REQUIRE(vector.begin() + 5 - 2 == std::next(vector.begin(), 3));
+  REQUIRE(vector.begin() < vector.end());
+
+  chunked_vectort<std::string, 1, 2>::const_iterator const_it = vector.begin();
+  REQUIRE(const_it == vector.begin());
+  REQUIRE(vector.end() - const_it == 10);
+
+  SECTION("Copies are independent")
+  {
+    auto copy = vector;
+    copy.front() = "changed";
+    REQUIRE(vector.front() == "0");
+    REQUIRE(copy.size() == vector.size());
+    REQUIRE(std::equal(
+      std::next(copy.begin()), copy.end(), std::next(vector.begin())));
+  }
+
+  SECTION("Iterators remain valid when the vector is moved")
+  {
+    const auto fifth = vector.begin() + 5;
+    const auto moved = std::move(vector);
+    REQUIRE(*fifth == "5");
+    REQUIRE(fifth == moved.begin() + 5);
+
+    // the vector that was moved from can be used again
+    REQUIRE(vector.empty());
+    REQUIRE(vector.begin() == vector.end());
+    vector.push_back("again");
+    REQUIRE(vector.size() == 1);
+    REQUIRE(vector.front() == "again");
+  }
+
+  SECTION("Clearing destroys all elements")
+  {
+    vector.clear();
+    REQUIRE(vector.empty());
+    vector.emplace_back("new");
+    REQUIRE(vector.front() == "new");
+  }
+}
+
+TEST_CASE(
+  "Chunked vector of move-only elements",
+  "[core][util][chunked_vector]")
+{
+  chunked_vectort<std::unique_ptr<int>, 0, 1> vector;
+  for(int i = 0; i < 5; ++i)
+    vector.push_back(std::unique_ptr<int>(new int(i)));
+
+  chunked_vectort<std::unique_ptr<int>, 0, 1> other;
+  for(auto &element : vector)
+    other.push_back(std::move(element));
+
+  REQUIRE(other.size() == 5);
+  REQUIRE(*other.back() == 4);
+  REQUIRE(vector.front() == nullptr);
+}
+
+TEST_CASE(
+  "Chunks of a chunked vector grow up to their maximum size",
+  "[core][util][chunked_vector]")
+{
+  // chunks of 4, 8, 16, 16, ... elements
+  chunked_vectort<std::size_t, 2, 4> vector;
+  std::vector<const std::size_t *> addresses;
+  for(std::size_t i = 0; i < 200; ++i)
+    addresses.push_back(&vector.emplace_back(i));
+
+  for(std::size_t i = 0; i < 200; ++i)
+  {
+    REQUIRE(vector[i] == i);
+    REQUIRE(&vector[i] == addresses[i]);
+  }
+
+  // elements within one chunk are contiguous
+  REQUIRE(addresses[3] == addresses[0] + 3);
+  REQUIRE(addresses[11] == addresses[4] + 7);
+  REQUIRE(addresses[27] == addresses[12] + 15);
+  REQUIRE(addresses[43] == addresses[28] + 15);
+}
@@ -7,6 +7,11 @@
 #include <util/irep.h>
 #include <util/std_expr.h>
 
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
 #ifdef SHARING
 
 SCENARIO("irept_sharing_trade_offs", "[core][utils][irept]" XFAIL)
@@ -219,4 +224,80 @@ SCENARIO("exprt_sharing", "[core][utils][exprt]")
   }
 }
 
+#  if IREP_ATOMIC_REF_COUNT
+SCENARIO("irept_sharing_between_threads", "[core][utils][irept]")
+{
+  GIVEN("An irept that is not modified any further")
+  {
+    irept test_irep(ID_1);
+    for(std::size_t i = 0; i < 100; ++i)
+      test_irep.get_sub().push_back(irept(ID_0, {{ID_type, irept(ID_1)}}, {}));
+    const irept &frozen = test_irep;
+
+    THEN("Threads can copy it and modify their copies")
+    {
+      const std::size_t number_of_threads = 8;
+      // Catch assertions must not be used from multiple threads
+      std::vector<char> copies_ok(number_of_threads, false);
+      std::vector<std::thread> threads;
+      for(std::size_t t = 0; t < number_of_threads; ++t)
+      {
+        threads.emplace_back([&frozen, &copies_ok, t] {
+          bool ok = true;
+          for(std::size_t i = 0; i < 1000; ++i)
+          {
+            irept copy = frozen;
+            copy.get_sub()[i % 100].id(ID_nil);
+            ok &= copy.get_sub()[i % 100].id() == ID_nil;
+            for(const auto &sub : frozen.get_sub())
+            {
+              irept sub_copy = sub;
+              ok &= sub_copy.hash() == frozen.get_sub().front().hash();
+            }
+          }
+          copies_ok[t] = ok;
+        });
+      }
+      for(auto &thread : threads)
+        thread.join();
+
+      for(std::size_t t = 0; t < number_of_threads; ++t)
+        REQUIRE(copies_ok[t]);
+      for(const auto &sub : frozen.get_sub())
+        REQUIRE(sub.id() == ID_0);
+      REQUIRE(frozen.read().get_ref_count() == 1);
+    }
+  }
+}
+#  endif
+
+// Run with `unit "[benchmark][irept]"` in builds with and without
+// IREP_ATOMIC_REF_COUNT to compare the cost of atomic reference counts.
+TEST_CASE("irept copy and detach throughput", "[.][benchmark][utils][irept]")
+{
+  irept test_irep(ID_1);
+  for(std::size_t i = 0; i < 1000; ++i)
+    test_irep.get_sub().push_back(irept(ID_0, {{ID_type, irept(ID_1)}}, {}));
+
+  const auto start = std::chrono::steady_clock::now();
+  std::size_t count = 0;
+  for(std::size_t i = 0; i < 10000; ++i)
+  {
+    irept copy = test_irep;
+    for(const auto &sub : test_irep.get_sub())
+    {
+      irept sub_copy = sub;
+      count += sub_copy.get_sub().size();
+    }
+    // detaches the copy from test_irep
+    copy.get_sub()[i % 1000].id(ID_nil);
+    count += copy.get_sub().size();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+
+  std::cout << "IREP_ATOMIC_REF_COUNT=" << IREP_ATOMIC_REF_COUNT << ": "
+            << std::chrono::duration<double>(stop - start).count() << "s for "
+            << count << " nodes\n";
+}
+
 #endif
@@ -0,0 +1,55 @@
+/*******************************************************************\
+
+Module: Unit tests for merge_irept
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/merge_irep.h>
+#include <util/std_expr.h>
+
+#ifdef SHARING
+
+TEST_CASE("Merging identical ireps", "[core][util][merge_irep]")
+{
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+
+  // two structurally identical, but separately constructed expressions
+  exprt a = plus_exprt(x, from_integer(1, type));
+  exprt b = plus_exprt(x, from_integer(1, type));
+  REQUIRE(&a.read() != &b.read());
+
+  merge_irept merge_irep;
+  merge_irep(a);
+  REQUIRE(merge_irep.number_of_merged() == 0);
+  const std::size_t distinct = merge_irep.size();
+  REQUIRE(distinct > 0);
+
+  merge_irep(b);
+  REQUIRE(&a.read() == &b.read());
+  REQUIRE(merge_irep.number_of_merged() == 1);
+  REQUIRE(merge_irep.size() == distinct);
+
+  SECTION("Shared subexpressions are merged")
+  {
+    exprt c = mult_exprt(x, from_integer(1, type));
+    merge_irep(c);
+    REQUIRE(&to_mult_expr(c).op1().read() == &to_plus_expr(a).op1().read());
+    REQUIRE(&to_mult_expr(c).op0().read() == &to_plus_expr(a).op0().read());
+    REQUIRE(merge_irep.number_of_merged() == 2);
+  }
+
+  SECTION("Merging an irep again is not counted")
+  {
+    merge_irep(a);
+    REQUIRE(merge_irep.number_of_merged() == 1);
+  }
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*******************************************************************\
+
+Module: Unit tests for node_poolt
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/irep.h>
+#include <util/node_pool.h>
+
+#include <set>
+#include <vector>
+
+struct test_nodet
+{
+  std::size_t payload[5];
+};
+
+TEST_CASE("Allocating nodes from a pool", "[core][util][node_pool]")
+{
+  node_poolt pool(sizeof(test_nodet));
+
+  std::vector<test_nodet *> nodes;
+  for(std::size_t i = 0; i < 10000; ++i)
+  {
+    test_nodet *node = static_cast<test_nodet *>(pool.allocate());
+    node->payload[0] = i;
+    node->payload[4] = i;
+    nodes.push_back(node);
+  }
+
+  // nodes are distinct and do not overlap
+  REQUIRE(std::set<test_nodet *>(nodes.begin(), nodes.end()).size() == 10000);
+  for(std::size_t i = 0; i < nodes.size(); ++i)
+  {
+    REQUIRE(nodes[i]->payload[0] == i);
+    REQUIRE(nodes[i]->payload[4] == i);
+  }
+
+  auto statistics = pool.compute_statistics();
+  REQUIRE(statistics.allocations == 10000);
+  REQUIRE(statistics.live_nodes == 10000);
+  REQUIRE(statistics.peak_live_nodes == 10000);
+  REQUIRE(statistics.slabs > 1);
+
+  SECTION("Freed nodes are reused")
+  {
+    test_nodet *freed = nodes.back();
+    pool.deallocate(freed);
+    nodes.pop_back();
+    REQUIRE(pool.allocate() == freed);
+    REQUIRE(pool.compute_statistics().live_nodes == 10000);
+  }
+
+  SECTION("Slabs are released once all their nodes have been freed")
+  {
+    // free every other node: no slab is entirely free
+    for(std::size_t i = 0; i < nodes.size(); i += 2)
+      pool.deallocate(nodes[i]);
+    REQUIRE(pool.release_free_slabs() == 0);
+
+    for(std::size_t i = 1; i < nodes.size(); i += 2)
+      pool.deallocate(nodes[i]);
+    REQUIRE(pool.compute_statistics().live_nodes == 0);
+    REQUIRE(pool.release_free_slabs() == statistics.slabs);
+
+    statistics = pool.compute_statistics();
+    REQUIRE(statistics.slabs == 0);
+    REQUIRE(statistics.deallocations == 10000);
+    REQUIRE(statistics.peak_live_nodes == 10000);
+
+    // the pool remains usable
+    test_nodet *node = static_cast<test_nodet *>(pool.allocate());
+    node->payload[4] = 42;
+    REQUIRE(pool.compute_statistics().slabs == 1);
+    pool.deallocate(node);
+  }
+
+  SECTION("Slabs with live nodes are kept")
+  {
+    // keep the first node, which shares its slab with its neighbours
+    for(std::size_t i = 1; i < nodes.size(); ++i)
+      pool.deallocate(nodes[i]);
+    REQUIRE(pool.release_free_slabs() == statistics.slabs - 1);
+    REQUIRE(nodes[0]->payload[4] == 0);
+
+    // the free nodes of the remaining slab can still be allocated
+    test_nodet *node = static_cast<test_nodet *>(pool.allocate());
+    REQUIRE(node != nodes[0]);
+    REQUIRE(pool.compute_statistics().slabs == 1);
+  }
+}
+
+TEST_CASE("Allocating irep nodes", "[core][util][node_pool]")
+{
+#if IREP_NODE_POOL
+  node_poolt &pool = irept::dt::node_pool();
+  const node_pool_statisticst before = pool.compute_statistics();
+
+  {
+    irept irep{"node"};
+    irep.get_sub().emplace_back("sub");
+    irep.add("named").id("named_sub");
+
+    const node_pool_statisticst during = pool.compute_statistics();
+    REQUIRE(during.allocations == before.allocations + 3);
+    REQUIRE(during.live_nodes == before.live_nodes + 3);
+  }
+
+  const node_pool_statisticst after = pool.compute_statistics();
+  REQUIRE(after.deallocations == before.deallocations + 3);
+  REQUIRE(after.live_nodes == before.live_nodes);
+#else
+  WARN("irep nodes are not allocated from a pool as this build lacks "
+       "IREP_NODE_POOL");
+#endif
+}
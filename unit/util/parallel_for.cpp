@@ -0,0 +1,49 @@
+/*******************************************************************\
+
+Module: Unit tests for parallel_for
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/parallel_for.h>
+
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Parallel loops visit each index once", "[core][util][parallel_for]")
+{
+  const std::size_t number_of_threads = GENERATE(0, 1, 4);
+  const std::size_t size = 1000;
+
+  std::vector<std::size_t> visits(size, 0);
+  std::vector<std::size_t> threads(size, 0);
+  parallel_for(
+    number_of_threads, size, [&](std::size_t thread, std::size_t index) {
+      ++visits[index];
+      threads[index] = thread;
+    });
+
+  for(std::size_t index = 0; index < size; ++index)
+  {
+    REQUIRE(visits[index] == 1);
+    REQUIRE(threads[index] < effective_number_of_threads(number_of_threads));
+  }
+}
+
+TEST_CASE(
+  "Parallel loops rethrow exceptions",
+  "[core][util][parallel_for]")
+{
+  REQUIRE_THROWS_AS(
+    parallel_for(
+      4,
+      100,
+      [](std::size_t, std::size_t index) {
+        if(index == 42)
+          throw std::runtime_error("42");
+      }),
+    std::runtime_error);
+}
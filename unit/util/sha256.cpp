@@ -0,0 +1,51 @@
+/*******************************************************************\
+
+Module: Unit tests for sha256.h
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+#include <util/sha256.h>
+
+static std::string sha256_hex(const std::string &message)
+{
+  sha256t sha256;
+  sha256.update(message);
+  return sha256t::to_hex(sha256.digest());
+}
+
+TEST_CASE("SHA-256 matches the FIPS 180-4 examples", "[core][util][sha256]")
+{
+  REQUIRE(
+    sha256_hex("") ==
+    "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  REQUIRE(
+    sha256_hex("abc") ==
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  REQUIRE(
+    sha256_hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  REQUIRE(
+    sha256_hex(std::string(1000000, 'a')) ==
+    "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST_CASE(
+  "SHA-256 digests do not depend on how the message is split",
+  "[core][util][sha256]")
+{
+  const std::string message(200, 'x');
+  const std::string expected = sha256_hex(message);
+
+  for(std::size_t split = 0; split <= message.size(); ++split)
+  {
+    sha256t sha256;
+    sha256.update(message.substr(0, split));
+    // digests of prefixes do not affect the final result
+    sha256.digest();
+    sha256.update(message.substr(split));
+    REQUIRE(sha256t::to_hex(sha256.digest()) == expected);
+  }
+}
@@ -18,10 +18,14 @@ Author: Michael Tautschnig
 #include <util/pointer_expr.h>
 #include <util/pointer_predicates.h>
 #include <util/simplify_expr.h>
+#include <util/simplify_expr_class.h>
 #include <util/simplify_utils.h>
 #include <util/std_expr.h>
 #include <util/symbol_table.h>
 
+#include <chrono>
+#include <iostream>
+
 TEST_CASE("Simplify pointer_offset(address of array index)", "[core][util]")
 {
   config.set_arch("none");
@@ -571,3 +575,104 @@ TEST_CASE("Simplify bitxor", "[core][util]")
       false_c_bool);
   }
 }
+
+/// Builds an expression of the given depth in which each level refers to the
+/// level below twice, i.e., a tree with 2^depth leaves represented by a DAG
+/// with just depth + 1 nodes.
+static exprt shared_shift_dag(const exprt &leaf, std::size_t depth)
+{
+  exprt result = leaf;
+  for(std::size_t i = 0; i < depth; ++i)
+    result = shl_exprt{result, result};
+  return result;
+}
+
+TEST_CASE("Simplify shared subexpressions once", "[core][util]")
+{
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const unsignedbv_typet type{32};
+  const symbol_exprt x{"x", type};
+  const std::size_t depth = 64;
+
+  // without reusing results for shared nodes this would take 2^64 steps
+  const exprt original =
+    shared_shift_dag(plus_exprt{x, from_integer(0, type)}, depth);
+  exprt expr = original;
+
+  simplify_exprt simplifier{ns};
+  REQUIRE(!simplifier.simplify(expr));
+  // the result still shares its subexpressions
+  const exprt *level = &expr;
+  for(std::size_t i = 0; i < depth; ++i)
+  {
+    REQUIRE(level->id() == ID_shl);
+    REQUIRE(&level->operands()[0].read() == &level->operands()[1].read());
+    level = &level->operands()[0];
+  }
+  REQUIRE(*level == x);
+
+  const auto &statistics = simplifier.get_cache_statistics();
+  REQUIRE(statistics.hits >= depth);
+  REQUIRE(statistics.misses <= 2 * depth);
+
+  SECTION("Results are reused when simplifying the same expression again")
+  {
+    exprt again = original;
+    const std::size_t hits = statistics.hits;
+    REQUIRE(!simplifier.simplify(again));
+    REQUIRE(statistics.hits == hits + 1);
+    REQUIRE(&again.read() == &expr.read());
+  }
+
+  SECTION("Clearing the cache keeps the statistics")
+  {
+    exprt again = original;
+    const std::size_t hits = statistics.hits;
+    const std::size_t misses = statistics.misses;
+    simplifier.clear_cache();
+    REQUIRE(!simplifier.simplify(again));
+    // the result is built anew, but again shares its subexpressions
+    REQUIRE(&again.read() != &expr.read());
+    const exprt *level = &again;
+    for(std::size_t i = 0; i < depth; ++i)
+    {
+      REQUIRE(level->id() == ID_shl);
+      REQUIRE(&level->operands()[0].read() == &level->operands()[1].read());
+      level = &level->operands()[0];
+    }
+    REQUIRE(*level == x);
+    REQUIRE(statistics.hits > hits);
+    REQUIRE(statistics.misses > misses);
+  }
+}
+
+// Run with `unit "[benchmark][simplify_expr]"`
+TEST_CASE(
+  "Simplifying shared subexpressions",
+  "[.][benchmark][util][simplify_expr]")
+{
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const unsignedbv_typet type{32};
+  const symbol_exprt x{"x", type};
+
+  for(std::size_t depth = 250; depth <= 4000; depth *= 2)
+  {
+    exprt expr = shared_shift_dag(plus_exprt{x, from_integer(0, type)}, depth);
+
+    simplify_exprt simplifier{ns};
+    const auto start = std::chrono::steady_clock::now();
+    simplifier.simplify(expr);
+    const auto stop = std::chrono::steady_clock::now();
+
+    const auto &statistics = simplifier.get_cache_statistics();
+    std::cout << "depth: " << depth << ", "
+              << std::chrono::duration<double>(stop - start).count()
+              << "s, cache hits: " << statistics.hits
+              << ", misses: " << statistics.misses << '\n';
+  }
+}
+
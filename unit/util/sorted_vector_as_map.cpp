@@ -0,0 +1,74 @@
+/*******************************************************************\
+
+Module: Unit tests for sorted_vector_as_mapt
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/sorted_vector_as_map.h>
+
+#include <map>
+
+using mapt = sorted_vector_as_mapt<int, int>;
+
+static std::vector<std::pair<int, int>> elements(const mapt &map)
+{
+  return {map.begin(), map.end()};
+}
+
+TEST_CASE(
+  "Elements are kept in order of their keys",
+  "[core][util][sorted_vector_as_map]")
+{
+  mapt map;
+  REQUIRE(map.empty());
+
+  map[5] = 50;
+  map[1] = 10;
+  REQUIRE(map.insert({3, 30}).second);
+  REQUIRE_FALSE(map.insert({3, 31}).second);
+  REQUIRE(elements(map) == std::vector<std::pair<int, int>>{
+                             {1, 10}, {3, 30}, {5, 50}});
+
+  REQUIRE(map.find(3)->second == 30);
+  REQUIRE(map.find(4) == map.end());
+  REQUIRE(map.count(5) == 1);
+  REQUIRE(map.count(0) == 0);
+
+  REQUIRE(map.erase(4) == 0);
+  REQUIRE(map.erase(3) == 1);
+  REQUIRE(elements(map) == std::vector<std::pair<int, int>>{{1, 10}, {5, 50}});
+}
+
+TEST_CASE(
+  "Inserting a range keeps existing elements",
+  "[core][util][sorted_vector_as_map]")
+{
+  mapt map{{4, 40}, {1, 10}, {6, 60}};
+  const std::map<int, int> other{{0, 0}, {4, 41}, {5, 50}, {9, 90}};
+
+  map.insert(other.begin(), other.end());
+
+  REQUIRE(
+    elements(map) == std::vector<std::pair<int, int>>{
+                       {0, 0}, {1, 10}, {4, 40}, {5, 50}, {6, 60}, {9, 90}});
+}
+
+TEST_CASE(
+  "Elements can be added at the end with a hint",
+  "[core][util][sorted_vector_as_map]")
+{
+  mapt map;
+  map.emplace_hint(map.end(), 1, 10);
+  map.emplace_hint(map.end(), 3, 30);
+  // out of order, or existing: the hint is ignored
+  map.emplace_hint(map.end(), 2, 20);
+  map.emplace_hint(map.end(), 3, 31);
+
+  REQUIRE(
+    elements(map) ==
+    std::vector<std::pair<int, int>>{{1, 10}, {2, 20}, {3, 30}});
+}
@@ -0,0 +1,132 @@
+/*******************************************************************\
+
+Module: Unit tests for string_containert
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/string_container.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static std::vector<unsigned> intern_range(
+  string_containert &container,
+  std::size_t first,
+  std::size_t count)
+{
+  std::vector<unsigned> result;
+  result.reserve(count);
+  for(std::size_t i = first; i < first + count; ++i)
+    result.push_back(container["string_" + std::to_string(i)]);
+  return result;
+}
+
+TEST_CASE("Interning strings", "[core][util][string_container]")
+{
+  string_containert container;
+
+  const unsigned foo = container["foo"];
+  const unsigned bar = container[std::string("bar")];
+
+  REQUIRE(foo != bar);
+  REQUIRE(container["foo"] == foo);
+  REQUIRE(container[std::string("bar")] == bar);
+  REQUIRE(container.get_string(foo) == "foo");
+  REQUIRE(std::string(container.c_str(bar)) == "bar");
+  // the empty string is pre-allocated
+  REQUIRE(container[""] == 0);
+
+  SECTION("References remain stable while the container grows")
+  {
+    const std::string &foo_ref = container.get_string(foo);
+    const auto numbers = intern_range(container, 0, 100000);
+    REQUIRE(&container.get_string(foo) == &foo_ref);
+    REQUIRE(container.get_string(numbers.back()) == "string_99999");
+    REQUIRE(
+      container.compute_statistics().string_count >= numbers.size() + 2);
+  }
+}
+
+TEST_CASE(
+  "Interning strings from multiple threads",
+  "[core][util][string_container]")
+{
+  string_containert container;
+  const std::size_t number_of_threads = 8;
+  const std::size_t strings_per_thread = 20000;
+
+  // all threads intern the same strings, but start at different offsets
+  std::vector<std::vector<unsigned>> results(number_of_threads);
+  // Catch assertions must not be used from multiple threads
+  std::vector<char> lookups_ok(number_of_threads, false);
+  std::vector<std::thread> threads;
+  for(std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    threads.emplace_back([&container, &results, &lookups_ok, t] {
+      results[t] = intern_range(
+        container,
+        t * strings_per_thread / number_of_threads,
+        strings_per_thread);
+      // lookups run concurrently with insertions by other threads
+      lookups_ok[t] = true;
+      for(const unsigned no : results[t])
+      {
+        if(container.get_string(no).compare(0, 7, "string_") != 0)
+          lookups_ok[t] = false;
+      }
+    });
+  }
+  for(auto &thread : threads)
+    thread.join();
+
+  for(std::size_t t = 0; t < number_of_threads; ++t)
+    REQUIRE(lookups_ok[t]);
+
+  for(std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    const std::size_t first = t * strings_per_thread / number_of_threads;
+    for(std::size_t i = 0; i < strings_per_thread; ++i)
+    {
+      const unsigned no = results[t][i];
+      REQUIRE(
+        container.get_string(no) == "string_" + std::to_string(first + i));
+      REQUIRE(container["string_" + std::to_string(first + i)] == no);
+    }
+  }
+}
+
+// Run with `unit "[benchmark][string_container]"`
+TEST_CASE("Interning throughput", "[.][benchmark][util][string_container]")
+{
+  const std::size_t strings_per_thread = 200000;
+
+  for(std::size_t number_of_threads = 1; number_of_threads <= 64;
+      number_of_threads *= 2)
+  {
+    string_containert container;
+
+    // half of the strings of each thread are shared with its neighbour
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < number_of_threads; ++t)
+    {
+      threads.emplace_back([&container, t] {
+        (void)intern_range(
+          container, t * strings_per_thread / 2, strings_per_thread);
+      });
+    }
+    for(auto &thread : threads)
+      thread.join();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+    std::cout << "threads: " << number_of_threads << ", interned strings/s: "
+              << (number_of_threads * strings_per_thread) / seconds << '\n';
+  }
+}